@@ -0,0 +1,197 @@
+/**
+ * @name alloc_count.cpp
+ * @brief Counting replacements of the global allocation functions
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * The counters are plain initial-exec thread_locals, so the hooks never
+ * allocate or lock themselves and are safe to enter before main(). With glibc
+ * the C allocator is interposed by symbol name and forwards to the __libc_*
+ * entry points; operator new forwards there directly so a new is not also
+ * counted as a malloc. Elsewhere only operator new is counted.
+ */
+
+#include "alloc_count.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+#define AUGMENTO_ALLOC_MALLOC 1
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+#endif
+
+namespace {
+
+__attribute__((tls_model("initial-exec"))) thread_local allocs::HeapCounts
+    t_counts;
+
+void* rawAlloc(size_t size) {
+#ifdef AUGMENTO_ALLOC_MALLOC
+  return __libc_malloc(size);
+#else
+  return std::malloc(size);
+#endif
+}
+
+void* rawAlignedAlloc(size_t alignment, size_t size) {
+#ifdef AUGMENTO_ALLOC_MALLOC
+  return __libc_memalign(alignment, size);
+#else
+  // aligned_alloc wants a multiple of the alignment
+  return std::aligned_alloc(alignment, (size + alignment - 1) / alignment *
+                                           alignment);
+#endif
+}
+
+void rawFree(void* ptr) {
+#ifdef AUGMENTO_ALLOC_MALLOC
+  __libc_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+/* operator new semantics: retry through the new-handler, then throw */
+void* newAlloc(size_t size, size_t alignment) {
+  ++t_counts.news;
+  t_counts.bytes += size;
+  if (size == 0) size = 1;
+  for (;;) {
+    void* p = alignment > alignof(std::max_align_t)
+                  ? rawAlignedAlloc(alignment, size)
+                  : rawAlloc(size);
+    if (p) return p;
+    std::new_handler handler = std::get_new_handler();
+    if (!handler) throw std::bad_alloc();
+    handler();
+  }
+}
+
+void* newAllocNoThrow(size_t size, size_t alignment) noexcept {
+  try {
+    return newAlloc(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+}  // namespace
+
+namespace allocs {
+
+HeapCounts threadHeapCounts() { return t_counts; }
+
+bool interposesMalloc() {
+#ifdef AUGMENTO_ALLOC_MALLOC
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace allocs
+
+/* ---------------- operator new / delete ---------------- */
+void* operator new(size_t size) { return newAlloc(size, 0); }
+void* operator new[](size_t size) { return newAlloc(size, 0); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return newAllocNoThrow(size, 0);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return newAllocNoThrow(size, 0);
+}
+void* operator new(size_t size, std::align_val_t al) {
+  return newAlloc(size, static_cast<size_t>(al));
+}
+void* operator new[](size_t size, std::align_val_t al) {
+  return newAlloc(size, static_cast<size_t>(al));
+}
+void* operator new(size_t size, std::align_val_t al,
+                   const std::nothrow_t&) noexcept {
+  return newAllocNoThrow(size, static_cast<size_t>(al));
+}
+void* operator new[](size_t size, std::align_val_t al,
+                     const std::nothrow_t&) noexcept {
+  return newAllocNoThrow(size, static_cast<size_t>(al));
+}
+
+void operator delete(void* p) noexcept { rawFree(p); }
+void operator delete[](void* p) noexcept { rawFree(p); }
+void operator delete(void* p, size_t) noexcept { rawFree(p); }
+void operator delete[](void* p, size_t) noexcept { rawFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { rawFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { rawFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { rawFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { rawFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+  rawFree(p);
+}
+void operator delete[](void* p, size_t, std::align_val_t) noexcept {
+  rawFree(p);
+}
+void operator delete(void* p, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  rawFree(p);
+}
+void operator delete[](void* p, std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  rawFree(p);
+}
+
+/* ---------------- C allocator (glibc) ---------------- */
+#ifdef AUGMENTO_ALLOC_MALLOC
+extern "C" {
+
+void* malloc(size_t size) {
+  ++t_counts.mallocs;
+  t_counts.bytes += size;
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+  ++t_counts.mallocs;
+  t_counts.bytes += count * size;
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+  // realloc(p, 0) only frees
+  if (size) {
+    ++t_counts.mallocs;
+    t_counts.bytes += size;
+  }
+  return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) { __libc_free(ptr); }
+
+void* memalign(size_t alignment, size_t size) {
+  ++t_counts.mallocs;
+  t_counts.bytes += size;
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+  return memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+  if (alignment % sizeof(void*) || (alignment & (alignment - 1)))
+    return EINVAL;
+  void* p = memalign(alignment, size);
+  if (!p && size) return ENOMEM;
+  *out = p;
+  return 0;
+}
+
+}  // extern "C"
+#endif
@@ -0,0 +1,42 @@
+/**
+ * @name alloc_count.hpp
+ * @brief Per-thread heap allocation counters for the allocation gate
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * Linking alloc_count.cpp replaces the global operator new and, with glibc,
+ * interposes malloc, calloc, realloc and the aligned allocators for the whole
+ * process, OpenCV included. Every call is counted on the calling thread only,
+ * so a measurement is the difference of two threadHeapCounts() snapshots
+ * taken around the code under test.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace allocs {
+
+/**
+ * @brief Allocation calls made by one thread so far.
+ */
+struct HeapCounts {
+  uint64_t news = 0;     ///< operator new / new[] calls.
+  uint64_t mallocs = 0;  ///< malloc, calloc, realloc and aligned calls.
+  uint64_t bytes = 0;    ///< Bytes requested by all of them.
+
+  /// @return Allocation calls of either kind.
+  uint64_t total() const { return news + mallocs; }
+
+  HeapCounts operator-(const HeapCounts& o) const {
+    return {news - o.news, mallocs - o.mallocs, bytes - o.bytes};
+  }
+};
+
+/// @return Counters of the calling thread.
+HeapCounts threadHeapCounts();
+
+/// @return True when malloc and friends are counted, not only operator new.
+bool interposesMalloc();
+
+}  // namespace allocs
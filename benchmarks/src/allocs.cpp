@@ -0,0 +1,464 @@
+/**
+ * @name allocs.cpp
+ * @brief Allocation gate for the per-image hot path
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * Pushes reference images through read, decode, every configured pipeline
+ * and encode on one thread, counting heap allocations (operator new and, with
+ * glibc, the C allocator; see alloc_count.hpp) and cv::Mat buffers (through
+ * MemTracker) for each processed image. Warm-up images are discarded so
+ * one-off growth of reused buffers is not charged. A pipeline fails when any
+ * measured image exceeds its allocation budget, and the process then exits
+ * with status 1. With --cases the same counts are reported for every
+ * manipulation and Operation on its own, to find where they come from.
+ *
+ * The per-step loop calls Pipeline::apply with a caller-owned engine, which
+ * is not what the CLI runs. Each pipeline is therefore also pushed through
+ * the CLI's own producerPool and consumerThread, with profiled apply,
+ * per-format totals and the SafeQueue handoffs. Both run on the measuring
+ * thread, and its mean per image is gated as well.
+ */
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../include/json.hpp"
+#include "../include/json_writer.hpp"
+#include "../include/mem_tracker.hpp"
+#include "../include/multithread.hpp"
+#include "../include/pipeline.hpp"
+#include "alloc_count.hpp"
+#include "cases.hpp"
+
+namespace {
+
+enum Step : size_t { Read, Decode, Augment, Encode, kSteps };
+
+const char* stepName(size_t step) {
+  static const char* names[kSteps] = {"read", "decode", "augment", "encode"};
+  return names[step];
+}
+
+/// A pipeline configuration and the allocations it may make per image.
+struct Target {
+  std::string config;
+  int64_t budget = -1;  ///< Heap allocations per image (-1: --budget).
+};
+
+struct Options {
+  std::string images = "test/images";  ///< Reference image directory.
+  std::vector<std::string> inputs = {"4.1.01.png", "4.2.03.png",
+                                     "5.1.09.png"};  ///< Colour and grey.
+  std::vector<Target> pipelines = {{"test/config_template.json", -1}};
+  int64_t budget = 0;        ///< Default heap budget per image.
+  int64_t mat_budget = 0;    ///< cv::Mat buffers per image (-1: no limit).
+  int warmup = 3;            ///< Unmeasured passes over the inputs.
+  int iterations = 10;       ///< Measured passes over the inputs.
+  unsigned seed = 1234;      ///< Pipeline seed.
+  std::string ext = ".jpg";  ///< Encoder used for the encode step.
+  bool cases = false;        ///< Also count every case of cases.hpp.
+  std::string filter;        ///< Only cases whose id contains this.
+  std::string json_path;     ///< Optional report.
+};
+
+/// Counts of one pipeline over its measured images.
+struct Tally {
+  Target target;
+  uint64_t images = 0;
+  std::array<uint64_t, kSteps> calls{};  ///< Heap allocations per step.
+  std::array<uint64_t, kSteps> bytes{};  ///< Bytes requested per step.
+  uint64_t max_calls = 0;  ///< Most heap allocations of one image.
+  uint64_t mats = 0;       ///< cv::Mat buffers.
+  uint64_t max_mats = 0;   ///< Most cv::Mat buffers of one image.
+  double cli_calls = 0;    ///< Heap allocations per image, CLI path.
+  double cli_bytes = 0;    ///< Bytes requested per image, CLI path.
+  double cli_mats = 0;     ///< cv::Mat buffers per image, CLI path.
+  bool pass = true;
+
+  uint64_t totalCalls() const {
+    uint64_t n = 0;
+    for (uint64_t c : calls) n += c;
+    return n;
+  }
+  uint64_t totalBytes() const {
+    uint64_t n = 0;
+    for (uint64_t b : bytes) n += b;
+    return n;
+  }
+};
+
+/// Counts of one case per call.
+struct CaseCount {
+  std::string id;
+  double calls = 0;
+  double bytes = 0;
+  double mats = 0;
+};
+
+/* cv::Mat buffers allocated so far, all stages */
+uint64_t matAllocations() {
+  MemSnapshot snap = MemTracker::instance().snapshot();
+  uint64_t n = 0;
+  for (const MemStageStats& s : snap.stages) n += s.allocations;
+  return n;
+}
+
+std::vector<std::string> splitList(const std::string& s) {
+  std::vector<std::string> parts;
+  std::stringstream in(s);
+  std::string part;
+  while (std::getline(in, part, ','))
+    if (!part.empty()) parts.push_back(part);
+  return parts;
+}
+
+/* "config.json[:budget]"; --budget applies when none is given */
+std::vector<Target> parseTargets(const std::string& s) {
+  std::vector<Target> targets;
+  for (const std::string& part : splitList(s)) {
+    Target t;
+    size_t colon = part.rfind(':');
+    if (colon != std::string::npos &&
+        part.find_first_not_of("0123456789", colon + 1) == std::string::npos &&
+        colon + 1 < part.size()) {
+      t.budget = std::stoll(part.substr(colon + 1));
+      t.config = part.substr(0, colon);
+    } else {
+      t.config = part;
+    }
+    targets.push_back(t);
+  }
+  return targets;
+}
+
+/* Read, decode, augment and encode every input per pass; the harness itself
+ * allocates nothing between the marks */
+Tally measurePipeline(const Target& target, const std::vector<std::string>& paths,
+                      const Options& opt) {
+  Tally tally;
+  tally.target = target;
+  ConfigSpec config = parseConfigFile(target.config);
+  Pipeline pipeline = configurePipeline(config.pipeline_specs, opt.seed);
+  std::mt19937 engine(opt.seed);
+  std::vector<uchar> encoded, out;
+
+  for (int pass = 0; pass < opt.warmup + opt.iterations; ++pass) {
+    for (const std::string& path : paths) {
+      std::array<allocs::HeapCounts, kSteps + 1> marks;
+      // Named before the first mark: copying the path is harness work
+      Image img;
+      img.setName(path);
+      uint64_t mats = matAllocations();
+      marks[Read] = allocs::threadHeapCounts();
+      if (Image::readFile(path, encoded) != 0)
+        throw std::runtime_error("could not read " + path);
+      marks[Decode] = allocs::threadHeapCounts();
+      if (img.decode(encoded) != 0)
+        throw std::runtime_error("could not decode " + path);
+      marks[Augment] = allocs::threadHeapCounts();
+      pipeline.apply(img, engine);
+      marks[Encode] = allocs::threadHeapCounts();
+      if (img.encode(out, opt.ext) != 0)
+        throw std::runtime_error("could not encode " + path);
+      marks[kSteps] = allocs::threadHeapCounts();
+      mats = matAllocations() - mats;
+      if (pass < opt.warmup) continue;
+
+      uint64_t image_calls = 0;
+      for (size_t s = 0; s < kSteps; ++s) {
+        allocs::HeapCounts d = marks[s + 1] - marks[s];
+        tally.calls[s] += d.total();
+        tally.bytes[s] += d.bytes;
+        image_calls += d.total();
+      }
+      ++tally.images;
+      tally.max_calls = std::max(tally.max_calls, image_calls);
+      tally.mats += mats;
+      tally.max_mats = std::max(tally.max_mats, mats);
+    }
+  }
+  tally.pass = static_cast<int64_t>(tally.max_calls) <= target.budget &&
+               (opt.mat_budget < 0 ||
+                static_cast<int64_t>(tally.max_mats) <= opt.mat_budget);
+  return tally;
+}
+
+/// Allocations of one run through the CLI path.
+struct CliSample {
+  allocs::HeapCounts heap;
+  uint64_t mats = 0;
+};
+
+/* Run `passes` passes over the inputs through producerPool and then
+ * consumerThread (encode, no write) on this thread; only the two calls are
+ * counted, not filling the queues */
+CliSample runCliPath(Pipeline& pipeline, const std::vector<std::string>& paths,
+                     int passes) {
+  size_t tasks = paths.size() * static_cast<size_t>(std::max(passes, 1));
+  SafeQueue<PathTask> path_queue(tasks);
+  SafeQueue<Image> image_queue(tasks);
+  for (int pass = 0; pass < passes; ++pass)
+    for (const std::string& path : paths)
+      path_queue.push(PathTask{path, nowNs()});
+  path_queue.setDone();
+  ThreadProfile profile(pipeline.size());
+
+  CliSample sample;
+  uint64_t mats = matAllocations();
+  allocs::HeapCounts before = allocs::threadHeapCounts();
+  producerPool(path_queue, image_queue, pipeline, profile);
+  image_queue.setDone();
+  consumerThread(image_queue, "", false, profile, SinkMode::SkipWrite, 1);
+  sample.heap = allocs::threadHeapCounts() - before;
+  sample.mats = matAllocations() - mats;
+  return sample;
+}
+
+/* Steady-state cost per image of the CLI path: the difference between a
+ * warm-up-only run and a longer one cancels the per-call setup (buffers the
+ * threads allocate once) */
+void measureCliPath(Tally& tally, const std::vector<std::string>& paths,
+                    const Options& opt) {
+  ConfigSpec config = parseConfigFile(tally.target.config);
+  Pipeline pipeline = configurePipeline(config.pipeline_specs, opt.seed);
+  CliSample shortRun = runCliPath(pipeline, paths, opt.warmup);
+  CliSample longRun = runCliPath(pipeline, paths, opt.warmup + opt.iterations);
+  double images = static_cast<double>(paths.size()) * opt.iterations;
+  allocs::HeapCounts d = longRun.heap - shortRun.heap;
+  tally.cli_calls = static_cast<double>(d.total()) / images;
+  tally.cli_bytes = static_cast<double>(d.bytes) / images;
+  tally.cli_mats = static_cast<double>(longRun.mats - shortRun.mats) / images;
+  tally.pass = tally.pass && tally.cli_calls <= tally.target.budget &&
+               (opt.mat_budget < 0 || tally.cli_mats <= opt.mat_budget);
+}
+
+std::vector<CaseCount> measureCases(const std::vector<std::string>& paths,
+                                    const Options& opt) {
+  std::vector<CaseCount> counts;
+  for (const std::string& path : paths) {
+    cv::Mat src = cv::imread(path, cv::IMREAD_UNCHANGED);
+    if (src.empty()) throw std::runtime_error("could not read " + path);
+    std::string stem = fs::path(path).stem().string();
+    std::mt19937 rng(opt.seed);
+    for (const cases::Case& c : cases::buildCases(src.size(), rng)) {
+      std::string id = stem + "/" + c.group + "/" + c.name +
+                       (c.params.empty() ? "" : "[" + c.params + "]");
+      if (!opt.filter.empty() && id.find(opt.filter) == std::string::npos)
+        continue;
+      CaseCount count;
+      count.id = id;
+      for (int i = 0; i < opt.warmup + opt.iterations; ++i) {
+        // The input copy is made outside the counted region
+        cv::Mat in = src.clone(), out;
+        uint64_t mats = matAllocations();
+        allocs::HeapCounts before = allocs::threadHeapCounts();
+        try {
+          c.run(in, out);
+        } catch (const std::exception&) {
+        }
+        allocs::HeapCounts d = allocs::threadHeapCounts() - before;
+        mats = matAllocations() - mats;
+        if (i < opt.warmup) continue;
+        count.calls += d.total();
+        count.bytes += d.bytes;
+        count.mats += mats;
+      }
+      count.calls /= opt.iterations;
+      count.bytes /= opt.iterations;
+      count.mats /= opt.iterations;
+      counts.push_back(count);
+    }
+  }
+  return counts;
+}
+
+void writeText(std::ostream& out, const std::vector<Tally>& tallies,
+               const std::vector<CaseCount>& cases, const Options& opt) {
+  out << std::fixed;
+  for (const Tally& t : tallies) {
+    double n = std::max<uint64_t>(1, t.images);
+    out << "[ALLOCS] " << t.target.config << ": " << t.images
+        << " images after " << opt.warmup << " warm-up pass(es)\n";
+    out << "  " << std::left << std::setw(9) << "step" << std::right
+        << std::setw(12) << "allocs/img" << std::setw(12) << "KiB/img"
+        << "\n";
+    for (size_t s = 0; s < kSteps; ++s)
+      out << "  " << std::left << std::setw(9) << stepName(s) << std::right
+          << std::setprecision(1) << std::setw(12) << t.calls[s] / n
+          << std::setw(12) << t.bytes[s] / n / 1024 << "\n";
+    out << "  " << std::left << std::setw(9) << "total" << std::right
+        << std::setw(12) << t.totalCalls() / n << std::setw(12)
+        << t.totalBytes() / n / 1024 << "\n";
+    out << "  Worst image: " << t.max_calls << " heap allocations (budget "
+        << t.target.budget << "), " << t.max_mats << " cv::Mat buffers";
+    if (opt.mat_budget >= 0) out << " (budget " << opt.mat_budget << ")";
+    out << "\n  CLI path (producerPool + consumerThread): " << t.cli_calls
+        << " heap allocations, " << t.cli_bytes / 1024 << " KiB, "
+        << t.cli_mats << " cv::Mat buffers per image";
+    out << "\n  " << (t.pass ? "[PASS]" : "[FAIL]") << "\n";
+  }
+  if (cases.empty()) return;
+
+  std::vector<CaseCount> sorted = cases;
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const CaseCount& a, const CaseCount& b) {
+                     return a.calls > b.calls;
+                   });
+  out << "[ALLOCS] Per call, most allocating first\n";
+  out << "  " << std::setw(8) << "allocs" << std::setw(10) << "KiB"
+      << std::setw(7) << "mats" << "  case\n";
+  for (const CaseCount& c : sorted)
+    out << "  " << std::setprecision(1) << std::setw(8) << c.calls
+        << std::setw(10) << c.bytes / 1024 << std::setw(7) << c.mats << "  "
+        << c.id << "\n";
+}
+
+void writeJson(const std::string& path, const std::vector<Tally>& tallies,
+               const std::vector<CaseCount>& cases, const Options& opt) {
+  std::ofstream out(path);
+  if (!out) throw std::runtime_error("could not open " + path);
+  JsonWriter json(out);
+  json.beginObject()
+      .field("warmup", opt.warmup)
+      .field("iterations", opt.iterations)
+      .field("malloc_counted", allocs::interposesMalloc())
+      .field("mat_budget", opt.mat_budget);
+  json.key("pipelines").beginArray();
+  for (const Tally& t : tallies) {
+    double n = std::max<uint64_t>(1, t.images);
+    json.beginObject()
+        .field("config", t.target.config)
+        .field("budget", t.target.budget)
+        .field("images", t.images)
+        .field("allocations_per_image", t.totalCalls() / n)
+        .field("bytes_per_image", t.totalBytes() / n)
+        .field("max_allocations", t.max_calls)
+        .field("mats_per_image", t.mats / n)
+        .field("max_mats", t.max_mats)
+        .field("cli_allocations_per_image", t.cli_calls)
+        .field("cli_bytes_per_image", t.cli_bytes)
+        .field("cli_mats_per_image", t.cli_mats)
+        .field("pass", t.pass);
+    json.key("steps").beginArray();
+    for (size_t s = 0; s < kSteps; ++s)
+      json.beginObject()
+          .field("step", std::string(stepName(s)))
+          .field("allocations_per_image", t.calls[s] / n)
+          .field("bytes_per_image", t.bytes[s] / n)
+          .endObject();
+    json.endArray();
+    json.endObject();
+  }
+  json.endArray();
+  json.key("cases").beginArray();
+  for (const CaseCount& c : cases)
+    json.beginObject()
+        .field("id", c.id)
+        .field("allocations", c.calls)
+        .field("bytes", c.bytes)
+        .field("mats", c.mats)
+        .endObject();
+  json.endArray();
+  json.endObject();
+  out << "\n";
+}
+
+Options parseArguments(int argc, char* argv[]) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--images" && has_value) {
+      opt.images = argv[++i];
+    } else if (arg == "--inputs" && has_value) {
+      opt.inputs = splitList(argv[++i]);
+    } else if (arg == "--pipelines" && has_value) {
+      opt.pipelines = parseTargets(argv[++i]);
+    } else if (arg == "--budget" && has_value) {
+      opt.budget = std::stoll(argv[++i]);
+    } else if (arg == "--mat-budget" && has_value) {
+      opt.mat_budget = std::stoll(argv[++i]);
+    } else if (arg == "--warmup" && has_value) {
+      opt.warmup = std::max(0, std::stoi(argv[++i]));
+    } else if (arg == "--iterations" && has_value) {
+      opt.iterations = std::max(1, std::stoi(argv[++i]));
+    } else if (arg == "--seed" && has_value) {
+      opt.seed = static_cast<unsigned>(std::stoul(argv[++i]));
+    } else if (arg == "--ext" && has_value) {
+      opt.ext = argv[++i];
+    } else if (arg == "--cases") {
+      opt.cases = true;
+    } else if (arg == "--filter" && has_value) {
+      opt.filter = argv[++i];
+    } else if (arg == "--json" && has_value) {
+      opt.json_path = argv[++i];
+    } else if (arg == "--help" || arg == "-h") {
+      std::cout << R"(
+Usage: allocs [OPTIONS]
+
+  --images <dir>       Reference images (default test/images)
+  --inputs <list>      Files used as inputs (default 4.1.01.png,4.2.03.png,5.1.09.png)
+  --pipelines <list>   Pipeline configs, each with an optional :budget
+                       (default test/config_template.json)
+  --budget <n>         Heap allocations allowed per image (default 0)
+  --mat-budget <n>     cv::Mat buffers allowed per image, -1 for no limit
+                       (default 0)
+  --warmup <n>         Unmeasured passes over the inputs (default 3)
+  --iterations <n>     Measured passes over the inputs (default 10)
+  --seed <n>           Pipeline seed (default 1234)
+  --ext <ext>          Encoder of the encode step (default .jpg)
+  --cases              Also count every manipulation and Operation alone
+  --filter <text>      Only cases whose id contains text
+  --json <path>        Write the counts as JSON
+)";
+      std::exit(0);
+    } else {
+      throw std::invalid_argument("Unrecognized flag " + arg + ".");
+    }
+  }
+  for (Target& t : opt.pipelines)
+    if (t.budget < 0) t.budget = opt.budget;
+  return opt;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    Options opt = parseArguments(argc, argv);
+    // OpenCV workers would allocate on threads that are not counted
+    cv::setNumThreads(1);
+    MemTracker::instance().install();
+    if (!allocs::interposesMalloc())
+      std::cout << "[WARN] Only operator new is counted on this platform; "
+                   "malloc and OpenCV's allocations are not\n";
+
+    std::vector<std::string> paths;
+    for (const std::string& input : opt.inputs)
+      paths.push_back((fs::path(opt.images) / input).string());
+
+    std::vector<Tally> tallies;
+    for (const Target& target : opt.pipelines) {
+      tallies.push_back(measurePipeline(target, paths, opt));
+      measureCliPath(tallies.back(), paths, opt);
+    }
+    std::vector<CaseCount> cases;
+    if (opt.cases) cases = measureCases(paths, opt);
+
+    writeText(std::cout, tallies, cases, opt);
+    if (!opt.json_path.empty()) writeJson(opt.json_path, tallies, cases, opt);
+    bool pass = std::all_of(tallies.begin(), tallies.end(),
+                            [](const Tally& t) { return t.pass; });
+    return pass ? 0 : 1;
+  } catch (const std::exception& e) {
+    std::cout << "[ERROR] " << e.what() << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,188 @@
+/**
+ * @name cases.hpp
+ * @brief Catalogue of manipulation and Operation calls shared by the
+ * benchmark runners
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * Every function of manipulations.hpp and every Operation built by
+ * OperationFactory, with fixed parameters scaled to the image size. Random
+ * choices are drawn from the engine passed to buildCases(), so reseeding it
+ * before a call makes that call reproducible.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <opencv2/core.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../include/factory.hpp"
+#include "../include/image.hpp"
+#include "../include/manipulations.hpp"
+
+namespace cases {
+
+/**
+ * @brief One call under test: reads `in` (a fresh copy of the input image)
+ * and leaves its result in `out`. Returns false if the input is not
+ * supported (e.g. a colour-only function on a single channel).
+ */
+using Kernel = std::function<bool(cv::Mat& in, cv::Mat& out)>;
+
+struct Case {
+  std::string group;   ///< "function" or "operation".
+  std::string name;    ///< Function or operation name.
+  std::string params;  ///< Human-readable parameters.
+  Kernel run;          ///< Call under test.
+};
+
+/* Wraps an in-place manipulation returning a status code */
+inline Kernel inPlace(std::function<int(cv::Mat&)> fn) {
+  return [fn](cv::Mat& in, cv::Mat& out) {
+    if (fn(in) != 0) return false;
+    out = in;
+    return true;
+  };
+}
+
+/* Wraps a manipulation returning a new image */
+inline Kernel returning(std::function<cv::Mat(const cv::Mat&)> fn) {
+  return [fn](cv::Mat& in, cv::Mat& out) {
+    out = fn(in);
+    return !out.empty();
+  };
+}
+
+/* Wraps an Operation; each call draws fresh parameters from the same rng */
+inline Kernel operation(const std::string& name, const ParamList& params,
+                 std::mt19937& rng) {
+  std::shared_ptr<Operation> op = params.empty()
+                                      ? OperationFactory::create(name).op
+                                      : OperationFactory::create(name, params).op;
+  return [op, &rng](cv::Mat& in, cv::Mat& out) {
+    Image img;
+    img.getData() = in;
+    op->apply(img, rng);
+    out = img.getData();
+    return !out.empty();
+  };
+}
+
+inline std::string fmt(double v) {
+  std::ostringstream s;
+  s << v;
+  return s.str();
+}
+
+/* Cases for one image size; parameters that depend on it are scaled */
+inline std::vector<Case> buildCases(const cv::Size& size, std::mt19937& rng) {
+  int w = size.width, h = size.height;
+  cv::Mat shear = (cv::Mat_<double>(2, 3) << 1, 0.2, 0, 0.1, 1, 0);
+  std::vector<Case> cases = {
+      {"function", "rotateImageNoCrop", "15deg",
+       returning([](const cv::Mat& m) { return rotateImageNoCrop(m, 15); })},
+      {"function", "rotateImageNoCrop", "45deg",
+       returning([](const cv::Mat& m) { return rotateImageNoCrop(m, 45); })},
+      {"function", "rotateImageCrop", "30deg",
+       returning([](const cv::Mat& m) { return rotateImageCrop(m, 30); })},
+      {"function", "rotateImage", "30deg",
+       returning([](const cv::Mat& m) { return rotateImage(m, 30); })},
+      {"function", "reflectImageHorizontal", "",
+       inPlace([](cv::Mat& m) { return reflectImageHorizontal(m); })},
+      {"function", "reflectImageVertical", "",
+       inPlace([](cv::Mat& m) { return reflectImageVertical(m); })},
+      {"function", "resizeImage", "x0.5",
+       returning([](const cv::Mat& m) { return resizeImage(m, 0.5); })},
+      {"function", "resizeImage", "x1.5",
+       returning([](const cv::Mat& m) { return resizeImage(m, 1.5); })},
+      {"function", "resizeImage", "224x224",
+       returning([](const cv::Mat& m) { return resizeImage(m, 224, 224); })},
+      {"function", "cropImage", "center half",
+       returning([w, h](const cv::Mat& m) {
+         return cropImage(m, w / 4, h / 4, w / 2, h / 2);
+       })},
+      {"function", "randomCrop", "half",
+       returning([w, h, &rng](const cv::Mat& m) {
+         return randomCrop(m, w / 2, h / 2, rng);
+       })},
+      {"function", "affineTransform", "shear",
+       returning([shear](const cv::Mat& m) {
+         return affineTransform(m, shear);
+       })},
+      {"function", "colorJitter", "0.2,0.2,0.2,10",
+       inPlace([&rng](cv::Mat& m) {
+         return colorJitter(m, 0.2, 0.2, 0.2, 10, rng);
+       })},
+      {"function", "histogramEqualization", "",
+       inPlace([](cv::Mat& m) { return histogramEqualization(m); })},
+      {"function", "whiteBalance", "",
+       inPlace([](cv::Mat& m) { return whiteBalance(m); })},
+      {"function", "toGrayscale", "",
+       inPlace([](cv::Mat& m) { return toGrayscale(m); })},
+      {"function", "adjustBrightness", "+20",
+       inPlace([](cv::Mat& m) { return adjustBrightness(m, 20); })},
+      {"function", "adjustContrast", "x1.2",
+       inPlace([](cv::Mat& m) { return adjustContrast(m, 1.2); })},
+      {"function", "adjustSaturation", "x1.3",
+       inPlace([](cv::Mat& m) { return adjustSaturation(m, 1.3); })},
+      {"function", "adjustHue", "+10",
+       inPlace([](cv::Mat& m) { return adjustHue(m, 10); })},
+      {"function", "injectNoise", "sigma 10",
+       inPlace([&rng](cv::Mat& m) { return injectNoise(m, 0, 10, rng); })},
+      {"function", "injectNoise", "sigma 30",
+       inPlace([&rng](cv::Mat& m) { return injectNoise(m, 0, 30, rng); })},
+      {"function", "blurImage", "k3",
+       inPlace([](cv::Mat& m) { return blurImage(m, 3); })},
+      {"function", "blurImage", "k15",
+       inPlace([](cv::Mat& m) { return blurImage(m, 15); })},
+      {"function", "sharpenImage", "",
+       inPlace([](cv::Mat& m) { return sharpenImage(m); })},
+      {"function", "randomErase", "1/8..1/4",
+       inPlace([w, h, &rng](cv::Mat& m) {
+         return randomErase(m, h / 8, h / 4, w / 8, w / 4, rng);
+       })},
+  };
+
+  struct OpSpec {
+    std::string name;
+    ParamList params;
+  };
+  double dw = w, dh = h;
+  std::vector<OpSpec> ops = {
+      {"rotate", {-30, 30, 0}},
+      {"rotate", {-30, 30, 1}},
+      {"rotate", {-30, 30, 2}},
+      {"reflect", {}},
+      {"resize", {0.5, 1.5}},
+      {"resize", {224, 224, 224, 224}},
+      {"crop", {dw / 2, dh / 2}},
+      {"affine transform", {1, 0.2, 0, 0.1, 1, 0}},
+      {"color jitter", {0.2, 0.2, 0.2, 10}},
+      {"histogram equalization", {}},
+      {"white balance", {}},
+      {"to grayscale", {}},
+      {"adjust brightness", {-30, 30}},
+      {"adjust contrast", {0.8, 1.2}},
+      {"adjust saturation", {0.7, 1.3}},
+      {"adjust hue", {-10, 10}},
+      {"inject noise", {0, 0, 5, 30}},
+      {"blur image", {3, 15}},
+      {"sharpen image", {}},
+      {"random erase", {dh / 8, dh / 4, dw / 8, dw / 4}},
+  };
+  for (const OpSpec& spec : ops) {
+    std::string params;
+    for (size_t i = 0; i < spec.params.size(); ++i)
+      params += (i ? "," : "") + fmt(spec.params[i]);
+    cases.push_back({"operation", spec.name, params,
+                     operation(spec.name, spec.params, rng)});
+  }
+  return cases;
+}
+
+}  // namespace cases
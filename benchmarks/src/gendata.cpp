@@ -0,0 +1,254 @@
+/**
+ * @name gendata.cpp
+ * @brief Synthetic benchmark corpus generator
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * Writes a deterministic image corpus with a configurable resolution
+ * distribution, format mix, quality, channel count, bit depth and file
+ * count, plus a manifest `<out>.json` next to it describing every file (not
+ * inside, where runs would take it for an input image). The same settings
+ * always produce the same corpus, so benchmark workloads can be recreated
+ * on any machine instead of being shipped.
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../include/json_writer.hpp"
+#include "synthetic.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Options {
+  synth::DatasetSpec spec;
+  std::string preset = "custom";  ///< Last preset applied.
+  std::string out = "synthetic";  ///< Output directory.
+};
+
+/* Split "a:w,b,c:w" into (value, weight) pairs; weight defaults to 1 */
+std::vector<std::pair<std::string, double>> parseWeighted(
+    const std::string& s) {
+  std::vector<std::pair<std::string, double>> entries;
+  std::stringstream in(s);
+  std::string part;
+  while (std::getline(in, part, ',')) {
+    if (part.empty()) continue;
+    size_t colon = part.find(':');
+    double weight = colon == std::string::npos
+                        ? 1.0
+                        : std::stod(part.substr(colon + 1));
+    if (weight <= 0) throw std::invalid_argument("weights must be positive");
+    entries.emplace_back(part.substr(0, colon), weight);
+  }
+  if (entries.empty()) throw std::invalid_argument("empty list '" + s + "'");
+  return entries;
+}
+
+std::vector<synth::SizeChoice> parseSizes(const std::string& s) {
+  std::vector<synth::SizeChoice> sizes;
+  for (const auto& [value, weight] : parseWeighted(s)) {
+    size_t x = value.find('x');
+    if (x == std::string::npos)
+      throw std::invalid_argument("size '" + value + "' is not WIDTHxHEIGHT");
+    synth::SizeChoice size;
+    size.width = std::stoi(value.substr(0, x));
+    size.height = std::stoi(value.substr(x + 1));
+    size.weight = weight;
+    if (size.width < 2 || size.height < 2)
+      throw std::invalid_argument("size '" + value + "' is too small");
+    sizes.push_back(size);
+  }
+  return sizes;
+}
+
+std::vector<std::pair<std::string, double>> parseFormats(const std::string& s) {
+  auto formats = parseWeighted(s);
+  for (auto& [format, weight] : formats) {
+    if (format == "jpeg") format = "jpg";
+    if (format == "tiff") format = "tif";
+    if (format != "jpg" && format != "png" && format != "tif" &&
+        format != "webp")
+      throw std::invalid_argument("unsupported format '" + format + "'");
+  }
+  return formats;
+}
+
+std::vector<std::pair<int, double>> parseChannels(const std::string& s) {
+  std::vector<std::pair<int, double>> channels;
+  for (const auto& [value, weight] : parseWeighted(s)) {
+    int c = std::stoi(value);
+    if (c != 1 && c != 3 && c != 4)
+      throw std::invalid_argument("channel count must be 1, 3 or 4");
+    channels.emplace_back(c, weight);
+  }
+  return channels;
+}
+
+/* Named workloads; later flags override their fields */
+void applyPreset(const std::string& name, Options& opt) {
+  synth::DatasetSpec& spec = opt.spec;
+  if (name == "sipi") {
+    // Like test/images: small lossless stills, mostly colour
+    spec.sizes = parseSizes("512x512:3,256x256,1024x1024");
+    spec.formats = parseFormats("png");
+    spec.channels = parseChannels("3:3,1");
+    spec.depth = 8;
+    spec.jitter = 0;
+    spec.count = 35;
+  } else if (name == "camera") {
+    // 12 MP camera JPEGs in both orientations
+    spec.sizes = parseSizes("4000x3000:3,3000x4000");
+    spec.formats = parseFormats("jpg");
+    spec.channels = parseChannels("3");
+    spec.depth = 8;
+    spec.quality = 92;
+    spec.jitter = 0;
+    spec.count = 64;
+  } else if (name == "tiff16") {
+    // 16-bit scanner or microscopy TIFFs
+    spec.sizes = parseSizes("2048x1536:2,4096x3072");
+    spec.formats = parseFormats("tif");
+    spec.channels = parseChannels("3:3,1");
+    spec.depth = 16;
+    spec.jitter = 0;
+    spec.count = 32;
+  } else if (name == "webp-mixed") {
+    // Web-scraped WebP of many sizes
+    spec.sizes = parseSizes("640x480:3,1280x720:3,1920x1080:2,3840x2160");
+    spec.formats = parseFormats("webp");
+    spec.channels = parseChannels("3:9,4");
+    spec.depth = 8;
+    spec.quality = 80;
+    spec.jitter = 0.2;
+    spec.count = 200;
+  } else {
+    throw std::invalid_argument("unknown preset '" + name + "'");
+  }
+  opt.preset = name;
+}
+
+void writeManifest(std::ostream& out, const Options& opt,
+                   const std::vector<synth::FileInfo>& files) {
+  uint64_t bytes = 0, pixels = 0;
+  for (const synth::FileInfo& f : files) {
+    bytes += f.bytes;
+    pixels += static_cast<uint64_t>(f.width) * f.height;
+  }
+  JsonWriter json(out);
+  json.beginObject()
+      .field("preset", opt.preset)
+      .field("seed", opt.spec.seed)
+      .field("count", files.size())
+      .field("quality", opt.spec.quality)
+      .field("depth", opt.spec.depth)
+      .field("jitter", opt.spec.jitter)
+      .field("total_bytes", bytes)
+      .field("total_pixels", pixels);
+  json.key("files").beginArray();
+  for (const synth::FileInfo& f : files)
+    json.beginObject()
+        .field("name", f.path.filename().string())
+        .field("format", f.format)
+        .field("width", f.width)
+        .field("height", f.height)
+        .field("channels", f.channels)
+        .field("depth", f.depth)
+        .field("bytes", f.bytes)
+        .endObject();
+  json.endArray();
+  json.endObject();
+  out << "\n";
+}
+
+Options parseArguments(int argc, char* argv[]) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--preset" && has_value) {
+      applyPreset(argv[++i], opt);
+    } else if (arg == "--count" && has_value) {
+      opt.spec.count = std::stoul(argv[++i]);
+    } else if (arg == "--sizes" && has_value) {
+      opt.spec.sizes = parseSizes(argv[++i]);
+    } else if (arg == "--jitter" && has_value) {
+      opt.spec.jitter = std::min(0.9, std::max(0.0, std::stod(argv[++i])));
+    } else if (arg == "--format" && has_value) {
+      opt.spec.formats = parseFormats(argv[++i]);
+    } else if (arg == "--quality" && has_value) {
+      opt.spec.quality = std::stoi(argv[++i]);
+    } else if (arg == "--channels" && has_value) {
+      opt.spec.channels = parseChannels(argv[++i]);
+    } else if (arg == "--depth" && has_value) {
+      opt.spec.depth = std::stoi(argv[++i]);
+      if (opt.spec.depth != 8 && opt.spec.depth != 16)
+        throw std::invalid_argument("depth must be 8 or 16");
+    } else if (arg == "--seed" && has_value) {
+      opt.spec.seed = std::stoull(argv[++i]);
+    } else if (arg == "--prefix" && has_value) {
+      opt.spec.prefix = argv[++i];
+    } else if (arg == "--out" && has_value) {
+      opt.out = argv[++i];
+    } else if (arg == "--help" || arg == "-h") {
+      std::cout << R"(
+Usage: gendata [OPTIONS]
+
+  --preset <name>     sipi, camera, tiff16 or webp-mixed; later flags override
+  --count <n>         Number of files (default 24)
+  --sizes <list>      Resolution distribution, WxH[:weight],...
+                      (default 1280x960)
+  --jitter <f>        Random scale of each side, +/- share (default 0)
+  --format <list>     jpg, png, tif, webp, with optional :weight (default jpg)
+  --quality <n>       JPEG and WebP quality (default 90)
+  --channels <list>   1, 3 or 4, with optional :weight (default 3)
+  --depth <8|16>      Bits per sample for PNG and TIFF (default 8)
+  --seed <n>          Corpus seed (default 671)
+  --prefix <name>     File name prefix (default synthetic)
+  --out <dir>         Output directory (default synthetic)
+)";
+      std::exit(0);
+    } else {
+      throw std::invalid_argument("Unrecognized flag " + arg + ".");
+    }
+  }
+  return opt;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    Options opt = parseArguments(argc, argv);
+    std::cout << "[INFO] Generating " << opt.spec.count << " images into "
+              << opt.out << "..." << std::endl;
+    std::vector<synth::FileInfo> files = synth::generate(opt.spec, opt.out);
+
+    // Beside the corpus: every regular file inside it is read as an image
+    fs::path dir = fs::path(opt.out);
+    if (!dir.has_filename()) dir = dir.parent_path();
+    fs::path manifest = dir;
+    manifest += ".json";
+    std::ofstream out(manifest);
+    if (!out) throw std::runtime_error("could not open " + manifest.string());
+    writeManifest(out, opt, files);
+
+    uint64_t bytes = 0;
+    for (const synth::FileInfo& f : files) bytes += f.bytes;
+    std::cout << "[INFO] Wrote " << files.size() << " files, " << std::fixed
+              << std::setprecision(1) << bytes / 1048576.0 << " MiB, manifest "
+              << manifest.string() << "\n";
+    return 0;
+  } catch (const std::exception& e) {
+    std::cout << "[ERROR] " << e.what() << std::endl;
+    return -1;
+  }
+}
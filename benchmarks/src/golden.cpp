@@ -0,0 +1,395 @@
+/**
+ * @name golden.cpp
+ * @brief Golden-output harness for manipulations, operations and pipelines
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * Runs every case of cases.hpp and every configured pipeline on fixed
+ * reference images with fixed seeds, and compares each output with a stored
+ * golden image. Comparisons are bit-exact by default; a case may carry a
+ * maximum absolute error and a minimum PSNR instead, for kernels that are
+ * allowed to approximate the reference implementation. With --update the
+ * current outputs become the new goldens. The process exits with status 1
+ * if any case differs from its golden beyond its tolerance.
+ */
+
+#include <simdjson.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../include/json.hpp"
+#include "../include/json_writer.hpp"
+#include "../include/pipeline.hpp"
+#include "cases.hpp"
+
+namespace {
+
+struct Options {
+  std::string images = "test/images";  ///< Reference image directory.
+  std::vector<std::string> inputs = {"4.1.01.png", "4.2.03.png",
+                                     "5.1.09.png"};  ///< Colour and grey.
+  std::vector<std::string> pipelines = {"test/config_template.json"};
+  int pipeline_samples = 4;     ///< Seeds per pipeline and input.
+  unsigned seed = 1234;         ///< Base seed of every case.
+  std::string golden = "golden";  ///< Golden directory.
+  std::string filter;           ///< Only cases whose id contains this.
+  bool update = false;          ///< Record instead of compare.
+  int max_abs = -1;             ///< Override of every case's tolerance.
+  double min_psnr = -1;         ///< Override of every case's tolerance.
+  std::string json_path;        ///< Optional report.
+};
+
+/// Stored expectation of one case.
+struct Golden {
+  std::string id;
+  std::string file;            ///< PNG next to the manifest ("" if none).
+  std::string status = "ok";   ///< "ok", "unsupported" or "error".
+  int max_abs = 0;             ///< Largest tolerated absolute difference.
+  double min_psnr = 0;         ///< Smallest tolerated PSNR (0 disables).
+};
+
+/// Output of one case in this run.
+struct Output {
+  std::string id;
+  std::string status = "ok";
+  std::string message;  ///< Exception text for "error".
+  cv::Mat image;
+};
+
+struct Verdict {
+  std::string id;
+  std::string result;  ///< "pass", "fail", "new" or "missing".
+  std::string detail;
+  double max_abs = 0;
+  double psnr = 0;
+};
+
+/* FNV-1a, so a case's seed depends only on its id */
+uint32_t hashId(const std::string& id) {
+  uint32_t h = 2166136261u;
+  for (unsigned char c : id) h = (h ^ c) * 16777619u;
+  return h;
+}
+
+std::string fileName(const std::string& id) {
+  std::string name;
+  for (char c : id)
+    name += std::isalnum(static_cast<unsigned char>(c)) || c == '.' ||
+                    c == '-'
+                ? c
+                : '_';
+  std::ostringstream out;
+  out << name << "_" << std::hex << std::setw(8) << std::setfill('0')
+      << hashId(id) << ".png";
+  return out.str();
+}
+
+std::vector<std::string> splitList(const std::string& s) {
+  std::vector<std::string> parts;
+  std::stringstream in(s);
+  std::string part;
+  while (std::getline(in, part, ','))
+    if (!part.empty()) parts.push_back(part);
+  return parts;
+}
+
+/* Run a call, turning exceptions and rejected inputs into a status */
+template <typename Fn>
+Output capture(const std::string& id, Fn&& fn) {
+  Output out;
+  out.id = id;
+  try {
+    if (!fn(out.image) || out.image.empty()) out.status = "unsupported";
+  } catch (const std::exception& e) {
+    out.status = "error";
+    out.message = e.what();
+  }
+  if (out.status != "ok") out.image.release();
+  return out;
+}
+
+std::vector<Output> runAll(const Options& opt) {
+  std::vector<Output> outputs;
+  auto wanted = [&](const std::string& id) {
+    return opt.filter.empty() || id.find(opt.filter) != std::string::npos;
+  };
+
+  for (const std::string& input : opt.inputs) {
+    fs::path path = fs::path(opt.images) / input;
+    // Unchanged, so grey inputs exercise the single-channel paths
+    cv::Mat src = cv::imread(path.string(), cv::IMREAD_UNCHANGED);
+    if (src.empty())
+      throw std::runtime_error("could not read " + path.string());
+    std::string stem = path.stem().string();
+
+    std::mt19937 rng;
+    for (const cases::Case& c : cases::buildCases(src.size(), rng)) {
+      std::string id = stem + "/" + c.group + "/" + c.name +
+                       (c.params.empty() ? "" : "[" + c.params + "]");
+      if (!wanted(id)) continue;
+      outputs.push_back(capture(id, [&](cv::Mat& out) {
+        rng.seed(opt.seed ^ hashId(id));
+        cv::Mat in = src.clone();
+        return c.run(in, out);
+      }));
+    }
+
+    for (const std::string& config_path : opt.pipelines) {
+      ConfigSpec config = parseConfigFile(config_path);
+      std::string name = fs::path(config_path).stem().string();
+      for (int k = 0; k < opt.pipeline_samples; ++k) {
+        std::string id = stem + "/pipeline/" + name + "#" + std::to_string(k);
+        if (!wanted(id)) continue;
+        outputs.push_back(capture(id, [&](cv::Mat& out) {
+          uint32_t seed = opt.seed ^ hashId(id);
+          Pipeline pipeline = configurePipeline(config.pipeline_specs, seed);
+          std::mt19937 engine(seed);
+          Image img;
+          img.getData() = src.clone();
+          pipeline.apply(img, engine);
+          out = img.getData();
+          return true;
+        }));
+      }
+    }
+  }
+  return outputs;
+}
+
+std::map<std::string, Golden> loadManifest(const fs::path& path,
+                                           std::string* opencv) {
+  std::map<std::string, Golden> goldens;
+  if (!fs::exists(path)) return goldens;
+  simdjson::padded_string data = simdjson::padded_string::load(path.string());
+  simdjson::ondemand::parser parser;
+  simdjson::ondemand::document doc = parser.iterate(data);
+  *opencv = std::string(std::string_view(doc["opencv"].get_string()));
+  for (auto entry : doc["cases"].get_array()) {
+    Golden g;
+    g.id = std::string(std::string_view(entry["id"].get_string()));
+    g.file = std::string(std::string_view(entry["file"].get_string()));
+    g.status = std::string(std::string_view(entry["status"].get_string()));
+    g.max_abs = static_cast<int>(int64_t(entry["max_abs"].get_int64()));
+    g.min_psnr = double(entry["min_psnr"].get_double());
+    goldens[g.id] = g;
+  }
+  return goldens;
+}
+
+void writeManifest(const fs::path& path, const Options& opt,
+                   const std::map<std::string, Golden>& goldens) {
+  std::ofstream out(path);
+  if (!out) throw std::runtime_error("could not open " + path.string());
+  JsonWriter json(out);
+  json.beginObject()
+      .field("opencv", std::string(CV_VERSION))
+      .field("seed", opt.seed);
+  json.key("cases").beginArray();
+  for (const auto& [id, g] : goldens)
+    json.beginObject()
+        .field("id", g.id)
+        .field("file", g.file)
+        .field("status", g.status)
+        .field("max_abs", g.max_abs)
+        .field("min_psnr", g.min_psnr)
+        .endObject();
+  json.endArray();
+  json.endObject();
+  out << "\n";
+}
+
+/* Record outputs, keeping the tolerances of cases that already exist */
+void update(const Options& opt, const std::vector<Output>& outputs,
+            std::map<std::string, Golden> goldens) {
+  fs::path dir(opt.golden);
+  fs::create_directories(dir);
+  for (const Output& o : outputs) {
+    Golden& g = goldens[o.id];
+    if (!g.file.empty()) fs::remove(dir / g.file);
+    g.id = o.id;
+    g.status = o.status;
+    g.file.clear();
+    if (o.status != "ok") continue;
+    g.file = fileName(o.id);
+    if (!cv::imwrite((dir / g.file).string(), o.image))
+      throw std::runtime_error("could not write golden for " + o.id +
+                               " (only 8- and 16-bit outputs are stored)");
+  }
+  writeManifest(dir / "manifest.json", opt, goldens);
+  std::cout << "[INFO] Recorded " << outputs.size() << " goldens in "
+            << opt.golden << "\n";
+}
+
+Verdict compare(const Output& o, const Golden& g, const Options& opt) {
+  Verdict v;
+  v.id = o.id;
+  v.result = "fail";
+  if (o.status != g.status) {
+    v.detail = "status " + o.status + ", golden " + g.status +
+               (o.message.empty() ? "" : ": " + o.message);
+    return v;
+  }
+  if (o.status != "ok") {
+    v.result = "pass";
+    return v;
+  }
+  cv::Mat ref = cv::imread((fs::path(opt.golden) / g.file).string(),
+                           cv::IMREAD_UNCHANGED);
+  if (ref.empty()) {
+    v.detail = "golden image " + g.file + " unreadable";
+    return v;
+  }
+  if (ref.size() != o.image.size() || ref.type() != o.image.type()) {
+    std::ostringstream d;
+    d << "shape " << o.image.cols << "x" << o.image.rows << "x"
+      << o.image.channels() << ", golden " << ref.cols << "x" << ref.rows
+      << "x" << ref.channels();
+    v.detail = d.str();
+    return v;
+  }
+  int max_abs = opt.max_abs >= 0 ? opt.max_abs : g.max_abs;
+  double min_psnr = opt.min_psnr >= 0 ? opt.min_psnr : g.min_psnr;
+  v.max_abs = cv::norm(o.image, ref, cv::NORM_INF);
+  v.psnr = cv::PSNR(o.image, ref, o.image.depth() == CV_16U ? 65535 : 255);
+  bool ok = v.max_abs <= max_abs && (min_psnr <= 0 || v.psnr >= min_psnr);
+  std::ostringstream d;
+  d << std::fixed << std::setprecision(2) << "max |diff| " << v.max_abs
+    << " (allowed " << max_abs << "), PSNR " << v.psnr << " dB";
+  if (min_psnr > 0) d << " (required " << min_psnr << ")";
+  v.detail = d.str();
+  v.result = ok ? "pass" : "fail";
+  return v;
+}
+
+void writeReport(const std::string& path, const std::vector<Verdict>& verdicts) {
+  std::ofstream out(path);
+  if (!out) throw std::runtime_error("could not open " + path);
+  JsonWriter json(out);
+  json.beginObject();
+  json.key("cases").beginArray();
+  for (const Verdict& v : verdicts)
+    json.beginObject()
+        .field("id", v.id)
+        .field("result", v.result)
+        .field("detail", v.detail)
+        .field("max_abs", v.max_abs)
+        .field("psnr", v.psnr)
+        .endObject();
+  json.endArray();
+  json.endObject();
+  out << "\n";
+}
+
+Options parseArguments(int argc, char* argv[]) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--images" && has_value) {
+      opt.images = argv[++i];
+    } else if (arg == "--inputs" && has_value) {
+      opt.inputs = splitList(argv[++i]);
+    } else if (arg == "--pipelines" && has_value) {
+      opt.pipelines = splitList(argv[++i]);
+    } else if (arg == "--pipeline-samples" && has_value) {
+      opt.pipeline_samples = std::max(0, std::stoi(argv[++i]));
+    } else if (arg == "--seed" && has_value) {
+      opt.seed = static_cast<unsigned>(std::stoul(argv[++i]));
+    } else if (arg == "--golden" && has_value) {
+      opt.golden = argv[++i];
+    } else if (arg == "--filter" && has_value) {
+      opt.filter = argv[++i];
+    } else if (arg == "--update") {
+      opt.update = true;
+    } else if (arg == "--max-abs" && has_value) {
+      opt.max_abs = std::stoi(argv[++i]);
+    } else if (arg == "--min-psnr" && has_value) {
+      opt.min_psnr = std::stod(argv[++i]);
+    } else if (arg == "--json" && has_value) {
+      opt.json_path = argv[++i];
+    } else if (arg == "--help" || arg == "-h") {
+      std::cout << R"(
+Usage: golden [OPTIONS]
+
+  --images <dir>          Reference images (default test/images)
+  --inputs <list>         Files used as inputs (default 4.1.01.png,4.2.03.png,5.1.09.png)
+  --pipelines <list>      Pipeline configs (default test/config_template.json)
+  --pipeline-samples <n>  Seeds per pipeline and input (default 4)
+  --seed <n>              Base seed (default 1234)
+  --golden <dir>          Golden directory (default golden)
+  --filter <text>         Only cases whose id contains text
+  --update                Record current outputs as the goldens
+  --max-abs <n>           Tolerated absolute difference for every case
+  --min-psnr <dB>         Required PSNR for every case
+  --json <path>           Write the comparison report as JSON
+)";
+      std::exit(0);
+    } else {
+      throw std::invalid_argument("Unrecognized flag " + arg + ".");
+    }
+  }
+  return opt;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    Options opt = parseArguments(argc, argv);
+    cv::setNumThreads(1);
+    std::string opencv;
+    std::map<std::string, Golden> goldens =
+        loadManifest(fs::path(opt.golden) / "manifest.json", &opencv);
+    std::vector<Output> outputs = runAll(opt);
+    if (opt.update) {
+      update(opt, outputs, std::move(goldens));
+      return 0;
+    }
+    if (goldens.empty())
+      throw std::runtime_error("no goldens in " + opt.golden +
+                               "; record them with --update");
+    if (opencv != CV_VERSION)
+      std::cout << "[WARN] Goldens were recorded with OpenCV " << opencv
+                << ", running " << CV_VERSION << "\n";
+
+    std::vector<Verdict> verdicts;
+    std::map<std::string, bool> seen;
+    for (const Output& o : outputs) {
+      seen[o.id] = true;
+      auto g = goldens.find(o.id);
+      if (g == goldens.end()) {
+        verdicts.push_back({o.id, "new", "no golden recorded", 0, 0});
+        continue;
+      }
+      verdicts.push_back(compare(o, g->second, opt));
+    }
+    if (opt.filter.empty())
+      for (const auto& [id, g] : goldens)
+        if (!seen.count(id))
+          verdicts.push_back({id, "missing", "case no longer produced", 0, 0});
+
+    std::map<std::string, size_t> counts;
+    for (const Verdict& v : verdicts) {
+      ++counts[v.result];
+      if (v.result != "pass")
+        std::cout << "[" << (v.result == "fail" ? "FAIL" : "WARN") << "] "
+                  << v.id << ": " << v.detail << "\n";
+    }
+    std::cout << "[GOLDEN] " << counts["pass"] << " passed, " << counts["fail"]
+              << " failed, " << counts["new"] << " new, " << counts["missing"]
+              << " missing\n";
+    if (!opt.json_path.empty()) writeReport(opt.json_path, verdicts);
+    return counts["fail"] ? 1 : 0;
+  } catch (const std::exception& e) {
+    std::cout << "[ERROR] " << e.what() << std::endl;
+    return -1;
+  }
+}
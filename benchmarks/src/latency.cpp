@@ -0,0 +1,282 @@
+/**
+ * @name latency.cpp
+ * @brief Open-loop latency benchmark for inline (data loader) use
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * First measures the closed-loop capacity of a configuration, then offers
+ * tasks at fixed fractions of it with Poisson (or constant) arrivals and
+ * reports end-to-end latency percentiles against offered load. Latency runs
+ * from each task's scheduled arrival until its image is saved, so time spent
+ * waiting for a full path queue is counted rather than hidden. Sweeping the
+ * image queue capacity and the consumers' batch size shows how much of the
+ * tail is queueing rather than work.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/json_writer.hpp"
+#include "../include/session_manager.hpp"
+
+namespace {
+
+struct Options {
+  std::string config = "test/config_template.json";  ///< Pipeline config.
+  std::string images = "test/images";                ///< Input images.
+  std::vector<double> loads = {0.1, 0.3, 0.5, 0.7, 0.8, 0.9, 0.95};
+  std::vector<size_t> batches = {1, 12};     ///< Consumer batch sizes.
+  std::vector<size_t> capacities;            ///< Image queue capacities.
+  size_t threads = 0;                        ///< Producers (0: config).
+  size_t writers = 0;                        ///< Writers (0: config).
+  size_t tasks = 600;                        ///< Tasks offered per point.
+  bool poisson = true;                       ///< Exponential arrival gaps.
+  bool skip_write = false;                   ///< Encode but do not write.
+  unsigned seed = 1;                         ///< Arrival process seed.
+  std::string out = "latency.json";          ///< Results file.
+};
+
+/// One offered load of one queue configuration.
+struct Point {
+  double load = 0;        ///< Fraction of capacity offered.
+  double offered = 0;     ///< Offered images per second.
+  double achieved = 0;    ///< Completed images per second.
+  uint64_t completed = 0;
+  uint64_t p50 = 0, p99 = 0, p999 = 0, max = 0;  ///< End-to-end, ns.
+  uint64_t admission_p99 = 0;  ///< Arrival to read start, ns.
+  uint64_t handoff_p99 = 0;    ///< Image queue and batching wait, ns.
+};
+
+/// Load sweep of one (queue capacity, batch size) pair.
+struct Sweep {
+  size_t capacity = 0;
+  size_t batch = 0;
+  double capacity_rate = 0;  ///< Closed-loop images per second.
+  std::vector<Point> points;
+};
+
+template <typename T>
+std::vector<T> parseList(const std::string& s) {
+  std::vector<T> values;
+  std::stringstream in(s);
+  std::string part;
+  while (std::getline(in, part, ','))
+    if (!part.empty()) values.push_back(static_cast<T>(std::stod(part)));
+  if (values.empty()) throw std::invalid_argument("empty list '" + s + "'");
+  return values;
+}
+
+/* One run of `tasks` tasks; rate 0 feeds closed-loop */
+RunProfile runOnce(const std::vector<fs::path>& paths, const ConfigSpec& config,
+                   const Options& opt, size_t capacity, size_t batch,
+                   double rate, const fs::path& out_dir) {
+  fs::remove_all(out_dir);
+  fs::create_directories(out_dir);
+  Pipeline pipeline = configurePipeline(config.pipeline_specs, config.seed);
+  ThreadController controller(opt.threads, capacity);
+  controller.setWriterCount(opt.writers);
+  controller.setOutputFormat(config.output_format);
+  controller.setWriterBatchSize(batch);
+  controller.setArrivalRate(rate, opt.poisson, opt.seed);
+  if (opt.skip_write) controller.setSinkMode(SinkMode::SkipWrite);
+  int iterations = static_cast<int>((opt.tasks + paths.size() - 1) /
+                                    paths.size());
+  controller.run(paths, iterations, pipeline, out_dir.string());
+  return controller.profile();
+}
+
+Point measure(const std::vector<fs::path>& paths, const ConfigSpec& config,
+              const Options& opt, const Sweep& sweep, double load,
+              const fs::path& out_dir) {
+  Point p;
+  p.load = load;
+  p.offered = load * sweep.capacity_rate;
+  RunProfile profile = runOnce(paths, config, opt, sweep.capacity, sweep.batch,
+                               p.offered, out_dir);
+  const LatencyHistogram& e2e = profile.sojourn(Sojourn::EndToEnd);
+  double seconds = static_cast<double>(profile.wallTime()) / 1e9;
+  p.completed = profile.completed();
+  p.achieved = seconds > 0 ? p.completed / seconds : 0.0;
+  p.p50 = e2e.percentile(0.50);
+  p.p99 = e2e.percentile(0.99);
+  p.p999 = e2e.percentile(0.999);
+  p.max = e2e.max();
+  p.admission_p99 = profile.sojourn(Sojourn::Admission).percentile(0.99);
+  p.handoff_p99 = profile.sojourn(Sojourn::Handoff).percentile(0.99);
+  return p;
+}
+
+void writeText(std::ostream& out, const std::vector<Sweep>& sweeps,
+               const Options& opt) {
+  for (const Sweep& s : sweeps) {
+    out << std::fixed << std::setprecision(1) << "[LATENCY] image queue "
+        << s.capacity << ", batch " << s.batch << ", capacity "
+        << s.capacity_rate << " img/s, "
+        << (opt.poisson ? "Poisson" : "constant") << " arrivals\n";
+    out << "  " << std::right << std::setw(6) << "load" << std::setw(10)
+        << "offered" << std::setw(10) << "achieved" << std::setw(11) << "p50"
+        << std::setw(11) << "p99" << std::setw(11) << "p99.9" << std::setw(11)
+        << "max" << std::setw(13) << "admit p99" << std::setw(13)
+        << "handoff p99" << "\n";
+    for (const Point& p : s.points)
+      out << "  " << std::setprecision(0) << std::setw(5) << 100 * p.load
+          << "%" << std::setprecision(1) << std::setw(10) << p.offered
+          << std::setw(10) << p.achieved << std::setw(11)
+          << formatDuration(p.p50) << std::setw(11) << formatDuration(p.p99)
+          << std::setw(11) << formatDuration(p.p999) << std::setw(11)
+          << formatDuration(p.max) << std::setw(13)
+          << formatDuration(p.admission_p99) << std::setw(13)
+          << formatDuration(p.handoff_p99) << "\n";
+  }
+}
+
+void writeJson(std::ostream& out, const std::vector<Sweep>& sweeps,
+               const Options& opt) {
+  JsonWriter json(out);
+  json.beginObject()
+      .field("config", opt.config)
+      .field("tasks", opt.tasks)
+      .field("arrivals", std::string(opt.poisson ? "poisson" : "constant"))
+      .field("writes", !opt.skip_write);
+  json.key("sweeps").beginArray();
+  for (const Sweep& s : sweeps) {
+    json.beginObject()
+        .field("image_queue_capacity", s.capacity)
+        .field("batch_size", s.batch)
+        .field("capacity_rate", s.capacity_rate);
+    json.key("points").beginArray();
+    for (const Point& p : s.points)
+      json.beginObject()
+          .field("load", p.load)
+          .field("offered_rate", p.offered)
+          .field("achieved_rate", p.achieved)
+          .field("completed", p.completed)
+          .field("p50_ns", p.p50)
+          .field("p99_ns", p.p99)
+          .field("p999_ns", p.p999)
+          .field("max_ns", p.max)
+          .field("admission_p99_ns", p.admission_p99)
+          .field("handoff_p99_ns", p.handoff_p99)
+          .endObject();
+    json.endArray();
+    json.endObject();
+  }
+  json.endArray();
+  json.endObject();
+  out << "\n";
+}
+
+Options parseArguments(int argc, char* argv[]) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--config" && has_value) {
+      opt.config = argv[++i];
+    } else if (arg == "--images" && has_value) {
+      opt.images = argv[++i];
+    } else if (arg == "--loads" && has_value) {
+      opt.loads = parseList<double>(argv[++i]);
+    } else if (arg == "--batch" && has_value) {
+      opt.batches = parseList<size_t>(argv[++i]);
+    } else if (arg == "--queue" && has_value) {
+      opt.capacities = parseList<size_t>(argv[++i]);
+    } else if (arg == "--threads" && has_value) {
+      opt.threads = std::stoul(argv[++i]);
+    } else if (arg == "--writers" && has_value) {
+      opt.writers = std::stoul(argv[++i]);
+    } else if (arg == "--tasks" && has_value) {
+      opt.tasks = std::max(1ul, std::stoul(argv[++i]));
+    } else if (arg == "--constant") {
+      opt.poisson = false;
+    } else if (arg == "--skip-write") {
+      opt.skip_write = true;
+    } else if (arg == "--seed" && has_value) {
+      opt.seed = static_cast<unsigned>(std::stoul(argv[++i]));
+    } else if (arg == "--out" && has_value) {
+      opt.out = argv[++i];
+    } else if (arg == "--help" || arg == "-h") {
+      std::cout << R"(
+Usage: latency [OPTIONS]
+
+  --config <path>     Pipeline configuration (default test/config_template.json)
+  --images <dir>      Input images (default test/images)
+  --loads <list>      Offered load as fractions of capacity
+                      (default 0.1,0.3,0.5,0.7,0.8,0.9,0.95)
+  --batch <list>      Consumer batch sizes (default 1,12)
+  --queue <list>      Image queue capacities (default from the config)
+  --threads <n>       Producer threads (default from the config)
+  --writers <n>       Writer threads (default from the config)
+  --tasks <n>         Tasks offered per point (default 600)
+  --constant          Evenly spaced arrivals instead of Poisson
+  --skip-write        Encode but do not write images
+  --seed <n>          Arrival process seed (default 1)
+  --out <path>        Results JSON (default latency.json)
+)";
+      std::exit(0);
+    } else {
+      throw std::invalid_argument("Unrecognized flag " + arg + ".");
+    }
+  }
+  for (double load : opt.loads)
+    if (load <= 0) throw std::invalid_argument("loads must be positive");
+  return opt;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    Options opt = parseArguments(argc, argv);
+    ConfigSpec config = parseConfigFile(opt.config);
+    if (!opt.threads) opt.threads = std::max<size_t>(1, config.num_threads);
+    if (!opt.writers) opt.writers = std::max<size_t>(1, config.num_writers);
+    if (opt.capacities.empty()) opt.capacities = {config.queue_capacity};
+    std::vector<fs::path> paths;
+    for (const auto& entry : fs::directory_iterator(opt.images))
+      if (entry.is_regular_file()) paths.push_back(entry.path());
+    if (paths.empty()) throw std::runtime_error("no images in " + opt.images);
+    std::sort(paths.begin(), paths.end());
+    fs::path out_dir = fs::temp_directory_path() / "augmento-latency";
+
+    std::vector<Sweep> sweeps;
+    for (size_t capacity : opt.capacities) {
+      for (size_t batch : opt.batches) {
+        Sweep sweep;
+        sweep.capacity = capacity;
+        sweep.batch = batch;
+        RunProfile closed =
+            runOnce(paths, config, opt, capacity, batch, 0, out_dir);
+        double seconds = static_cast<double>(closed.wallTime()) / 1e9;
+        sweep.capacity_rate = seconds > 0 ? closed.completed() / seconds : 0;
+        if (sweep.capacity_rate <= 0)
+          throw std::runtime_error("closed-loop run completed no images");
+        std::cout << "[INFO] Queue " << capacity << ", batch " << batch
+                  << ": capacity " << std::fixed << std::setprecision(1)
+                  << sweep.capacity_rate << " img/s" << std::endl;
+        for (double load : opt.loads)
+          sweep.points.push_back(
+              measure(paths, config, opt, sweep, load, out_dir));
+        sweeps.push_back(std::move(sweep));
+      }
+    }
+    fs::remove_all(out_dir);
+
+    writeText(std::cout, sweeps, opt);
+    std::ofstream out(opt.out);
+    if (!out) throw std::runtime_error("could not open " + opt.out);
+    writeJson(out, sweeps, opt);
+    std::cout << "[INFO] Wrote results to " << opt.out << "\n";
+    return 0;
+  } catch (const std::exception& e) {
+    std::cout << "[ERROR] " << e.what() << std::endl;
+    return -1;
+  }
+}
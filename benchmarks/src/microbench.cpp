@@ -0,0 +1,320 @@
+/**
+ * @name microbench.cpp
+ * @brief Microbenchmarks of every manipulation function and Operation
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * Runs each function of manipulations.hpp and each Operation built by
+ * OperationFactory on in-memory synthetic images over a matrix of sizes,
+ * channel counts and parameters. Every case is warmed up, then repeated on a
+ * fresh copy of its input; the copy is not timed. Results are reported as
+ * median time, ns per input pixel, GB/s (input plus output bytes) and the
+ * coefficient of variation, as text and optionally as JSON.
+ */
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../include/json_writer.hpp"
+#include "cases.hpp"
+
+namespace {
+
+using cases::Case;
+
+struct Options {
+  std::vector<cv::Size> sizes = {{64, 64},     {256, 256},   {1024, 1024},
+                                 {1920, 1080}, {3840, 2160}, {7680, 4320}};
+  std::vector<int> channels = {1, 3};
+  int warmup = 2;           ///< Untimed calls per case.
+  int reps = 10;            ///< Timed calls per case.
+  double budget_ms = 2000;  ///< Stop repeating a case after this long.
+  int cpu = 0;              ///< CPU to pin to (-1 disables pinning).
+  int cv_threads = 1;       ///< OpenCV worker threads.
+  unsigned seed = 42;       ///< Seed of images and operations.
+  std::string filter;       ///< Only run cases whose name contains this.
+  std::string json_path;    ///< Optional JSON output.
+};
+
+struct Result {
+  std::string group;       ///< Case group.
+  std::string name;        ///< Case name.
+  std::string params;      ///< Case parameters.
+  cv::Size size;           ///< Image size.
+  int channels = 0;        ///< Channel count.
+  bool supported = true;   ///< False if the case rejected its input.
+  std::vector<double> ns;  ///< Timed samples.
+  double bytes = 0;        ///< Input plus output bytes of one call.
+
+  double median() const {
+    std::vector<double> s = ns;
+    std::sort(s.begin(), s.end());
+    size_t n = s.size();
+    return n ? (n % 2 ? s[n / 2] : 0.5 * (s[n / 2 - 1] + s[n / 2])) : 0.0;
+  }
+  double mean() const {
+    double sum = 0;
+    for (double v : ns) sum += v;
+    return ns.empty() ? 0.0 : sum / ns.size();
+  }
+  double stddev() const {
+    if (ns.size() < 2) return 0.0;
+    double m = mean(), acc = 0;
+    for (double v : ns) acc += (v - m) * (v - m);
+    return std::sqrt(acc / (ns.size() - 1));
+  }
+  double cv() const { return mean() > 0 ? stddev() / mean() : 0.0; }
+  double nsPerPixel() const {
+    return median() / (static_cast<double>(size.width) * size.height);
+  }
+  double gbs() const { return median() > 0 ? bytes / median() : 0.0; }
+};
+
+double nowNs() {
+  return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+/* Smooth gradient plus uniform noise, so histograms and codecs see texture */
+cv::Mat syntheticImage(const cv::Size& size, int channels, unsigned seed) {
+  cv::Mat img(size, CV_8UC(channels));
+  cv::RNG rng(seed);
+  rng.fill(img, cv::RNG::UNIFORM, 0, 64);
+  for (int y = 0; y < size.height; ++y) {
+    uchar* row = img.ptr<uchar>(y);
+    for (int x = 0; x < size.width; ++x)
+      for (int c = 0; c < channels; ++c)
+        row[x * channels + c] = cv::saturate_cast<uchar>(
+            row[x * channels + c] +
+            (x * 191 / std::max(1, size.width) + c * 32 +
+             y * 64 / std::max(1, size.height)));
+  }
+  return img;
+}
+
+Result measure(const Case& c, const cv::Mat& src, const Options& opt) {
+  Result r;
+  r.group = c.group;
+  r.name = c.name;
+  r.params = c.params;
+  r.size = src.size();
+  r.channels = src.channels();
+  cv::Mat in, out;
+  double in_bytes = static_cast<double>(src.total() * src.elemSize());
+  try {
+    for (int i = 0; i < opt.warmup; ++i) {
+      src.copyTo(in);
+      if (!c.run(in, out)) {
+        r.supported = false;
+        return r;
+      }
+    }
+    double started = nowNs();
+    for (int i = 0; i < opt.reps; ++i) {
+      src.copyTo(in);
+      double t0 = nowNs();
+      bool ok = c.run(in, out);
+      double t1 = nowNs();
+      if (!ok) {
+        r.supported = false;
+        return r;
+      }
+      r.ns.push_back(t1 - t0);
+      if (i >= 2 && t1 - started > opt.budget_ms * 1e6) break;
+    }
+  } catch (const std::exception&) {
+    r.supported = false;
+    return r;
+  }
+  r.bytes = in_bytes + static_cast<double>(out.total() * out.elemSize());
+  return r;
+}
+
+bool pinToCpu(int cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+std::vector<std::string> split(const std::string& s, char sep) {
+  std::vector<std::string> parts;
+  std::stringstream in(s);
+  std::string part;
+  while (std::getline(in, part, sep))
+    if (!part.empty()) parts.push_back(part);
+  return parts;
+}
+
+Options parseArguments(int argc, char* argv[]) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--sizes" && has_value) {
+      opt.sizes.clear();
+      for (const std::string& s : split(argv[++i], ',')) {
+        size_t x = s.find('x');
+        int w = std::stoi(s.substr(0, x));
+        int h = x == std::string::npos ? w : std::stoi(s.substr(x + 1));
+        opt.sizes.emplace_back(w, h);
+      }
+    } else if (arg == "--channels" && has_value) {
+      opt.channels.clear();
+      for (const std::string& s : split(argv[++i], ','))
+        opt.channels.push_back(std::stoi(s));
+    } else if (arg == "--warmup" && has_value) {
+      opt.warmup = std::stoi(argv[++i]);
+    } else if (arg == "--reps" && has_value) {
+      opt.reps = std::max(1, std::stoi(argv[++i]));
+    } else if (arg == "--budget-ms" && has_value) {
+      opt.budget_ms = std::stod(argv[++i]);
+    } else if (arg == "--cpu" && has_value) {
+      opt.cpu = std::stoi(argv[++i]);
+    } else if (arg == "--cv-threads" && has_value) {
+      opt.cv_threads = std::stoi(argv[++i]);
+    } else if (arg == "--seed" && has_value) {
+      opt.seed = static_cast<unsigned>(std::stoul(argv[++i]));
+    } else if (arg == "--filter" && has_value) {
+      opt.filter = argv[++i];
+    } else if (arg == "--json" && has_value) {
+      opt.json_path = argv[++i];
+    } else if (arg == "--help" || arg == "-h") {
+      std::cout << R"(
+Usage: microbench [OPTIONS]
+
+  --sizes <list>      Image sizes, e.g. 64,256x256,1920x1080
+                      (default 64 to 7680x4320)
+  --channels <list>   Channel counts (default 1,3)
+  --warmup <n>        Untimed calls per case (default 2)
+  --reps <n>          Timed calls per case (default 10)
+  --budget-ms <ms>    Stop repeating a case after this long (default 2000)
+  --cpu <n>           Pin to CPU n, -1 to disable (default 0)
+  --cv-threads <n>    OpenCV worker threads (default 1)
+  --seed <n>          Seed of images and operations (default 42)
+  --filter <text>     Only run cases whose name contains text
+  --json <path>       Also write results as JSON
+)";
+      std::exit(0);
+    } else {
+      throw std::invalid_argument("Unrecognized flag " + arg + ".");
+    }
+  }
+  return opt;
+}
+
+void writeJson(std::ostream& out, const Options& opt,
+               const std::vector<Result>& results) {
+  JsonWriter json(out);
+  json.beginObject()
+      .field("cpu", opt.cpu)
+      .field("cv_threads", opt.cv_threads)
+      .field("warmup", opt.warmup)
+      .field("reps", opt.reps)
+      .field("seed", opt.seed);
+  json.key("results").beginArray();
+  for (const Result& r : results) {
+    json.beginObject()
+        .field("group", r.group)
+        .field("name", r.name)
+        .field("params", r.params)
+        .field("width", r.size.width)
+        .field("height", r.size.height)
+        .field("channels", r.channels)
+        .field("supported", r.supported);
+    if (r.supported) {
+      json.field("samples", r.ns.size())
+          .field("median_ns", r.median())
+          .field("mean_ns", r.mean())
+          .field("stddev_ns", r.stddev())
+          .field("cv", r.cv())
+          .field("ns_per_pixel", r.nsPerPixel())
+          .field("bytes", r.bytes)
+          .field("gbs", r.gbs());
+    }
+    json.endObject();
+  }
+  json.endArray();
+  json.endObject();
+  out << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    Options opt = parseArguments(argc, argv);
+    if (opt.cpu >= 0 && !pinToCpu(opt.cpu))
+      std::cerr << "[WARN] Could not pin to CPU " << opt.cpu << std::endl;
+    cv::setNumThreads(opt.cv_threads);
+    std::mt19937 rng(opt.seed);
+
+    std::vector<Result> results;
+    std::cout << std::left << std::setw(10) << "group" << std::setw(24)
+              << "name" << std::setw(16) << "params" << std::right
+              << std::setw(12) << "size" << std::setw(4) << "ch"
+              << std::setw(12) << "median us" << std::setw(10) << "ns/px"
+              << std::setw(9) << "GB/s" << std::setw(8) << "cv%" << "\n";
+    for (const cv::Size& size : opt.sizes) {
+      std::vector<Case> cases = cases::buildCases(size, rng);
+      for (int channels : opt.channels) {
+        cv::Mat src = syntheticImage(size, channels, opt.seed);
+        for (const Case& c : cases) {
+          if (!opt.filter.empty() &&
+              c.name.find(opt.filter) == std::string::npos)
+            continue;
+          Result r = measure(c, src, opt);
+          std::cout << std::left << std::setw(10) << c.group << std::setw(24)
+                    << c.name << std::setw(16) << c.params << std::right
+                    << std::setw(12)
+                    << std::to_string(size.width) + "x" +
+                           std::to_string(size.height)
+                    << std::setw(4) << channels;
+          if (r.supported)
+            std::cout << std::fixed << std::setprecision(1) << std::setw(12)
+                      << r.median() / 1e3 << std::setprecision(3)
+                      << std::setw(10) << r.nsPerPixel() << std::setprecision(2)
+                      << std::setw(9) << r.gbs() << std::setprecision(1)
+                      << std::setw(8) << 100.0 * r.cv() << "\n";
+          else
+            std::cout << std::setw(12) << "n/a" << "\n";
+          results.push_back(std::move(r));
+        }
+      }
+    }
+
+    if (!opt.json_path.empty()) {
+      std::ofstream out(opt.json_path);
+      if (!out) {
+        std::cerr << "[ERROR] Could not open " << opt.json_path << std::endl;
+        return 1;
+      }
+      writeJson(out, opt, results);
+      std::cout << "[INFO] Wrote results to " << opt.json_path << "\n";
+    }
+    return 0;
+  } catch (const std::exception& e) {
+    std::cout << "[ERROR] " << e.what() << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,315 @@
+/**
+ * @name regress.cpp
+ * @brief Macro-benchmark runner and statistical regression gate
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * Runs the full ThreadController on fixed datasets with a fixed configuration
+ * and seed, several times each: the real images in test/images and a
+ * synthetic set generated from the seed. Every repetition contributes one
+ * sample per metric (wall time per image, mean time of each stage and of each
+ * operation). Results are saved as JSON; when a baseline is given, each
+ * metric is compared with a Mann-Whitney U test and a Hodges-Lehmann ratio
+ * with confidence interval. The process exits with status 1 if any metric is
+ * significantly slower than the baseline by more than the threshold.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../include/json_writer.hpp"
+#include "../include/session_manager.hpp"
+#include "stats.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+struct Options {
+  std::string config = "test/config_template.json";  ///< Pipeline config.
+  std::string images = "test/images";                ///< Real dataset.
+  size_t synthetic = 24;      ///< Synthetic images (0 disables).
+  int synthetic_width = 1280;   ///< Synthetic image width.
+  int synthetic_height = 960;   ///< Synthetic image height.
+  size_t threads = 4;         ///< Producer threads.
+  int iterations = 2;         ///< Augmentations per image.
+  int reps = 7;               ///< Timed repetitions per dataset.
+  unsigned seed = 671;        ///< Seed of the synthetic set and pipeline.
+  double threshold = 0.05;    ///< Slowdown tolerated before flagging.
+  double alpha = 0.01;        ///< Significance level.
+  std::string out = "regress_results.json";  ///< Results file.
+  std::string baseline;       ///< Baseline to compare with (optional).
+};
+
+/// Samples of every metric, keyed "<dataset>/<kind>/<name>".
+using Samples = std::map<std::string, std::vector<double>>;
+
+struct Dataset {
+  std::string name;
+  std::vector<fs::path> paths;
+};
+
+struct Comparison {
+  std::string metric;
+  double base_median = 0;
+  double median = 0;
+  stats::RatioEstimate ratio;
+  double p = 1;
+  std::string verdict;  ///< "ok", "regression", "improvement" or "new".
+};
+
+std::vector<fs::path> listImages(const std::string& dir) {
+  std::vector<fs::path> paths;
+  for (const auto& entry : fs::directory_iterator(dir))
+    if (entry.is_regular_file()) paths.push_back(entry.path());
+  std::sort(paths.begin(), paths.end());
+  return paths;
+}
+
+Dataset makeSynthetic(const Options& opt, const fs::path& dir) {
+  synth::DatasetSpec spec;
+  spec.count = opt.synthetic;
+  spec.sizes = {{opt.synthetic_width, opt.synthetic_height, 1.0}};
+  spec.seed = opt.seed;
+  Dataset set{"synthetic", {}};
+  for (const synth::FileInfo& file : synth::generate(spec, dir))
+    set.paths.push_back(file.path);
+  return set;
+}
+
+/* One run of the whole pipeline; appends one sample per metric */
+void runOnce(const Dataset& set, const ConfigSpec& config, const Options& opt,
+             const fs::path& out_dir, Samples* samples) {
+  fs::remove_all(out_dir);
+  fs::create_directories(out_dir);
+  Pipeline pipeline = configurePipeline(config.pipeline_specs, opt.seed);
+  ThreadController controller(opt.threads, config.queue_capacity);
+  controller.setOutputFormat(config.output_format);
+  controller.run(set.paths, opt.iterations, pipeline, out_dir.string());
+  if (!samples) return;
+
+  const RunProfile& profile = controller.profile();
+  if (!profile.completed())
+    throw std::runtime_error("no image completed on " + set.name);
+  std::string prefix = set.name + "/";
+  (*samples)[prefix + "wall_per_image"].push_back(
+      static_cast<double>(profile.wallTime()) / profile.completed());
+  for (size_t s = 0; s < kStageCount; ++s) {
+    const LatencyHistogram& h = profile.stage(static_cast<Stage>(s));
+    if (h.count())
+      (*samples)[prefix + "stage/" + stageName(static_cast<Stage>(s))]
+          .push_back(h.mean());
+  }
+  for (size_t i = 0; i < profile.ops().size(); ++i) {
+    if (!profile.ops()[i].count()) continue;
+    (*samples)[prefix + "op/" + std::to_string(i) + " " +
+               profile.opLabels()[i]]
+        .push_back(profile.ops()[i].mean());
+  }
+}
+
+Samples loadBaseline(const std::string& path) {
+  Samples samples;
+  simdjson::padded_string data = simdjson::padded_string::load(path);
+  simdjson::ondemand::parser parser;
+  simdjson::ondemand::document doc = parser.iterate(data);
+  for (auto field : doc["metrics"].get_object()) {
+    std::string name(field.unescaped_key().value());
+    std::vector<double>& values = samples[name];
+    for (auto v : field.value().get_array())
+      values.push_back(v.get_double());
+  }
+  return samples;
+}
+
+std::vector<Comparison> compare(const Samples& current,
+                                const Samples& baseline, const Options& opt) {
+  std::vector<Comparison> result;
+  for (const auto& [metric, values] : current) {
+    Comparison c;
+    c.metric = metric;
+    c.median = stats::median(values);
+    auto base = baseline.find(metric);
+    if (base == baseline.end()) {
+      c.verdict = "new";
+      result.push_back(c);
+      continue;
+    }
+    c.base_median = stats::median(base->second);
+    c.ratio = stats::ratioEstimate(values, base->second, 1 - opt.alpha);
+    c.p = stats::mannWhitneyP(values, base->second);
+    bool significant = c.p < opt.alpha;
+    if (significant && c.ratio.ratio > 1 + opt.threshold)
+      c.verdict = "regression";
+    else if (significant && c.ratio.ratio < 1 - opt.threshold)
+      c.verdict = "improvement";
+    else
+      c.verdict = "ok";
+    result.push_back(c);
+  }
+  return result;
+}
+
+void writeResults(const std::string& path, const Options& opt,
+                  const Samples& samples,
+                  const std::vector<Comparison>& comparisons) {
+  std::ofstream out(path);
+  if (!out) throw std::runtime_error("could not open " + path);
+  JsonWriter json(out);
+  json.beginObject()
+      .field("config", opt.config)
+      .field("seed", opt.seed)
+      .field("threads", opt.threads)
+      .field("iterations", opt.iterations)
+      .field("reps", opt.reps)
+      .field("synthetic", opt.synthetic);
+  json.key("metrics").beginObject();
+  for (const auto& [metric, values] : samples) {
+    json.key(metric).beginArray();
+    for (double v : values) json.value(v);
+    json.endArray();
+  }
+  json.endObject();
+  if (!comparisons.empty()) {
+    json.key("comparison").beginArray();
+    for (const Comparison& c : comparisons)
+      json.beginObject()
+          .field("metric", c.metric)
+          .field("baseline_median_ns", c.base_median)
+          .field("median_ns", c.median)
+          .field("ratio", c.ratio.ratio)
+          .field("ratio_lower", c.ratio.lower)
+          .field("ratio_upper", c.ratio.upper)
+          .field("p", c.p)
+          .field("verdict", c.verdict)
+          .endObject();
+    json.endArray();
+  }
+  json.endObject();
+  out << "\n";
+}
+
+void printComparisons(const std::vector<Comparison>& comparisons,
+                      const Options& opt) {
+  std::cout << "[REGRESS] Against baseline (threshold "
+            << 100 * opt.threshold << "%, alpha " << opt.alpha << ", "
+            << 100 * (1 - opt.alpha) << "% intervals)\n";
+  std::cout << "  " << std::left << std::setw(40) << "metric" << std::right
+            << std::setw(11) << "baseline" << std::setw(11) << "current"
+            << std::setw(22) << "ratio [CI]" << std::setw(9) << "p"
+            << "  verdict\n";
+  for (const Comparison& c : comparisons) {
+    std::ostringstream ratio;
+    ratio << std::fixed << std::setprecision(3) << c.ratio.ratio << " ["
+          << c.ratio.lower << ", " << c.ratio.upper << "]";
+    std::cout << "  " << std::left << std::setw(40) << c.metric << std::right
+              << std::setw(11) << formatDuration(c.base_median)
+              << std::setw(11) << formatDuration(c.median) << std::setw(22)
+              << ratio.str() << std::setw(9) << std::setprecision(3)
+              << c.p << "  " << c.verdict << "\n";
+  }
+}
+
+Options parseArguments(int argc, char* argv[]) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--config" && has_value) {
+      opt.config = argv[++i];
+    } else if (arg == "--images" && has_value) {
+      opt.images = argv[++i];
+    } else if (arg == "--synthetic" && has_value) {
+      opt.synthetic = std::stoul(argv[++i]);
+    } else if (arg == "--threads" && has_value) {
+      opt.threads = std::max(1ul, std::stoul(argv[++i]));
+    } else if (arg == "--iterations" && has_value) {
+      opt.iterations = std::max(1, std::stoi(argv[++i]));
+    } else if (arg == "--reps" && has_value) {
+      opt.reps = std::max(2, std::stoi(argv[++i]));
+    } else if (arg == "--seed" && has_value) {
+      opt.seed = static_cast<unsigned>(std::stoul(argv[++i]));
+    } else if (arg == "--threshold" && has_value) {
+      opt.threshold = std::stod(argv[++i]);
+    } else if (arg == "--alpha" && has_value) {
+      opt.alpha = std::stod(argv[++i]);
+    } else if (arg == "--out" && has_value) {
+      opt.out = argv[++i];
+    } else if (arg == "--baseline" && has_value) {
+      opt.baseline = argv[++i];
+    } else if (arg == "--help" || arg == "-h") {
+      std::cout << R"(
+Usage: regress [OPTIONS]
+
+  --config <path>     Pipeline configuration (default test/config_template.json)
+  --images <dir>      Real dataset (default test/images)
+  --synthetic <n>     Synthetic 1280x960 JPEGs to generate (default 24, 0 skips)
+  --threads <n>       Producer threads (default 4)
+  --iterations <n>    Augmentations per image (default 2)
+  --reps <n>          Timed repetitions per dataset (default 7)
+  --seed <n>          Seed of the synthetic set and pipeline (default 671)
+  --out <path>        Results JSON (default regress_results.json)
+  --baseline <path>   Compare with a previous results file
+  --threshold <f>     Tolerated slowdown (default 0.05)
+  --alpha <f>         Significance level (default 0.01)
+)";
+      std::exit(0);
+    } else {
+      throw std::invalid_argument("Unrecognized flag " + arg + ".");
+    }
+  }
+  return opt;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    Options opt = parseArguments(argc, argv);
+    ConfigSpec config = parseConfigFile(opt.config);
+    fs::path work = fs::temp_directory_path() /
+                    ("augmento-regress-" + std::to_string(opt.seed));
+
+    std::vector<Dataset> datasets;
+    if (!opt.images.empty())
+      datasets.push_back(Dataset{"real", listImages(opt.images)});
+    if (opt.synthetic)
+      datasets.push_back(makeSynthetic(opt, work / "synthetic"));
+
+    Samples samples;
+    for (const Dataset& set : datasets) {
+      std::cout << "[INFO] " << set.name << ": " << set.paths.size()
+                << " images x " << opt.iterations << " iterations, "
+                << opt.reps << " repetitions\n";
+      runOnce(set, config, opt, work / "output", nullptr);  // warmup
+      for (int r = 0; r < opt.reps; ++r)
+        runOnce(set, config, opt, work / "output", &samples);
+    }
+    fs::remove_all(work);
+
+    std::vector<Comparison> comparisons;
+    if (!opt.baseline.empty()) {
+      comparisons = compare(samples, loadBaseline(opt.baseline), opt);
+      printComparisons(comparisons, opt);
+    }
+    writeResults(opt.out, opt, samples, comparisons);
+    std::cout << "[INFO] Wrote results to " << opt.out << "\n";
+
+    size_t regressions = 0;
+    for (const Comparison& c : comparisons)
+      if (c.verdict == "regression") ++regressions;
+    if (regressions) {
+      std::cout << "[REGRESS] " << regressions
+                << " metric(s) regressed beyond the threshold\n";
+      return 1;
+    }
+    return 0;
+  } catch (const std::exception& e) {
+    std::cout << "[ERROR] " << e.what() << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,299 @@
+/**
+ * @name scaling.cpp
+ * @brief Thread-scaling analyser for ThreadController
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * Runs one workload with 1..N producer threads for each requested writer
+ * count, with every worker pinned to its own CPU. For each point it reports
+ * throughput, speedup over one producer, parallel efficiency and the
+ * bottleneck diagnosed by the advisor, then fits Amdahl's law (serial
+ * fraction) and the Universal Scalability Law (contention and coherency) to
+ * each curve. The point where efficiency drops below the knee threshold is
+ * reported together with what was limiting the run there.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/advisor.hpp"
+#include "../include/json_writer.hpp"
+#include "../include/session_manager.hpp"
+#include "stats.hpp"
+
+namespace {
+
+struct Options {
+  std::string config = "test/config_template.json";  ///< Pipeline config.
+  std::string images = "test/images";                ///< Input images.
+  std::vector<size_t> threads;          ///< Producer counts (default 1..N).
+  std::vector<size_t> writers = {1, 2};  ///< Writer counts.
+  int iterations = 2;                   ///< Augmentations per image.
+  int reps = 3;                         ///< Runs per point (median kept).
+  bool pin = true;                      ///< Pin workers to CPUs.
+  double knee = 0.8;                    ///< Efficiency marking the knee.
+  std::string out = "scaling.json";     ///< Results file.
+};
+
+struct Point {
+  size_t threads = 0;
+  double throughput = 0;  ///< Images per second (median of repetitions).
+  double speedup = 0;
+  double efficiency = 0;
+  Diagnosis diagnosis;    ///< Advisor's view of the median run.
+};
+
+struct Curve {
+  size_t writers = 0;
+  std::vector<Point> points;
+  stats::AmdahlFit amdahl;
+  stats::UslFit usl;
+  const Point* knee = nullptr;  ///< First point below the knee efficiency.
+};
+
+std::vector<size_t> parseList(const std::string& s) {
+  std::vector<size_t> values;
+  std::stringstream in(s);
+  std::string part;
+  while (std::getline(in, part, ','))
+    if (!part.empty()) values.push_back(std::max(1ul, std::stoul(part)));
+  return values;
+}
+
+/* Median-throughput run of one configuration */
+Point measure(const std::vector<fs::path>& paths, const ConfigSpec& config,
+              const Options& opt, size_t threads, size_t writers,
+              const fs::path& out_dir) {
+  std::vector<std::pair<double, Diagnosis>> runs;
+  for (int r = 0; r < opt.reps; ++r) {
+    fs::remove_all(out_dir);
+    fs::create_directories(out_dir);
+    Pipeline pipeline = configurePipeline(config.pipeline_specs, config.seed);
+    ThreadController controller(threads, config.queue_capacity);
+    controller.setWriterCount(writers);
+    controller.setOutputFormat(config.output_format);
+    controller.enableCpuPinning(opt.pin);
+    controller.run(paths, opt.iterations, pipeline, out_dir.string());
+
+    const RunProfile& profile = controller.profile();
+    RunShape shape;
+    shape.producers = threads;
+    shape.writers = writers;
+    shape.output_ext = config.output_format;
+    shape.queue_capacity = config.queue_capacity;
+    shape.hardware_threads = std::thread::hardware_concurrency();
+    double seconds = static_cast<double>(profile.wallTime()) / 1e9;
+    runs.emplace_back(seconds > 0 ? profile.completed() / seconds : 0.0,
+                      diagnoseRun(profile, controller.queueReports(), shape));
+  }
+  std::sort(runs.begin(), runs.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  Point p;
+  p.threads = threads;
+  p.throughput = runs[runs.size() / 2].first;
+  p.diagnosis = runs[runs.size() / 2].second;
+  return p;
+}
+
+void fit(Curve& curve, double knee) {
+  double base = curve.points.front().throughput;
+  std::vector<double> n, s;
+  for (Point& p : curve.points) {
+    p.speedup = base > 0 ? p.throughput / base : 0.0;
+    p.efficiency = p.speedup / p.threads;
+    n.push_back(static_cast<double>(p.threads));
+    s.push_back(p.speedup);
+    if (!curve.knee && p.efficiency < knee) curve.knee = &p;
+  }
+  curve.amdahl = stats::fitAmdahl(n, s);
+  curve.usl = stats::fitUsl(n, s);
+}
+
+void writeText(std::ostream& out, const std::vector<Curve>& curves,
+               const Options& opt) {
+  out << std::fixed;
+  for (const Curve& c : curves) {
+    out << "[SCALING] " << c.writers << " writer(s)" << (opt.pin ? ", pinned" : "")
+        << "\n";
+    out << "  " << std::right << std::setw(7) << "threads" << std::setw(10)
+        << "img/s" << std::setw(9) << "speedup" << std::setw(8) << "eff"
+        << std::setw(10) << "prod busy" << std::setw(11) << "write busy"
+        << "  bottleneck\n";
+    for (const Point& p : c.points) {
+      out << "  " << std::setw(7) << p.threads << std::setprecision(1)
+          << std::setw(10) << p.throughput << std::setprecision(2)
+          << std::setw(9) << p.speedup << std::setprecision(0)
+          << std::setw(7) << 100 * p.efficiency << "%" << std::setw(9)
+          << 100 * p.diagnosis.producer_utilisation << "%" << std::setw(10)
+          << 100 * p.diagnosis.writer_utilisation << "%  "
+          << bottleneckName(p.diagnosis.bottleneck) << "\n";
+    }
+    out << std::setprecision(3) << "  Amdahl: serial fraction "
+        << c.amdahl.serial << " (max speedup "
+        << (c.amdahl.serial > 0 ? 1 / c.amdahl.serial : INFINITY)
+        << "), rmse " << c.amdahl.rmse << "\n";
+    out << "  USL: sigma " << c.usl.sigma << ", kappa " << std::setprecision(5)
+        << c.usl.kappa << std::setprecision(1) << ", peak at "
+        << c.usl.peak() << " threads, rmse " << std::setprecision(3)
+        << c.usl.rmse << "\n";
+    if (c.knee)
+      out << "  Efficiency falls below " << std::setprecision(0)
+          << 100 * opt.knee << "% at " << c.knee->threads << " threads: "
+          << bottleneckName(c.knee->diagnosis.bottleneck) << ", "
+          << c.knee->diagnosis.detail << "\n";
+    else
+      out << "  Efficiency stays above " << std::setprecision(0)
+          << 100 * opt.knee << "% over the measured range\n";
+  }
+}
+
+void writeJson(std::ostream& out, const std::vector<Curve>& curves,
+               const Options& opt) {
+  JsonWriter json(out);
+  json.beginObject()
+      .field("config", opt.config)
+      .field("iterations", opt.iterations)
+      .field("reps", opt.reps)
+      .field("pinned", opt.pin)
+      .field("knee_efficiency", opt.knee);
+  json.key("curves").beginArray();
+  for (const Curve& c : curves) {
+    json.beginObject().field("writers", c.writers);
+    json.key("points").beginArray();
+    for (const Point& p : c.points)
+      json.beginObject()
+          .field("threads", p.threads)
+          .field("throughput", p.throughput)
+          .field("speedup", p.speedup)
+          .field("efficiency", p.efficiency)
+          .field("producer_utilisation", p.diagnosis.producer_utilisation)
+          .field("writer_utilisation", p.diagnosis.writer_utilisation)
+          .field("bottleneck", bottleneckName(p.diagnosis.bottleneck))
+          .endObject();
+    json.endArray();
+    json.key("amdahl").beginObject()
+        .field("serial_fraction", c.amdahl.serial)
+        .field("rmse", c.amdahl.rmse)
+        .endObject();
+    json.key("usl").beginObject()
+        .field("sigma", c.usl.sigma)
+        .field("kappa", c.usl.kappa)
+        .field("peak_threads", c.usl.peak())
+        .field("rmse", c.usl.rmse)
+        .endObject();
+    if (c.knee)
+      json.key("knee").beginObject()
+          .field("threads", c.knee->threads)
+          .field("bottleneck", bottleneckName(c.knee->diagnosis.bottleneck))
+          .field("detail", c.knee->diagnosis.detail)
+          .endObject();
+    json.endObject();
+  }
+  json.endArray();
+  json.endObject();
+  out << "\n";
+}
+
+Options parseArguments(int argc, char* argv[]) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--config" && has_value) {
+      opt.config = argv[++i];
+    } else if (arg == "--images" && has_value) {
+      opt.images = argv[++i];
+    } else if (arg == "--threads" && has_value) {
+      opt.threads = parseList(argv[++i]);
+    } else if (arg == "--max-threads" && has_value) {
+      opt.threads.clear();
+      for (size_t n = 1, max = std::stoul(argv[++i]); n <= max; ++n)
+        opt.threads.push_back(n);
+    } else if (arg == "--writers" && has_value) {
+      opt.writers = parseList(argv[++i]);
+    } else if (arg == "--iterations" && has_value) {
+      opt.iterations = std::max(1, std::stoi(argv[++i]));
+    } else if (arg == "--reps" && has_value) {
+      opt.reps = std::max(1, std::stoi(argv[++i]));
+    } else if (arg == "--knee" && has_value) {
+      opt.knee = std::stod(argv[++i]);
+    } else if (arg == "--no-pin") {
+      opt.pin = false;
+    } else if (arg == "--out" && has_value) {
+      opt.out = argv[++i];
+    } else if (arg == "--help" || arg == "-h") {
+      std::cout << R"(
+Usage: scaling [OPTIONS]
+
+  --config <path>     Pipeline configuration (default test/config_template.json)
+  --images <dir>      Input images (default test/images)
+  --threads <list>    Producer counts, e.g. 1,2,4,8 (default 1..CPUs)
+  --max-threads <n>   Producer counts 1..n
+  --writers <list>    Writer counts (default 1,2)
+  --iterations <n>    Augmentations per image (default 2)
+  --reps <n>          Runs per point, median kept (default 3)
+  --knee <f>          Efficiency that marks the end of scaling (default 0.8)
+  --no-pin            Do not pin workers to CPUs
+  --out <path>        Results JSON (default scaling.json)
+)";
+      std::exit(0);
+    } else {
+      throw std::invalid_argument("Unrecognized flag " + arg + ".");
+    }
+  }
+  if (opt.threads.empty())
+    for (size_t n = 1; n <= std::max(1u, std::thread::hardware_concurrency());
+         ++n)
+      opt.threads.push_back(n);
+  // Speedups are relative to one producer
+  std::sort(opt.threads.begin(), opt.threads.end());
+  opt.threads.erase(std::unique(opt.threads.begin(), opt.threads.end()),
+                    opt.threads.end());
+  if (opt.threads.front() != 1) opt.threads.insert(opt.threads.begin(), 1);
+  return opt;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    Options opt = parseArguments(argc, argv);
+    ConfigSpec config = parseConfigFile(opt.config);
+    std::vector<fs::path> paths;
+    for (const auto& entry : fs::directory_iterator(opt.images))
+      if (entry.is_regular_file()) paths.push_back(entry.path());
+    std::sort(paths.begin(), paths.end());
+    fs::path out_dir = fs::temp_directory_path() / "augmento-scaling";
+
+    std::vector<Curve> curves;
+    for (size_t writers : opt.writers) {
+      Curve curve;
+      curve.writers = writers;
+      for (size_t threads : opt.threads) {
+        std::cout << "[INFO] " << threads << " producer(s), " << writers
+                  << " writer(s)..." << std::endl;
+        curve.points.push_back(
+            measure(paths, config, opt, threads, writers, out_dir));
+      }
+      curves.push_back(std::move(curve));
+    }
+    fs::remove_all(out_dir);
+    for (Curve& c : curves) fit(c, opt.knee);
+
+    writeText(std::cout, curves, opt);
+    std::ofstream out(opt.out);
+    if (!out) throw std::runtime_error("could not open " + opt.out);
+    writeJson(out, curves, opt);
+    std::cout << "[INFO] Wrote results to " << opt.out << "\n";
+    return 0;
+  } catch (const std::exception& e) {
+    std::cout << "[ERROR] " << e.what() << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,231 @@
+/**
+ * @name stats.hpp
+ * @brief Small statistics helpers shared by the benchmark runners
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * Distribution-free comparison of two samples: the Mann-Whitney U test for
+ * whether one tends to be larger, and the Hodges-Lehmann estimate of their
+ * ratio with a matching confidence interval. Benchmark timings are skewed and
+ * few, so neither assumes normality. Also fits Amdahl's law and the Universal
+ * Scalability Law to measured speedups.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace stats {
+
+/// @return Median of a sample (0 when empty).
+inline double median(std::vector<double> v) {
+  if (v.empty()) return 0.0;
+  std::sort(v.begin(), v.end());
+  size_t n = v.size();
+  return n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+/// @return Arithmetic mean (0 when empty).
+inline double mean(const std::vector<double>& v) {
+  double sum = 0;
+  for (double x : v) sum += x;
+  return v.empty() ? 0.0 : sum / v.size();
+}
+
+/// @return Sample standard deviation (0 for fewer than two values).
+inline double stddev(const std::vector<double>& v) {
+  if (v.size() < 2) return 0.0;
+  double m = mean(v), acc = 0;
+  for (double x : v) acc += (x - m) * (x - m);
+  return std::sqrt(acc / (v.size() - 1));
+}
+
+/// @return Two-sided standard normal quantile for a confidence level.
+inline double zFor(double confidence) {
+  // Abramowitz & Stegun 26.2.23, accurate to about 4.5e-4
+  double p = 0.5 + confidence / 2;
+  double q = std::sqrt(-2 * std::log(1 - p));
+  return q - (2.515517 + 0.802853 * q + 0.010328 * q * q) /
+                 (1 + 1.432788 * q + 0.189269 * q * q + 0.001308 * q * q * q);
+}
+
+/**
+ * @brief Two-sided Mann-Whitney U test with tie and continuity correction.
+ * @param a First sample.
+ * @param b Second sample.
+ * @return Approximate p-value of "a and b come from the same distribution"
+ * (1 when either sample is empty).
+ */
+inline double mannWhitneyP(const std::vector<double>& a,
+                           const std::vector<double>& b) {
+  size_t m = a.size(), n = b.size();
+  if (!m || !n) return 1.0;
+  std::vector<std::pair<double, int>> all;
+  for (double x : a) all.emplace_back(x, 0);
+  for (double x : b) all.emplace_back(x, 1);
+  std::sort(all.begin(), all.end());
+
+  // Average ranks over ties
+  double rank_a = 0, tie_term = 0;
+  for (size_t i = 0; i < all.size();) {
+    size_t j = i;
+    while (j < all.size() && all[j].first == all[i].first) ++j;
+    double rank = 0.5 * (i + 1 + j);
+    for (size_t k = i; k < j; ++k)
+      if (all[k].second == 0) rank_a += rank;
+    double t = static_cast<double>(j - i);
+    tie_term += t * t * t - t;
+    i = j;
+  }
+  double u = rank_a - m * (m + 1) / 2.0;
+  double mu = m * n / 2.0;
+  double N = static_cast<double>(m + n);
+  double var = m * n / 12.0 * ((N + 1) - tie_term / (N * (N - 1)));
+  if (var <= 0) return 1.0;
+  double z = (std::fabs(u - mu) - 0.5) / std::sqrt(var);
+  return std::erfc(std::max(0.0, z) / std::sqrt(2.0));
+}
+
+/**
+ * @brief Hodges-Lehmann estimate of a / b with a distribution-free
+ * confidence interval.
+ */
+struct RatioEstimate {
+  double ratio = 1.0;  ///< Median of all pairwise ratios.
+  double lower = 1.0;  ///< Lower confidence bound.
+  double upper = 1.0;  ///< Upper confidence bound.
+};
+
+/**
+ * @brief Estimate how much larger a is than b.
+ * @param a Sample (e.g. current timings), all values positive.
+ * @param b Sample (e.g. baseline timings), all values positive.
+ * @param confidence Confidence level of the interval (e.g. 0.95).
+ */
+inline RatioEstimate ratioEstimate(const std::vector<double>& a,
+                                   const std::vector<double>& b,
+                                   double confidence = 0.95) {
+  RatioEstimate est;
+  std::vector<double> d;
+  for (double x : a)
+    for (double y : b)
+      if (x > 0 && y > 0) d.push_back(std::log(x / y));
+  if (d.empty()) return est;
+  std::sort(d.begin(), d.end());
+  double mn = static_cast<double>(d.size());
+  double m = static_cast<double>(a.size()), n = static_cast<double>(b.size());
+  double k = std::floor(mn / 2 - zFor(confidence) *
+                                      std::sqrt(m * n * (m + n + 1) / 12));
+  size_t lo = k > 0 ? static_cast<size_t>(k) : 0;
+  size_t hi = d.size() - 1 - std::min(lo, d.size() - 1);
+  est.ratio = std::exp(median(d));
+  est.lower = std::exp(d[std::min(lo, hi)]);
+  est.upper = std::exp(d[hi]);
+  return est;
+}
+
+/**
+ * @brief Amdahl's law S(n) = 1 / (s + (1 - s) / n) fitted to speedups.
+ */
+struct AmdahlFit {
+  double serial = 0.0;  ///< Serial fraction s in [0, 1].
+  double rmse = 0.0;    ///< Root-mean-square error of the fitted speedup.
+
+  /// @return Predicted speedup on n threads.
+  double speedup(double n) const { return 1.0 / (serial + (1 - serial) / n); }
+};
+
+/**
+ * @brief Universal Scalability Law S(n) = n / (1 + sigma (n - 1) +
+ * kappa n (n - 1)) fitted to speedups.
+ */
+struct UslFit {
+  double sigma = 0.0;  ///< Contention (serialisation) coefficient.
+  double kappa = 0.0;  ///< Coherency (crosstalk) coefficient.
+  double rmse = 0.0;   ///< Root-mean-square error of the fitted speedup.
+
+  /// @return Predicted speedup on n threads.
+  double speedup(double n) const {
+    return n / (1 + sigma * (n - 1) + kappa * n * (n - 1));
+  }
+
+  /// @return Thread count of maximum throughput (infinite when kappa is 0).
+  double peak() const {
+    return kappa > 0 ? std::sqrt(std::max(0.0, 1 - sigma) / kappa)
+                     : INFINITY;
+  }
+};
+
+/// @return Root-mean-square error of a model against measured speedups.
+template <typename Model>
+double speedupRmse(const Model& model, const std::vector<double>& n,
+                   const std::vector<double>& speedup) {
+  double acc = 0;
+  for (size_t i = 0; i < n.size(); ++i) {
+    double e = model.speedup(n[i]) - speedup[i];
+    acc += e * e;
+  }
+  return n.empty() ? 0.0 : std::sqrt(acc / n.size());
+}
+
+/**
+ * @brief Least-squares Amdahl fit.
+ * @param n Thread counts.
+ * @param speedup Measured speedup at each thread count (1 at n = 1).
+ */
+inline AmdahlFit fitAmdahl(const std::vector<double>& n,
+                           const std::vector<double>& speedup) {
+  // One bounded parameter: a fine grid is exact enough and cannot diverge
+  AmdahlFit best;
+  best.rmse = INFINITY;
+  for (int i = 0; i <= 10000; ++i) {
+    AmdahlFit fit;
+    fit.serial = i / 10000.0;
+    fit.rmse = speedupRmse(fit, n, speedup);
+    if (fit.rmse < best.rmse) best = fit;
+  }
+  return best;
+}
+
+/**
+ * @brief Least-squares USL fit on the linearised form
+ * n / S(n) - 1 = sigma (n - 1) + kappa n (n - 1), with both coefficients
+ * constrained to be non-negative.
+ * @param n Thread counts.
+ * @param speedup Measured speedup at each thread count (1 at n = 1).
+ */
+inline UslFit fitUsl(const std::vector<double>& n,
+                     const std::vector<double>& speedup) {
+  double s11 = 0, s12 = 0, s22 = 0, b1 = 0, b2 = 0;
+  for (size_t i = 0; i < n.size(); ++i) {
+    if (speedup[i] <= 0) continue;
+    double x1 = n[i] - 1, x2 = n[i] * (n[i] - 1);
+    double y = n[i] / speedup[i] - 1;
+    s11 += x1 * x1;
+    s12 += x1 * x2;
+    s22 += x2 * x2;
+    b1 += x1 * y;
+    b2 += x2 * y;
+  }
+  UslFit fit;
+  double det = s11 * s22 - s12 * s12;
+  if (det > 0) {
+    fit.sigma = (b1 * s22 - b2 * s12) / det;
+    fit.kappa = (s11 * b2 - s12 * b1) / det;
+  }
+  // Refit one coefficient when the other would be negative
+  if (fit.kappa < 0 || det <= 0) {
+    fit.kappa = 0;
+    fit.sigma = s11 > 0 ? b1 / s11 : 0;
+  }
+  if (fit.sigma < 0) {
+    fit.sigma = 0;
+    fit.kappa = s22 > 0 ? std::max(0.0, b2 / s22) : 0;
+  }
+  fit.rmse = speedupRmse(fit, n, speedup);
+  return fit;
+}
+
+}  // namespace stats
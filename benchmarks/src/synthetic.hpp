@@ -0,0 +1,206 @@
+/**
+ * @name synthetic.hpp
+ * @brief Deterministic synthetic image corpora for the benchmark runners
+ * @author Emmanuel Butsana
+ * @date October 17, 2026
+ *
+ * Generates datasets whose content has photograph-like entropy: anti-aliased
+ * shapes with hard edges, several octaves of value noise as surface texture
+ * and fine sensor noise. Flat or purely random images make codecs far
+ * cheaper or far more expensive than real photos. Every file is generated
+ * from its own generator seeded by (seed, index), so a corpus is identical
+ * for identical settings regardless of file count or generation order.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../include/splitmix.hpp"
+
+namespace synth {
+
+/**
+ * @brief One entry of a resolution distribution.
+ */
+struct SizeChoice {
+  int width = 1280;     ///< Width in pixels.
+  int height = 960;     ///< Height in pixels.
+  double weight = 1.0;  ///< Relative frequency.
+};
+
+/**
+ * @brief Settings of a generated corpus.
+ */
+struct DatasetSpec {
+  size_t count = 24;                          ///< Number of files.
+  std::vector<SizeChoice> sizes = {{}};       ///< Resolution distribution.
+  double jitter = 0.0;  ///< Random per-image scale of each side, +/- share.
+  std::vector<std::pair<std::string, double>> formats = {{"jpg", 1.0}};
+  std::vector<std::pair<int, double>> channels = {{3, 1.0}};  ///< 1, 3 or 4.
+  int depth = 8;        ///< Bits per sample: 8 or 16 (PNG and TIFF only).
+  int quality = 90;     ///< JPEG and WebP quality.
+  uint64_t seed = 671;  ///< Corpus seed.
+  std::string prefix = "synthetic";  ///< File name prefix.
+};
+
+/**
+ * @brief Description of one generated file.
+ */
+struct FileInfo {
+  std::filesystem::path path;
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+  int depth = 8;
+  std::string format;
+  uint64_t bytes = 0;
+};
+
+/// @return Well-mixed 64-bit seed for file @p index of a corpus.
+inline uint64_t fileSeed(uint64_t seed, uint64_t index) {
+  uint64_t z = splitmix64(seed + 0x9E3779B97F4A7C15ull * index);
+  return z ? z : 1;
+}
+
+/// @return Index drawn from a list of (value, weight) pairs.
+template <typename Entry, typename Weight>
+size_t pick(const std::vector<Entry>& entries, Weight weight, cv::RNG& rng) {
+  double total = 0;
+  for (const Entry& e : entries) total += weight(e);
+  double x = rng.uniform(0.0, total);
+  for (size_t i = 0; i < entries.size(); ++i) {
+    x -= weight(entries[i]);
+    if (x < 0) return i;
+  }
+  return entries.size() - 1;
+}
+
+/**
+ * @brief Textured synthetic image.
+ * @param width Width in pixels.
+ * @param height Height in pixels.
+ * @param channels 1, 3 or 4.
+ * @param depth 8 or 16 bits per sample.
+ * @param rng Generator; advanced by the call.
+ */
+inline cv::Mat texture(int width, int height, int channels, int depth,
+                       cv::RNG& rng) {
+  const int type = CV_32FC(channels);
+  cv::Mat acc(height, width, type);
+
+  // Low-frequency background
+  cv::Mat grid(3, 3, type);
+  rng.fill(grid, cv::RNG::UNIFORM, -0.5, 0.5);
+  cv::resize(grid, acc, acc.size(), 0, 0, cv::INTER_CUBIC);
+
+  // Opaque objects give the sharp edges real scenes have
+  int objects = 16 + rng.uniform(0, 32);
+  for (int i = 0; i < objects; ++i) {
+    cv::Scalar colour;
+    for (int c = 0; c < 4; ++c) colour[c] = rng.uniform(-0.8, 0.8);
+    cv::Point centre(rng.uniform(0, width), rng.uniform(0, height));
+    int radius = std::max(2, rng.uniform(width / 64 + 1, width / 6 + 2));
+    switch (rng.uniform(0, 3)) {
+      case 0:
+        cv::ellipse(acc, centre, cv::Size(radius, radius / 2 + 1),
+                    rng.uniform(0.0, 180.0), 0, 360, colour, cv::FILLED,
+                    cv::LINE_AA);
+        break;
+      case 1:
+        cv::rectangle(acc, centre, centre + cv::Point(radius, radius * 2 / 3),
+                      colour, cv::FILLED, cv::LINE_AA);
+        break;
+      default:
+        cv::line(acc, centre,
+                 cv::Point(rng.uniform(0, width), rng.uniform(0, height)),
+                 colour, 1 + radius / 16, cv::LINE_AA);
+    }
+  }
+
+  // Surface texture: value noise from coarse to fine, halving in amplitude
+  double amplitude = 0.25;
+  for (int cell = 128; cell >= 2; cell /= 4, amplitude *= 0.5) {
+    cv::Mat octave(height / cell + 2, width / cell + 2, type), up;
+    rng.fill(octave, cv::RNG::UNIFORM, -amplitude, amplitude);
+    cv::resize(octave, up, acc.size(), 0, 0, cv::INTER_CUBIC);
+    acc += up;
+  }
+
+  // Sensor noise
+  cv::Mat noise(height, width, type);
+  rng.fill(noise, cv::RNG::NORMAL, 0, 0.02);
+  acc += noise;
+
+  double max_value = depth == 16 ? 65535.0 : 255.0;
+  cv::Mat img;
+  acc.convertTo(img, depth == 16 ? CV_16UC(channels) : CV_8UC(channels),
+                max_value / 2, max_value / 2);
+  return img;
+}
+
+/**
+ * @brief Generate a corpus into a directory.
+ * @param spec Corpus settings.
+ * @param dir Output directory (created if missing).
+ * @return One entry per file, in index order.
+ * @throws std::runtime_error if a file cannot be written.
+ *
+ * JPEG and WebP have no 16-bit mode and JPEG has no alpha: such files are
+ * written with 8 bits and 3 channels respectively, as recorded in the result.
+ */
+inline std::vector<FileInfo> generate(const DatasetSpec& spec,
+                                      const std::filesystem::path& dir) {
+  std::filesystem::create_directories(dir);
+  std::vector<FileInfo> files;
+  for (size_t i = 0; i < spec.count; ++i) {
+    cv::RNG rng(fileSeed(spec.seed, i));
+    const SizeChoice& size =
+        spec.sizes[pick(spec.sizes, [](const SizeChoice& s) { return s.weight; },
+                        rng)];
+    FileInfo info;
+    info.format = spec.formats[pick(spec.formats,
+                                    [](const auto& f) { return f.second; },
+                                    rng)].first;
+    info.channels = spec.channels[pick(spec.channels,
+                                       [](const auto& c) { return c.second; },
+                                       rng)].first;
+    double sx = 1 + rng.uniform(-spec.jitter, spec.jitter);
+    double sy = 1 + rng.uniform(-spec.jitter, spec.jitter);
+    // Even sides keep chroma-subsampled codecs on their fast path
+    info.width = std::max(2, static_cast<int>(size.width * sx) & ~1);
+    info.height = std::max(2, static_cast<int>(size.height * sy) & ~1);
+
+    bool lossy = info.format == "jpg" || info.format == "webp";
+    info.depth = lossy ? 8 : spec.depth;
+    if (info.format == "jpg" && info.channels == 4) info.channels = 3;
+
+    std::vector<int> params;
+    if (info.format == "jpg")
+      params = {cv::IMWRITE_JPEG_QUALITY, spec.quality};
+    else if (info.format == "webp")
+      params = {cv::IMWRITE_WEBP_QUALITY, spec.quality};
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "_%05zu.", i);
+    info.path = dir / (spec.prefix + name + info.format);
+    cv::Mat img =
+        texture(info.width, info.height, info.channels, info.depth, rng);
+    if (!cv::imwrite(info.path.string(), img, params))
+      throw std::runtime_error("could not write " + info.path.string());
+    info.bytes = std::filesystem::file_size(info.path);
+    files.push_back(std::move(info));
+  }
+  return files;
+}
+
+}  // namespace synth
@@ -0,0 +1,108 @@
+/**
+ * @file advisor.hpp
+ * @brief Run-end bottleneck diagnosis and configuration advice.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * The advisor reads the merged stage times of a finished run together with
+ * the blocking statistics of both queues. It decides which part of the
+ * pipeline limited throughput (reading, decoding, augmenting, encoding,
+ * writing, or the feeder filling the path queue) and turns the same numbers
+ * into concrete values for num_threads, num_writers, queue_capacity and the
+ * output format.
+ */
+
+#pragma once
+
+#include <array>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "json_writer.hpp"
+#include "profiler.hpp"
+#include "queue_monitor.hpp"
+
+/**
+ * @brief What limited the throughput of a run.
+ */
+enum class Bottleneck {
+  Decode,   ///< Producers spent most of their time decoding.
+  Augment,  ///< Producers spent most of their time in the pipeline.
+  Encode,   ///< The writer spent most of its time encoding.
+  Io,       ///< Reading or writing files dominated.
+  Feeder,   ///< Producers waited for paths to be queued.
+  Unknown   ///< Too little work was done to tell.
+};
+
+/**
+ * @brief Lower-case display name of a bottleneck ("decode-bound", ...).
+ */
+const char* bottleneckName(Bottleneck bottleneck);
+
+/**
+ * @brief Settings the run was executed with.
+ */
+struct RunShape {
+  size_t producers = 1;         ///< Producer threads (num_threads).
+  size_t writers = 1;           ///< Consumer threads (num_writers).
+  size_t queue_capacity = 128;  ///< Image queue capacity.
+  size_t hardware_threads = 1;  ///< Hardware threads of the host.
+  std::string output_ext = ".jpg";  ///< Output format extension.
+};
+
+/**
+ * @brief One suggested change to the configuration.
+ */
+struct Recommendation {
+  std::string setting;    ///< Setting name ("num_threads", ...).
+  std::string current;    ///< Value used by the run.
+  std::string suggested;  ///< Value to try next.
+  std::string reason;     ///< One-line justification.
+};
+
+/**
+ * @brief Outcome of diagnoseRun().
+ */
+struct Diagnosis {
+  Bottleneck bottleneck = Bottleneck::Unknown;  ///< Limiting part.
+  std::string detail;  ///< One sentence explaining the classification.
+  double producer_utilisation = 0.0;  ///< Producer busy share of wall time.
+  double writer_utilisation = 0.0;    ///< Writer busy share of wall time.
+  std::array<double, kStageCount> stage_share{};  ///< Share of busy time.
+  double producers_starved = 0.0;  ///< Producer time blocked on paths.
+  double producers_blocked = 0.0;  ///< Producer time blocked on images.
+  double writer_starved = 0.0;     ///< Writer time blocked on images.
+  std::vector<size_t> top_ops;     ///< Costliest operations, slowest first.
+  std::vector<Recommendation> recommendations;  ///< Suggested changes.
+};
+
+/**
+ * @brief Classify a finished run and derive recommendations.
+ * @param profile Merged run profile (wall time and stage histograms).
+ * @param queues Reports for the path queue and the image queue, in that
+ * order (see ThreadController::queueReports()).
+ * @param shape Settings of the run.
+ * @return Diagnosis; Bottleneck::Unknown when no image completed.
+ */
+Diagnosis diagnoseRun(const RunProfile& profile,
+                      const std::vector<QueueReport>& queues,
+                      const RunShape& shape);
+
+/**
+ * @brief Write the diagnosis and recommendations as human-readable text.
+ * @param out Output stream.
+ * @param diagnosis Result of diagnoseRun().
+ * @param opLabels Operation names, in pipeline order.
+ */
+void writeAdviceText(std::ostream& out, const Diagnosis& diagnosis,
+                     const std::vector<std::string>& opLabels);
+
+/**
+ * @brief Write the diagnosis and recommendations as a JSON object.
+ * @param json Writer positioned where a value is expected.
+ * @param diagnosis Result of diagnoseRun().
+ * @param opLabels Operation names, in pipeline order.
+ */
+void writeAdviceJson(JsonWriter& json, const Diagnosis& diagnosis,
+                     const std::vector<std::string>& opLabels);
@@ -0,0 +1,237 @@
+/**
+ * @file augmenter.hpp
+ * @brief In-memory augmentation API of libaugmento.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * Augmenter is the entry point for embedding augmento in another process,
+ * such as a training service. It owns a persistent pool of worker threads
+ * that share one Pipeline, accepts batches of decoded cv::Mat images,
+ * encoded bytes or file paths, and hands the augmented batch back through a
+ * future or a callback, or writes it straight into a BatchCollator's tensor.
+ * Only submitFiles() touches the filesystem (reading, on the workers), and
+ * no thread is created per call.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "multithread.hpp"
+#include "pipeline.hpp"
+#include "profiler.hpp"
+#include "progress.hpp"
+#include "tensor.hpp"
+
+/**
+ * @brief Result of one submitted batch.
+ */
+struct AugmentedBatch {
+  std::vector<cv::Mat> images;  ///< In submission order; empty if failed.
+  std::vector<std::vector<uchar>> encoded;  ///< With BatchOptions::encode.
+  std::vector<std::vector<std::string>> histories;  ///< Applied operations.
+  size_t failures = 0;          ///< Images that could not be augmented.
+};
+
+/**
+ * @brief Optional per-batch settings.
+ */
+struct BatchOptions {
+  /// Pipeline to apply instead of the Augmenter's own; must outlive the
+  /// batch. Its per-operation latencies are not profiled.
+  const Pipeline* pipeline = nullptr;
+  /// One seed per image for reproducible results: image i draws from an
+  /// engine seeded with seeds[i] only. Empty: seeded as in the CLI.
+  std::vector<uint64_t> seeds;
+  /// Encode results with this codec (e.g. ".jpg") into
+  /// AugmentedBatch::encoded instead of returning images.
+  std::string encode;
+};
+
+/**
+ * @class Augmenter
+ * @brief Thread-safe, persistent augmentation pool working in memory.
+ *
+ * Every image of a batch is a separate task on the shared queue, so one
+ * batch is spread over all workers and several callers may submit at once.
+ * Submitting blocks while the queue holds queueCapacity pending images.
+ * Callbacks run on the worker that finishes a batch's last image; they must
+ * not submit to the same Augmenter, which could block that worker forever.
+ * The destructor finishes every batch already submitted.
+ */
+class Augmenter {
+ public:
+  /// Callback receiving a finished batch.
+  using Callback = std::function<void(AugmentedBatch&&)>;
+
+  /**
+   * @brief Start the worker pool.
+   * @param pipeline Pipeline applied to every image (owned by the Augmenter).
+   * @param numWorkers Worker threads (at least 1).
+   * @param queueCapacity Pending images accepted before submit blocks.
+   */
+  explicit Augmenter(Pipeline pipeline,
+                     size_t numWorkers = std::thread::hardware_concurrency(),
+                     size_t queueCapacity = 128);
+
+  /// @brief Finish pending batches and join the workers.
+  ~Augmenter();
+
+  Augmenter(const Augmenter&) = delete;
+  Augmenter& operator=(const Augmenter&) = delete;
+
+  /**
+   * @brief Augment decoded images; the inputs are copied, not modified.
+   * @param batch Images to augment.
+   * @return Future of the augmented batch.
+   */
+  std::future<AugmentedBatch> submit(std::vector<cv::Mat> batch);
+
+  /**
+   * @brief Augment decoded images, reporting through a callback.
+   * @param batch Images to augment.
+   * @param done Called once with the augmented batch.
+   */
+  void submit(std::vector<cv::Mat> batch, Callback done);
+
+  /**
+   * @brief Decode and augment encoded images (any format OpenCV reads).
+   * @param batch Encoded images.
+   * @return Future of the augmented batch.
+   */
+  std::future<AugmentedBatch> submitEncoded(
+      std::vector<std::vector<uchar>> batch);
+
+  /**
+   * @brief Decode and augment encoded images, reporting through a callback.
+   * @param batch Encoded images.
+   * @param done Called once with the augmented batch.
+   */
+  void submitEncoded(std::vector<std::vector<uchar>> batch, Callback done);
+
+  /**
+   * @brief Augment decoded images with per-batch settings.
+   * @param batch Images to augment; several may share the same pixels.
+   * @param options Pipeline, seeds and output encoding of this batch.
+   * @param done Called once with the augmented batch.
+   */
+  void submit(std::vector<cv::Mat> batch, BatchOptions options,
+              Callback done);
+
+  /**
+   * @brief Decode and augment encoded images with per-batch settings.
+   * @param batch Encoded images.
+   * @param options Pipeline, seeds and output encoding of this batch.
+   * @param done Called once with the augmented batch.
+   */
+  void submitEncoded(std::vector<std::vector<uchar>> batch,
+                     BatchOptions options, Callback done);
+
+  /**
+   * @brief Read, decode and augment image files on the workers, so the
+   * caller never waits on the disk.
+   * @param paths Image files; unreadable ones count as failures.
+   * @param options Pipeline, seeds and output encoding of this batch.
+   * @param done Called once with the augmented batch.
+   */
+  void submitFiles(std::vector<std::string> paths, BatchOptions options,
+                   Callback done);
+
+  /**
+   * @brief Augment decoded images straight into a batch tensor.
+   *
+   * Image i lands in slot i of `into`; the returned batch carries the
+   * histories and failure count but no images. `into` must outlive the
+   * future and must not be released before the future is ready.
+   * @param batch Images to augment (at most into.batchSize()).
+   * @param into Collator receiving the augmented images.
+   * @return Future of the batch's histories and failures.
+   */
+  std::future<AugmentedBatch> submit(std::vector<cv::Mat> batch,
+                                     BatchCollator& into);
+
+  /**
+   * @brief Decode and augment encoded images straight into a batch tensor.
+   * @param batch Encoded images (at most into.batchSize()).
+   * @param into Collator receiving the augmented images (see above).
+   * @return Future of the batch's histories and failures.
+   */
+  std::future<AugmentedBatch> submitEncoded(
+      std::vector<std::vector<uchar>> batch, BatchCollator& into);
+
+  /// @return Number of worker threads.
+  size_t workers() const;
+
+  /**
+   * @brief Counters of all work done so far (safe to call at any time).
+   * @return Completed and failed images, bytes and busy time per stage.
+   */
+  ProgressSnapshot snapshot() const;
+
+ private:
+  /// Shared state of one submitted batch.
+  struct Batch {
+    AugmentedBatch result;
+    std::atomic<size_t> remaining{0};
+    std::atomic<size_t> failures{0};
+    Callback done;
+    BatchOptions options;               ///< Per-batch settings.
+    BatchCollator* collator = nullptr;  ///< Destination tensor, if any.
+  };
+
+  /// One image of a batch, decoded, still encoded or still on disk.
+  struct Task {
+    std::shared_ptr<Batch> batch;
+    size_t index = 0;
+    cv::Mat image;
+    std::vector<uchar> encoded;
+    std::string path;  ///< Read into `encoded` by the worker.
+    uint64_t arrival_ns = 0;
+  };
+
+  /**
+   * @brief Queue one task per image; exactly one of the batches is used.
+   * @param images Decoded images.
+   * @param encoded Encoded images.
+   * @param paths Image files.
+   * @param done Completion callback.
+   * @param options Per-batch settings.
+   * @param collator Destination tensor, or nullptr.
+   */
+  void enqueue(std::vector<cv::Mat> images,
+               std::vector<std::vector<uchar>> encoded,
+               std::vector<std::string> paths, Callback done,
+               BatchOptions options, BatchCollator* collator);
+
+  /**
+   * @brief Worker loop: augment queued tasks until the queue is closed.
+   * @param profile Profile of this worker.
+   */
+  void work(ThreadProfile& profile);
+
+  /**
+   * @brief Augment one task and store it in its batch.
+   * @param task Task to process.
+   * @param profile Profile of the calling worker.
+   */
+  void process(Task& task, ThreadProfile& profile);
+
+  /**
+   * @brief Clear a task's output slot and count it as failed.
+   * @param task Task that failed.
+   * @param profile Profile of the calling worker.
+   * @param reason Logged cause of the failure.
+   */
+  void fail(Task& task, ThreadProfile& profile, const char* reason);
+
+  Pipeline pipeline_;                   ///< Shared augmentation pipeline.
+  SafeQueue<Task> tasks_;               ///< Pending images.
+  std::vector<ThreadProfile> profiles_; ///< Per-worker profiles.
+  std::vector<std::thread> workers_;    ///< Persistent worker threads.
+};
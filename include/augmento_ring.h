@@ -0,0 +1,211 @@
+/**
+ * @file augmento_ring.h
+ * @brief Shared-memory batch ring of `augmento --serve-shm`: layout and a
+ * header-only C reader.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * The producer (augmento) creates a POSIX shared-memory object holding an
+ * augmento_ring_header followed by slot_count slots. Each slot is a 64-byte
+ * augmento_slot_header followed by one fixed-shape batch tensor. The ring is
+ * single-producer, single-consumer: `head` counts published batches and
+ * `tail` counts batches the consumer has released. Both are 32-bit futex
+ * words, so either side sleeps in the kernel while the other is behind. The
+ * producer blocks when all slots are unreleased (backpressure), and the
+ * consumer reads tensors in place, without copies or sockets.
+ *
+ * Consumer usage (Linux; include before other system headers or compile with
+ * -D_GNU_SOURCE, and link with -lrt on older glibc):
+ *
+ *   augmento_ring ring;
+ *   if (augmento_ring_open(&ring, "/augmento") != 0) ...;
+ *   const augmento_slot_header* info;
+ *   const void* batch;
+ *   while ((batch = augmento_ring_next(&ring, &info, -1)) != NULL) {
+ *     // info->images tensors of ring.header->height x width x channels
+ *     augmento_ring_release(&ring);
+ *   }
+ *   augmento_ring_close(&ring);
+ */
+
+#ifndef AUGMENTO_RING_H
+#define AUGMENTO_RING_H
+
+/* syscall() is not declared in strict ISO C modes otherwise */
+#if !defined(_GNU_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUGMENTO_RING_MAGIC 0x474e4952474d5541ULL /* "AUGMRING" */
+#define AUGMENTO_RING_VERSION 2u
+
+/* Tensor layouts (augmento_ring_header.layout) */
+#define AUGMENTO_RING_NHWC 0u
+#define AUGMENTO_RING_NCHW 1u
+
+/* Bytes reserved for the header at the start of every slot */
+#define AUGMENTO_RING_SLOT_HEADER 64u
+
+/* Longest single futex sleep, so closing and timeouts are noticed */
+#define AUGMENTO_RING_POLL_MS 100
+
+typedef struct augmento_ring_header {
+  uint64_t magic;        /* AUGMENTO_RING_MAGIC once initialised */
+  uint32_t version;      /* AUGMENTO_RING_VERSION */
+  uint32_t slot_count;   /* Batches the ring holds */
+  uint64_t data_offset;  /* Offset of slot 0 from the header */
+  uint64_t slot_stride;  /* Bytes between two slots */
+  uint64_t batch_bytes;  /* Tensor bytes of one slot */
+  uint32_t batch;        /* Images per batch (N) */
+  uint32_t height;       /* H */
+  uint32_t width;        /* W */
+  uint32_t channels;     /* C */
+  uint8_t dtype_code;    /* DLPack type code: 0 int, 1 uint, 2 float */
+  uint8_t dtype_bits;    /* Bits per element */
+  uint16_t layout;       /* AUGMENTO_RING_NHWC or AUGMENTO_RING_NCHW */
+  uint32_t closed;       /* Non-zero once the producer has finished */
+  uint32_t producer;     /* Process id of the producer */
+  uint32_t head __attribute__((aligned(64)));  /* Batches published */
+  uint32_t tail __attribute__((aligned(64)));  /* Batches released */
+} __attribute__((aligned(64))) augmento_ring_header;
+
+typedef struct augmento_slot_header {
+  uint64_t sequence;  /* Batch number since the ring was created */
+  uint64_t epoch;     /* Pass over the dataset the batch belongs to */
+  uint32_t images;    /* Valid images at the start of the tensor */
+  uint32_t failures;  /* Of those, images that failed and are zeroed */
+} augmento_slot_header;
+
+typedef struct augmento_ring {
+  augmento_ring_header* header;  /* Start of the mapping */
+  size_t size;                   /* Bytes mapped */
+} augmento_ring;
+
+/* Sleep while *addr == expected, for at most timeout_ms */
+static inline void augmento_ring_futex_wait(uint32_t* addr, uint32_t expected,
+                                            int timeout_ms) {
+  struct timespec ts;
+  ts.tv_sec = timeout_ms / 1000;
+  ts.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+  syscall(SYS_futex, addr, FUTEX_WAIT, expected, &ts, NULL, 0);
+}
+
+/* Wake every process sleeping on addr */
+static inline void augmento_ring_futex_wake(uint32_t* addr) {
+  syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+static inline augmento_slot_header* augmento_ring_slot(
+    const augmento_ring_header* header, uint32_t sequence) {
+  return (augmento_slot_header*)((char*)header + header->data_offset +
+                                 (uint64_t)(sequence % header->slot_count) *
+                                     header->slot_stride);
+}
+
+/*
+ * Map the ring published under `name` (e.g. "/augmento").
+ * Returns 0, -EAGAIN if the producer has not finished creating it yet,
+ * -EPROTO on a layout mismatch, or another negative errno.
+ */
+static inline int augmento_ring_open(augmento_ring* ring, const char* name) {
+  struct stat st;
+  void* base;
+  int err;
+  int fd = shm_open(name, O_RDWR, 0);
+  if (fd < 0) return -errno;
+  if (fstat(fd, &st) != 0) {
+    err = errno;
+    close(fd);
+    return -err;
+  }
+  if ((size_t)st.st_size < sizeof(augmento_ring_header)) {
+    close(fd);
+    return -EAGAIN;
+  }
+  base = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+              fd, 0);
+  err = errno;
+  close(fd);
+  if (base == MAP_FAILED) return -err;
+  ring->header = (augmento_ring_header*)base;
+  ring->size = (size_t)st.st_size;
+  err = 0;
+  if (__atomic_load_n(&ring->header->magic, __ATOMIC_ACQUIRE) !=
+      AUGMENTO_RING_MAGIC)
+    err = -EAGAIN;
+  else if (ring->header->version != AUGMENTO_RING_VERSION ||
+           ring->header->data_offset +
+                   (uint64_t)ring->header->slot_count *
+                       ring->header->slot_stride >
+               ring->size)
+    err = -EPROTO;
+  if (err) {
+    munmap(base, ring->size);
+    ring->header = NULL;
+  }
+  return err;
+}
+
+/*
+ * Wait for the next batch and return its tensor, valid until
+ * augmento_ring_release(). Returns NULL once the producer has closed the
+ * ring and every batch was consumed, or when timeout_ms (>= 0) elapses.
+ */
+static inline const void* augmento_ring_next(
+    augmento_ring* ring, const augmento_slot_header** info, int timeout_ms) {
+  augmento_ring_header* h = ring->header;
+  uint32_t tail = __atomic_load_n(&h->tail, __ATOMIC_RELAXED);
+  int waited_ms = 0;
+  for (;;) {
+    uint32_t head = __atomic_load_n(&h->head, __ATOMIC_ACQUIRE);
+    if (head != tail) break;
+    if (__atomic_load_n(&h->closed, __ATOMIC_ACQUIRE)) {
+      /* Recheck: a last batch may have been published before closing */
+      if (__atomic_load_n(&h->head, __ATOMIC_ACQUIRE) != tail) break;
+      return NULL;
+    }
+    if (timeout_ms >= 0 && waited_ms >= timeout_ms) return NULL;
+    augmento_ring_futex_wait(&h->head, head, AUGMENTO_RING_POLL_MS);
+    waited_ms += AUGMENTO_RING_POLL_MS;
+  }
+  augmento_slot_header* slot = augmento_ring_slot(h, tail);
+  if (info) *info = slot;
+  return (const char*)slot + AUGMENTO_RING_SLOT_HEADER;
+}
+
+/* Hand the batch returned by augmento_ring_next() back to the producer */
+static inline void augmento_ring_release(augmento_ring* ring) {
+  augmento_ring_header* h = ring->header;
+  uint32_t tail = __atomic_load_n(&h->tail, __ATOMIC_RELAXED);
+  __atomic_store_n(&h->tail, tail + 1, __ATOMIC_RELEASE);
+  augmento_ring_futex_wake(&h->tail);
+}
+
+/* Unmap the ring */
+static inline void augmento_ring_close(augmento_ring* ring) {
+  if (ring->header) munmap(ring->header, ring->size);
+  ring->header = NULL;
+  ring->size = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUGMENTO_RING_H */
@@ -0,0 +1,109 @@
+/**
+ * @file estimator.hpp
+ * @brief Dry-run cost estimate of a full augmentation job.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * A dry run reads, decodes, augments and encodes a small random sample of
+ * the inputs on the calling thread, entirely in memory. The per-task costs
+ * measured there are extrapolated to the whole job: wall time for the
+ * configured producer and writer counts, output bytes per input format, peak
+ * memory and each operation's share of augmentation time. Writing is not
+ * measured, since a dry run must not touch the output directory.
+ */
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "advisor.hpp"
+#include "json_writer.hpp"
+#include "pipeline.hpp"
+#include "profiler.hpp"
+
+/**
+ * @brief What to sample and which job to extrapolate to.
+ */
+struct EstimateSettings {
+  size_t samples = 16;       ///< Tasks measured (after one warm-up task).
+  unsigned seed = 0;         ///< Seed of the sample selection.
+  int iterations = 1;        ///< Augmentations per input in the full job.
+  RunShape shape;            ///< Threads, queue and output format of the job.
+  size_t writer_batch = 12;  ///< Images each writer collects before saving.
+};
+
+/**
+ * @brief Predicted output of one input format.
+ */
+struct FormatEstimate {
+  uint64_t inputs = 0;      ///< Input files of this format.
+  uint64_t sampled = 0;     ///< Tasks of this format that were measured.
+  double bytes_in = 0;      ///< Mean encoded input size.
+  double bytes_out = 0;     ///< Mean encoded output size.
+  double total_bytes_out = 0;  ///< Predicted output of the whole job.
+};
+
+/**
+ * @brief Predicted cost of one pipeline operation.
+ */
+struct OpEstimate {
+  std::string label;     ///< Short operation name.
+  double fire_rate = 0;  ///< Share of tasks the operation fired on.
+  double mean_ns = 0;    ///< Mean time when it fired.
+  double share = 0;      ///< Share of augmentation time.
+};
+
+/**
+ * @brief Outcome of estimateRun().
+ */
+struct CostEstimate {
+  uint64_t inputs = 0;   ///< Input files of the job.
+  uint64_t tasks = 0;    ///< Tasks of the job (inputs x iterations).
+  uint64_t samples = 0;  ///< Tasks measured successfully.
+  uint64_t failures = 0; ///< Sampled tasks that failed.
+  std::array<double, kStageCount> stage_ns{};  ///< Mean per task (no write).
+  double producer_ns = 0;  ///< Mean read + decode + augment per task.
+  double writer_ns = 0;    ///< Mean encode per task.
+  double wall_ns = 0;      ///< Predicted wall time.
+  double wall_low_ns = 0;  ///< Lower end of the 95% interval.
+  double wall_high_ns = 0; ///< Upper end of the 95% interval.
+  std::string bound;       ///< "producers", "writers" or "cpu".
+  std::map<std::string, FormatEstimate> formats;  ///< Per input format.
+  double total_bytes_out = 0;  ///< Predicted output of the whole job.
+  double task_peak_bytes = 0;  ///< Largest cv::Mat working set of one task.
+  double image_bytes = 0;      ///< Mean augmented image size in memory.
+  uint64_t baseline_rss = 0;   ///< Resident memory before sampling.
+  double peak_memory = 0;      ///< Predicted peak resident memory.
+  std::vector<OpEstimate> ops; ///< Per operation, in pipeline order.
+};
+
+/**
+ * @brief Measure a random sample of tasks and extrapolate to the full job.
+ * @param paths All input images of the job.
+ * @param pipeline Configured pipeline.
+ * @param settings Sample size and job shape.
+ * @return Estimate (empty when there are no inputs).
+ */
+CostEstimate estimateRun(const std::vector<std::filesystem::path>& paths,
+                         Pipeline& pipeline, const EstimateSettings& settings);
+
+/**
+ * @brief Write a human-readable estimate.
+ * @param out Output stream.
+ * @param est Estimate to report.
+ * @param shape Job shape the estimate was made for.
+ */
+void writeEstimateText(std::ostream& out, const CostEstimate& est,
+                       const RunShape& shape);
+
+/**
+ * @brief Write an estimate as a JSON object.
+ * @param json Writer positioned where a value is expected.
+ * @param est Estimate to report.
+ */
+void writeEstimateJson(JsonWriter& json, const CostEstimate& est);
@@ -10,6 +10,8 @@
  * selected at random by the program, deterministically or not.
  */
 
+#pragma once
+
 #include <algorithm>
 #include <cctype>
 #include <opencv2/core.hpp>
@@ -22,6 +22,8 @@
 #include <array>
 #include <fstream>
 
+#include "task_timing.hpp"
+
 /**
  * @class Image
  * @brief Represents an image with associated metadata such as name and ID.
@@ -68,6 +70,12 @@ class Image {
   /// @return Image dimensions.
   const std::array<int, 2> getDimensions() const;
 
+  /// @return Mutable timing record of the task producing this image.
+  TaskTiming& getTiming();
+
+  /// @return Timing record of the task producing this image.
+  const TaskTiming& getTiming() const;
+
   /**
    * @brief Set image data.
    * @param in New image matrix to set.
@@ -94,6 +102,48 @@ class Image {
    */
   int preview(const std::string& window_name, int wait_ms = 0) const;
 
+  /**
+   * @brief Read the raw (still encoded) bytes of an image file.
+   * @param path Path to image file.
+   * @param buf Destination buffer, resized to the file size.
+   * @return 0 on success, -1 on failure.
+   */
+  static int readFile(const std::string& path, std::vector<uchar>& buf);
+
+  /**
+   * @brief Ask the kernel to drop a file's cached pages, so the next read
+   * comes from storage.
+   * @param path Path to image file.
+   * @return 0 on success, -1 on failure or where unsupported.
+   */
+  static int dropCache(const std::string& path);
+
+  /**
+   * @brief Decode image data from an in-memory encoded buffer.
+   * @param buf Encoded image bytes (e.g. as returned by readFile).
+   * @return 0 on success, -1 on failure.
+   */
+  int decode(const std::vector<uchar>& buf);
+
+  /**
+   * @brief Encode image data into an in-memory buffer.
+   * @param buf Destination buffer for the encoded bytes.
+   * @param ext File extension selecting the codec (default ".jpg").
+   * @return 0 on success, -1 on failure.
+   */
+  int encode(std::vector<uchar>& buf, const std::string& ext = ".jpg") const;
+
+  /**
+   * @brief Write previously encoded bytes to disk.
+   * @param buf Encoded image bytes (see encode).
+   * @param path Output directory (default: current directory).
+   * @param ext File extension used for the output name (default ".jpg").
+   * @param with_history Also write the operation history next to the image.
+   * @return 0 on success, -1 on failure.
+   */
+  int write(const std::vector<uchar>& buf, const std::string& path = "",
+            const std::string& ext = ".jpg", bool with_history = false) const;
+
   /**
    * @brief Save image to disk.
    * @param path Output directory or full file path.
@@ -115,6 +165,7 @@ class Image {
   std::string name_;                  ///< Optional image name or identifier.
   size_t id_;                         ///< Unique image ID.
   std::vector<std::string> history_;  ///< Operation history log.
+  TaskTiming timing_;                 ///< Per-task timing record.
   static std::atomic<size_t>
       global_id_;  ///< Global counter for assigning unique IDs.
 };
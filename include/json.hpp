@@ -31,9 +31,12 @@ struct ConfigSpec {
   std::string input_dir;
   int iterations = 1;
   size_t num_threads = std::thread::hardware_concurrency();
+  size_t num_writers = 1;
   size_t queue_capacity = 128;
   bool verbose = true;
   bool save_specs = false;
+  size_t progress_interval_ms = 1000;
+  std::string output_format = ".jpg";
   unsigned int seed = std::random_device{}();
 
   std::vector<std::tuple<std::string, std::vector<double>, double>>
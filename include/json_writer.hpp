@@ -0,0 +1,108 @@
+/**
+ * @file json_writer.hpp
+ * @brief Minimal streaming JSON writer used for augmento reports.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * Configuration parsing goes through simdjson (see json.hpp); this writer is
+ * the output-side counterpart used by the profiler and other run-end reports.
+ * It writes straight to a std::ostream and keeps only a small nesting stack.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class JsonWriter
+ * @brief Streams JSON objects/arrays to an output stream, handling commas,
+ * escaping and optional indentation.
+ */
+class JsonWriter {
+ public:
+  /**
+   * @brief Construct a writer over an output stream.
+   * @param out Destination stream.
+   * @param pretty Indent nested values (default true).
+   */
+  explicit JsonWriter(std::ostream& out, bool pretty = true);
+
+  /// @brief Open a JSON object.
+  JsonWriter& beginObject();
+
+  /// @brief Close the current JSON object.
+  JsonWriter& endObject();
+
+  /// @brief Open a JSON array.
+  JsonWriter& beginArray();
+
+  /// @brief Close the current JSON array.
+  JsonWriter& endArray();
+
+  /**
+   * @brief Write an object key; must be followed by a value or container.
+   * @param k Key string.
+   */
+  JsonWriter& key(std::string_view k);
+
+  /// @brief Write a string value.
+  JsonWriter& value(std::string_view v);
+
+  /// @brief Write a string value.
+  JsonWriter& value(const char* v);
+
+  /// @brief Write a string value.
+  JsonWriter& value(const std::string& v);
+
+  /// @brief Write a floating-point value (non-finite values become null).
+  JsonWriter& value(double v);
+
+  /// @brief Write a boolean value.
+  JsonWriter& value(bool v);
+
+  /// @brief Write an integral value.
+  template <typename T>
+  std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                   JsonWriter&>
+  value(T v) {
+    separator();
+    out_ << v;
+    return *this;
+  }
+
+  /// @brief Write a JSON null.
+  JsonWriter& null();
+
+  /**
+   * @brief Shorthand for key(k).value(v).
+   */
+  template <typename T>
+  JsonWriter& field(std::string_view k, const T& v) {
+    key(k);
+    return value(v);
+  }
+
+  /**
+   * @brief Escape a string for inclusion in a JSON document.
+   * @param s Raw string.
+   * @return Escaped string (without surrounding quotes).
+   */
+  static std::string escape(std::string_view s);
+
+ private:
+  /// @brief Emit comma/newline/indentation before a new element.
+  void separator();
+
+  /// @brief Emit newline and indentation for the current depth.
+  void newline();
+
+  std::ostream& out_;       ///< Destination stream.
+  bool pretty_;             ///< Whether to indent output.
+  bool after_key_ = false;  ///< True right after a key was written.
+  std::vector<bool> first_; ///< Per-level "no element written yet" flags.
+};
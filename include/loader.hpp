@@ -0,0 +1,159 @@
+/**
+ * @file loader.hpp
+ * @brief Pull-based training iterator over a dataset manifest.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * DataLoader walks a manifest (a list of image paths) epoch by epoch and
+ * hands out augmented batches on demand. It keeps a fixed number of batches
+ * ahead of the caller in an Augmenter's worker pool. Everything is derived
+ * from (seed, epoch, index), where index is the sample's manifest position:
+ * the shuffled order of an epoch, and the RNG that augments each sample. A
+ * run can therefore resume mid-epoch from a checkpointed (epoch, position)
+ * without replaying the samples before it, and gets the same images.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "augmenter.hpp"
+
+/**
+ * @brief Batching, shuffling and prefetch settings of a DataLoader.
+ */
+struct LoaderSettings {
+  size_t batch = 32;          ///< Samples per batch.
+  size_t prefetch = 2;        ///< Batches kept in the pool between next().
+  bool shuffle = true;        ///< Shuffle every epoch.
+  /// 0: shuffle the whole manifest. Otherwise a streaming shuffle through a
+  /// buffer of this many samples, so reads stay near the manifest order
+  /// (e.g. for sequentially stored shards).
+  size_t shuffle_buffer = 0;
+  bool drop_last = false;     ///< Skip the short last batch of an epoch.
+  uint64_t epochs = 1;        ///< Epochs to serve (0: until stopped).
+  uint64_t seed = 0;          ///< Seed of the order and the augmentations.
+};
+
+/**
+ * @brief One batch returned by DataLoader::next().
+ */
+struct LoaderBatch {
+  uint64_t epoch = 0;           ///< Epoch the batch belongs to.
+  uint64_t position = 0;        ///< Position of its first sample in the epoch.
+  std::vector<size_t> indices;  ///< Manifest index of every sample.
+  AugmentedBatch data;          ///< Augmented images, in `indices` order.
+};
+
+/**
+ * @class DataLoader
+ * @brief Iterates over augmented, shuffled batches of a manifest.
+ *
+ * Batches never span two epochs. Files are read by the Augmenter's workers,
+ * and `prefetch` batches stay in the pool between two calls to next();
+ * unreadable or undecodable samples come back empty and are counted in
+ * AugmentedBatch::failures. Not thread-safe: one caller pulls from a loader.
+ */
+class DataLoader {
+ public:
+  /**
+   * @brief Create a loader positioned at the start of epoch 0.
+   * @param manifest Image paths; a sample's index is its position here.
+   * @param augmenter Pool that augments the samples; must outlive the loader.
+   * @param settings Batching, shuffling and prefetch settings.
+   */
+  DataLoader(std::vector<std::string> manifest, Augmenter& augmenter,
+             LoaderSettings settings = {});
+
+  /**
+   * @brief Wait for the next batch, keeping the prefetch depth topped up.
+   * @param out Receives the batch.
+   * @return False once the configured epochs are exhausted.
+   */
+  bool next(LoaderBatch& out);
+
+  /**
+   * @brief Continue from a checkpointed cursor. Prefetched batches are
+   * dropped (the pool still finishes them).
+   * @param epoch Epoch to resume.
+   * @param position Samples of that epoch already consumed.
+   */
+  void seek(uint64_t epoch, uint64_t position);
+
+  /// @return Epoch of the next sample next() returns.
+  uint64_t epoch() const;
+
+  /// @return Position in its epoch of the next sample next() returns.
+  uint64_t position() const;
+
+  /// @return Batches in one epoch.
+  size_t batchesPerEpoch() const;
+
+  /**
+   * @brief Manifest indices of an epoch, in the order they are served.
+   * @param epoch Epoch number.
+   * @return A permutation of the manifest indices.
+   */
+  std::vector<size_t> epochOrder(uint64_t epoch) const;
+
+  /**
+   * @brief Seed of the pipeline RNG that augments one sample.
+   * @param seed LoaderSettings::seed.
+   * @param epoch Epoch number.
+   * @param index Manifest index of the sample.
+   * @return Seed passed to the Augmenter through BatchOptions::seeds.
+   */
+  static uint64_t sampleSeed(uint64_t seed, uint64_t epoch, size_t index);
+
+  /**
+   * @brief Read a manifest file: one image path per line; blank lines and
+   * lines starting with '#' are skipped, and relative paths are resolved
+   * against the manifest's directory. Throws std::runtime_error if the file
+   * cannot be opened.
+   * @param path Manifest file.
+   * @return Image paths.
+   */
+  static std::vector<std::string> readManifest(const std::string& path);
+
+ private:
+  /// A batch handed to the pool and not yet returned.
+  struct InFlight {
+    uint64_t epoch = 0;
+    uint64_t position = 0;
+    std::vector<size_t> indices;
+    std::future<AugmentedBatch> result;
+  };
+
+  /**
+   * @brief Submit batches until `depth` are in flight or the epochs run out.
+   * @param depth Batches to keep in the pool.
+   */
+  void topUp(size_t depth);
+
+  /**
+   * @brief Submit the batch at the submit cursor.
+   * @return False if the epochs are exhausted.
+   */
+  bool submitNext();
+
+  /**
+   * @brief Samples an epoch serves (the manifest size, less a short last
+   * batch with drop_last).
+   */
+  uint64_t epochSize() const;
+
+  std::vector<std::string> manifest_;  ///< Image paths.
+  Augmenter& augmenter_;               ///< Shared worker pool.
+  LoaderSettings settings_;            ///< Batching and shuffling settings.
+  std::vector<size_t> order_;          ///< Order of order_epoch_.
+  uint64_t order_epoch_ = UINT64_MAX;  ///< Epoch cached in order_.
+  uint64_t submit_epoch_ = 0;          ///< Cursor of the next submission.
+  uint64_t submit_position_ = 0;
+  uint64_t next_epoch_ = 0;            ///< Cursor of the next next().
+  uint64_t next_position_ = 0;
+  std::deque<InFlight> in_flight_;     ///< Prefetched batches, in order.
+};
@@ -99,6 +99,17 @@ cv::Mat cropImage(const cv::Mat& im, int x, int y, int width, int height);
  */
 cv::Mat randomCrop(const cv::Mat& im, int crop_width, int crop_height);
 
+/**
+ * @brief Randomly crop a region, drawing its position from a given engine.
+ * @param im Input image to crop from.
+ * @param crop_width Width of the crop region.
+ * @param crop_height Height of the crop region.
+ * @param gen Random engine; the same state gives the same crop.
+ * @return Cropped image of specified size.
+ */
+cv::Mat randomCrop(const cv::Mat& im, int crop_width, int crop_height,
+                   std::mt19937& gen);
+
 /**
  * @brief Apply an affine transformation to the input image.
  * @param im Input image.
@@ -123,6 +134,13 @@ cv::Mat affineTransform(const cv::Mat& im, const cv::Mat& matrix);
 int colorJitter(cv::Mat& im, double brightness, double contrast,
                 double saturation, int hue);
 
+/**
+ * @brief colorJitter() drawing its adjustments from a given engine.
+ * @param gen Random engine; the same state gives the same adjustments.
+ */
+int colorJitter(cv::Mat& im, double brightness, double contrast,
+                double saturation, int hue, std::mt19937& gen);
+
 /**
  * @brief Apply histogram equalization on image intensity.
  * @param im Input/output color image (modified in-place).
@@ -189,6 +207,12 @@ int adjustHue(cv::Mat& im, int val);
  */
 int injectNoise(cv::Mat& im, double mean, double stdev);
 
+/**
+ * @brief injectNoise() seeding the noise field from a given engine.
+ * @param gen Random engine; the same state gives the same noise.
+ */
+int injectNoise(cv::Mat& im, double mean, double stdev, std::mt19937& gen);
+
 /**
  * @brief Blur the image using a square averaging kernel.
  * @param im Input/output image (modified in-place).
@@ -214,3 +238,10 @@ int sharpenImage(cv::Mat& im);
  * @return 0 on success, -1 on failure.
  */
 int randomErase(cv::Mat& im, int min_h, int max_h, int min_w, int max_w);
+
+/**
+ * @brief randomErase() drawing the region from a given engine.
+ * @param gen Random engine; the same state gives the same region.
+ */
+int randomErase(cv::Mat& im, int min_h, int max_h, int min_w, int max_w,
+                std::mt19937& gen);
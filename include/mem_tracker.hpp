@@ -0,0 +1,189 @@
+/**
+ * @file mem_tracker.hpp
+ * @brief Accounting of live cv::Mat memory per pipeline stage.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * MemTracker installs a counting cv::MatAllocator as OpenCV's default
+ * allocator. Each buffer is charged to the stage of the thread that allocated
+ * it (set with ScopedMemStage) and remembers that stage in its UMatData, so
+ * the release is credited to the same stage. When an image changes hands, the
+ * owner re-tags its buffer (e.g. to Queued when it enters the image queue),
+ * moving its bytes to the new stage. Live bytes, high-water marks and
+ * allocation counts are kept per stage with relaxed atomics.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <opencv2/core.hpp>
+#include <ostream>
+#include <vector>
+
+#include "json_writer.hpp"
+#include "queue_monitor.hpp"
+
+/**
+ * @brief Where a cv::Mat buffer currently lives.
+ */
+enum class MemStage : size_t {
+  Other,    ///< Allocated outside the worker pipeline.
+  Decode,   ///< Decoded input images.
+  Augment,  ///< Buffers created by pipeline operations.
+  Queued,   ///< Images waiting in the image queue.
+  Batched,  ///< Images held in the consumer's save batch.
+  Encode,   ///< Temporaries created while encoding.
+  Count
+};
+
+/// @brief Number of memory stages.
+constexpr size_t kMemStageCount = static_cast<size_t>(MemStage::Count);
+
+/**
+ * @brief Display name of a memory stage (e.g. "queued").
+ * @param stage Stage to name.
+ */
+const char* memStageName(MemStage stage);
+
+/**
+ * @brief Counters of one stage at one point in time.
+ */
+struct MemStageStats {
+  uint64_t live_bytes = 0;   ///< Bytes currently held.
+  uint64_t peak_bytes = 0;   ///< High-water mark of live bytes.
+  uint64_t allocations = 0;  ///< Buffers allocated in this stage.
+  uint64_t allocated_bytes = 0;  ///< Bytes allocated in this stage.
+};
+
+/**
+ * @brief Counters of all stages at one point in time.
+ */
+struct MemSnapshot {
+  std::array<MemStageStats, kMemStageCount> stages;  ///< Per-stage counters.
+  uint64_t live_bytes = 0;  ///< Bytes currently held in all stages.
+  uint64_t peak_bytes = 0;  ///< High-water mark of the total.
+};
+
+/**
+ * @class MemTracker
+ * @brief Process-wide counting allocator for cv::Mat buffers.
+ */
+class MemTracker {
+ public:
+  /// @return The process-wide tracker.
+  static MemTracker& instance();
+
+  /**
+   * @brief Make the counting allocator OpenCV's default.
+   *
+   * Only buffers allocated afterwards are counted. Installing is permanent:
+   * buffers keep a pointer to the allocator that created them.
+   */
+  void install();
+
+  /// @return True once install() was called.
+  bool installed() const { return installed_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Stage charged for allocations made by the calling thread.
+   * @param stage New stage.
+   * @return Previous stage.
+   */
+  static MemStage setStage(MemStage stage);
+
+  /**
+   * @brief Move a counted buffer's bytes to another stage.
+   * @param mat Matrix whose buffer changes hands (ignored if not counted).
+   * @param stage New stage.
+   */
+  void retag(const cv::Mat& mat, MemStage stage);
+
+  /// @brief Restart high-water marks from the current live bytes.
+  void resetPeaks();
+
+  /// @return Current counters.
+  MemSnapshot snapshot() const;
+
+ private:
+  MemTracker();
+
+  /// @brief Counting wrapper around OpenCV's standard allocator.
+  class CountingAllocator : public cv::MatAllocator {
+   public:
+    explicit CountingAllocator(MemTracker& tracker);
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data,
+                           size_t* step, cv::AccessFlag flags,
+                           cv::UMatUsageFlags usageFlags) const override;
+    bool allocate(cv::UMatData* data, cv::AccessFlag accessflags,
+                  cv::UMatUsageFlags usageFlags) const override;
+    void deallocate(cv::UMatData* data) const override;
+
+   private:
+    MemTracker& tracker_;         ///< Receives the counts.
+    cv::MatAllocator* base_;      ///< Allocator doing the actual work.
+  };
+
+  /// @brief Per-stage counters, one cache line each.
+  struct alignas(64) StageCounters {
+    std::atomic<uint64_t> live{0};
+    std::atomic<uint64_t> peak{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> allocated{0};
+  };
+
+  void charge(MemStage stage, uint64_t bytes);
+  void release(MemStage stage, uint64_t bytes);
+
+  std::array<StageCounters, kMemStageCount> stages_;  ///< Stage counters.
+  alignas(64) std::atomic<uint64_t> live_{0};  ///< Total live bytes.
+  std::atomic<uint64_t> peak_{0};              ///< Total high-water mark.
+  std::atomic<bool> installed_{false};         ///< Allocator installed.
+  CountingAllocator allocator_;                ///< The installed allocator.
+};
+
+/**
+ * @class ScopedMemStage
+ * @brief Charges the calling thread's allocations to a stage for a scope.
+ */
+class ScopedMemStage {
+ public:
+  explicit ScopedMemStage(MemStage stage) : prev_(MemTracker::setStage(stage)) {}
+  ~ScopedMemStage() { MemTracker::setStage(prev_); }
+  ScopedMemStage(const ScopedMemStage&) = delete;
+  ScopedMemStage& operator=(const ScopedMemStage&) = delete;
+
+ private:
+  MemStage prev_;  ///< Stage restored on exit.
+};
+
+/**
+ * @brief Everything known about memory use at the end of a run.
+ */
+struct MemoryReport {
+  MemSnapshot mats;         ///< cv::Mat accounting at the end of the run.
+  uint64_t images = 0;      ///< Images produced (for per-image averages).
+  uint64_t peak_rss = 0;    ///< Peak resident set size of the process.
+  OccupancySeries rss;      ///< Sampled resident set size over time.
+};
+
+/**
+ * @brief Write a human-readable memory summary.
+ * @param out Output stream.
+ * @param report Memory report of a run.
+ */
+void writeMemoryText(std::ostream& out, const MemoryReport& report);
+
+/**
+ * @brief Write a memory report as a JSON object.
+ * @param json Writer positioned where a value is expected.
+ * @param report Memory report of a run.
+ */
+void writeMemoryJson(JsonWriter& json, const MemoryReport& report);
+
+/**
+ * @brief Peak resident set size of the process so far (VmHWM).
+ * @return Bytes, or 0 if unavailable.
+ */
+uint64_t peakResidentMemoryBytes();
@@ -0,0 +1,125 @@
+/**
+ * @file metrics.hpp
+ * @brief Prometheus text-format exposition of live run metrics.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * Metrics are rendered from the same ProgressSnapshot that drives the progress
+ * line, so exposing them costs the workers nothing beyond their per-thread
+ * counters. They can be scraped from a small HTTP endpoint bound to localhost
+ * or written periodically to a file picked up by node_exporter's textfile
+ * collector.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "progress.hpp"
+
+/**
+ * @brief Resident set size of the current process.
+ * @return Bytes of resident memory, or 0 if unavailable.
+ */
+uint64_t residentMemoryBytes();
+
+/**
+ * @brief Render a snapshot in Prometheus text exposition format (0.0.4).
+ * @param out Output stream.
+ * @param snap Current counters.
+ * @param opLabels Operation names in pipeline order.
+ * @param totalTasks Total number of images the run will produce.
+ */
+void writePrometheus(std::ostream& out, const ProgressSnapshot& snap,
+                     const std::vector<std::string>& opLabels,
+                     uint64_t totalTasks);
+
+/**
+ * @class MetricsServer
+ * @brief Minimal HTTP server answering GET /metrics on 127.0.0.1.
+ *
+ * Requests are served one at a time on a dedicated thread; each response is
+ * produced by calling the render function, which must be thread-safe.
+ */
+class MetricsServer {
+ public:
+  using Render = std::function<std::string()>;
+
+  /**
+   * @brief Bind the listening socket and start serving.
+   * @param port TCP port on the loopback interface.
+   * @param render Produces the response body.
+   * @throws std::runtime_error if the socket cannot be bound.
+   */
+  MetricsServer(uint16_t port, Render render);
+
+  /// @brief Stops the server thread and closes the socket.
+  ~MetricsServer();
+
+  MetricsServer(const MetricsServer&) = delete;
+  MetricsServer& operator=(const MetricsServer&) = delete;
+
+  /// @return Port the server listens on.
+  uint16_t port() const { return port_; }
+
+ private:
+  /// @brief Accept loop run by the server thread.
+  void serve();
+
+  /**
+   * @brief Answer a single connection.
+   * @param fd Accepted client socket.
+   */
+  void handle(int fd);
+
+  uint16_t port_;                  ///< Listening port.
+  int listen_fd_ = -1;             ///< Listening socket.
+  Render render_;                  ///< Response body producer.
+  std::atomic<bool> stop_{false};  ///< Set to end the accept loop.
+  std::thread thread_;             ///< Server thread.
+};
+
+/**
+ * @class MetricsTextfile
+ * @brief Periodically rewrites a metrics file for a textfile collector.
+ *
+ * Each write goes to a temporary file that is then renamed over the target,
+ * so the collector never reads a partially written file.
+ */
+class MetricsTextfile {
+ public:
+  /**
+   * @brief Construct a writer.
+   * @param path Target file (conventionally ending in .prom).
+   * @param interval Minimum time between two writes.
+   */
+  MetricsTextfile(std::string path, std::chrono::milliseconds interval);
+
+  /**
+   * @brief Write the file if the interval has elapsed.
+   * @param t_ns Time since the start of the run.
+   * @param render Produces the metrics; only called when a write is due.
+   */
+  void update(uint64_t t_ns, const std::function<std::string()>& render);
+
+  /**
+   * @brief Write the file unconditionally.
+   * @param text Rendered metrics.
+   * @return True on success.
+   */
+  bool write(const std::string& text);
+
+ private:
+  std::string path_;         ///< Target file.
+  uint64_t interval_ns_;     ///< Minimum time between writes.
+  uint64_t last_ns_ = 0;     ///< Time of the last write.
+  bool written_ = false;     ///< At least one write happened.
+  bool warned_ = false;      ///< A write failure was already reported.
+};
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <filesystem>
@@ -21,11 +22,33 @@
 
 #include "image.hpp"
 #include "pipeline.hpp"
+#include "probes.hpp"
+#include "profiler.hpp"
 
 namespace fs = std::filesystem;
 
+/**
+ * @brief Snapshot of a SafeQueue's traffic and contention counters.
+ */
+struct QueueStats {
+  uint64_t pushes = 0;           ///< Items pushed.
+  uint64_t pops = 0;             ///< Items popped.
+  uint64_t push_waits = 0;       ///< Pushes that blocked on a full queue.
+  uint64_t push_wait_ns = 0;     ///< Time pushers spent blocked.
+  uint64_t pop_waits = 0;        ///< Pops that blocked on an empty queue.
+  uint64_t pop_wait_ns = 0;      ///< Time poppers spent blocked.
+  uint64_t lock_contended = 0;   ///< Lock acquisitions that had to wait.
+  uint64_t lock_wait_ns = 0;     ///< Time spent waiting for the mutex.
+  size_t max_depth = 0;          ///< Highest observed depth.
+};
+
 /**
  * @brief Thread-safe bounded queue for producer-consumer workflows.
+ *
+ * Besides moving items, the queue counts how often and for how long each side
+ * blocks, and how long callers wait for its mutex. Counters are updated while
+ * the lock is held; the current depth can be read without locking.
+ *
  * @tparam T Type of elements stored in the queue.
  */
 template <typename T>
@@ -34,20 +57,37 @@ class SafeQueue {
   explicit SafeQueue(size_t max_size = 128) : max_size_(max_size) {}
 
   void push(T item) {
-    std::unique_lock<std::mutex> lock(mtx_);
-    cv_not_full_.wait(lock,
-                      [&]() { return queue_.size() < max_size_ || done_; });
+    std::unique_lock<std::mutex> lock = acquire();
+    if (queue_.size() >= max_size_ && !done_) {
+      uint64_t start = nowNs();
+      cv_not_full_.wait(lock,
+                        [&]() { return queue_.size() < max_size_ || done_; });
+      ++stats_.push_waits;
+      stats_.push_wait_ns += nowNs() - start;
+    }
     if (done_) return;
     queue_.push(std::move(item));
+    ++stats_.pushes;
+    stats_.max_depth = std::max(stats_.max_depth, queue_.size());
+    depth_.store(queue_.size(), std::memory_order_relaxed);
+    AUGMENTO_PROBE3(queue__push, this, queue_.size(), max_size_);
     cv_not_empty_.notify_one();
   }
 
   bool pop(T& item) {
-    std::unique_lock<std::mutex> lock(mtx_);
-    cv_not_empty_.wait(lock, [&]() { return !queue_.empty() || done_; });
+    std::unique_lock<std::mutex> lock = acquire();
+    if (queue_.empty() && !done_) {
+      uint64_t start = nowNs();
+      cv_not_empty_.wait(lock, [&]() { return !queue_.empty() || done_; });
+      ++stats_.pop_waits;
+      stats_.pop_wait_ns += nowNs() - start;
+    }
     if (!queue_.empty()) {
       item = std::move(queue_.front());
       queue_.pop();
+      ++stats_.pops;
+      depth_.store(queue_.size(), std::memory_order_relaxed);
+      AUGMENTO_PROBE3(queue__pop, this, queue_.size(), max_size_);
       cv_not_full_.notify_one();
       return true;
     }
@@ -61,22 +101,93 @@ class SafeQueue {
     cv_not_full_.notify_all();
   }
 
+  /// @brief Reopen a drained queue for reuse: clears items, done and stats.
+  void reset() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    queue_ = std::queue<T>();
+    done_ = false;
+    stats_ = QueueStats();
+    depth_.store(0, std::memory_order_relaxed);
+  }
+
+  /// @return Current number of queued items (lock-free, approximate).
+  size_t size() const { return depth_.load(std::memory_order_relaxed); }
+
+  /// @return Maximum number of queued items.
+  size_t capacity() const { return max_size_; }
+
+  /// @return Consistent snapshot of the queue's counters.
+  QueueStats stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return stats_;
+  }
+
  private:
+  /// @brief Lock the mutex, accounting for time spent waiting on it.
+  std::unique_lock<std::mutex> acquire() {
+    std::unique_lock<std::mutex> lock(mtx_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      uint64_t start = nowNs();
+      lock.lock();
+      ++stats_.lock_contended;
+      stats_.lock_wait_ns += nowNs() - start;
+    }
+    return lock;
+  }
+
   std::queue<T> queue_;
-  std::mutex mtx_;
+  mutable std::mutex mtx_;
   std::condition_variable cv_not_empty_;
   std::condition_variable cv_not_full_;
   size_t max_size_;
   bool done_ = false;
+  QueueStats stats_;
+  std::atomic<size_t> depth_{0};
+};
+
+/**
+ * @brief One image waiting for a producer.
+ */
+struct PathTask {
+  fs::path path;            ///< Input image.
+  uint64_t arrival_ns = 0;  ///< When the task arrived, from nowNs().
+  bool drop_cache = false;  ///< Evict the file from the page cache first.
 };
 
 /**
  * @brief Generic image producer using a shared path queue (task-pool model).
+ * @param pathQueue Queue of input tasks shared by all producers.
+ * @param outputQueue Queue receiving augmented images.
+ * @param pipeline Augmentation pipeline to apply.
+ * @param profile Profile of this producer thread (read, decode, augment).
  */
-void producerPool(SafeQueue<fs::path>& pathQueue, SafeQueue<Image>& outputQueue,
-                  Pipeline& pipeline);
+void producerPool(SafeQueue<PathTask>& pathQueue,
+                  SafeQueue<Image>& outputQueue, Pipeline& pipeline,
+                  ThreadProfile& profile);
+
+/**
+ * @brief What consumers do with each augmented image.
+ *
+ * The skipping modes isolate the cost of the earlier stages when measuring
+ * codec and I/O ceilings.
+ */
+enum class SinkMode {
+  Full,        ///< Encode and write to disk.
+  SkipWrite,   ///< Encode, then discard the bytes.
+  SkipEncode   ///< Discard the decoded image.
+};
 
 /**
  * @brief Consumer thread that saves augmented images and updates progress.
+ * @param queue Queue of augmented images.
+ * @param output_dir Directory to save images.
+ * @param save_specs Also save the operation history of each image.
+ * @param profile Profile of this consumer thread (encode, write).
+ * @param sink Which of encoding and writing to perform.
+ * @param batch_size Images collected before the consumer saves them.
+ * @param output_ext Extension selecting the output codec (e.g. ".png").
  */
-void consumerThread(SafeQueue<Image>& queue, const std::string& output_dir, bool save_specs=false);
+void consumerThread(SafeQueue<Image>& queue, const std::string& output_dir,
+                    bool save_specs, ThreadProfile& profile,
+                    SinkMode sink = SinkMode::Full, size_t batch_size = 12,
+                    const std::string& output_ext = ".jpg");
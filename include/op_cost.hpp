@@ -0,0 +1,39 @@
+/**
+ * @file op_cost.hpp
+ * @brief Analytic memory traffic and arithmetic of an image operation.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * Every Operation estimates what one application costs for a given input:
+ * bytes read from and written to image buffers, and scalar arithmetic
+ * operations performed. Combined with measured latencies these place each
+ * operation on a roofline (see roofline.hpp).
+ */
+
+#pragma once
+
+/**
+ * @brief Estimated cost of one operation application.
+ *
+ * Counts assume every intermediate buffer makes one full trip through memory,
+ * i.e. no fusion across OpenCV calls and no reuse between them.
+ */
+struct OpCost {
+  double bytes_read = 0.0;     ///< Bytes loaded from image buffers.
+  double bytes_written = 0.0;  ///< Bytes stored to image buffers.
+  double ops = 0.0;            ///< Arithmetic operations (adds, muls, ...).
+
+  /// @return Total memory traffic in bytes.
+  double bytes() const { return bytes_read + bytes_written; }
+
+  /// @return Arithmetic intensity in operations per byte.
+  double intensity() const { return bytes() > 0 ? ops / bytes() : 0.0; }
+
+  /// @brief Accumulate another cost.
+  OpCost& operator+=(const OpCost& other) {
+    bytes_read += other.bytes_read;
+    bytes_written += other.bytes_written;
+    ops += other.ops;
+    return *this;
+  }
+};
@@ -19,6 +19,7 @@
 
 #include "image.hpp"
 #include "manipulations.hpp"
+#include "op_cost.hpp"
 
 /**
  * @class Operation
@@ -41,6 +42,17 @@ class Operation {
    * @return Name of the operation.
    */
   virtual std::string name() const = 0;
+
+  /**
+   * @brief Estimate bytes moved and arithmetic performed by one application.
+   *
+   * Random parameters are replaced by the midpoint of their range. The
+   * default assumes one read and one write of every element, with no
+   * arithmetic.
+   * @param input Image data the operation is about to receive.
+   * @return Analytic cost estimate.
+   */
+  virtual OpCost cost(const cv::Mat& input) const;
 };
 
 /// @brief Type alias for a shared pointer to an Operation.
@@ -60,6 +72,7 @@ class RotateImage : public Operation {
   RotateImage(double min_angle, double max_angle, size_t rot_type);
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   double min_angle_, max_angle_;
@@ -75,6 +88,7 @@ class ReflectImage : public Operation {
   ReflectImage();
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 };
 
 /**
@@ -87,6 +101,7 @@ class ResizeImage : public Operation {
   ResizeImage(int min_w, int max_w, int min_h, int max_h);
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   bool use_scale_;
@@ -104,6 +119,7 @@ class CropImage : public Operation {
   CropImage(int x, int y, int width, int height);  ///< Fixed crop
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   int x_, y_, w_, h_;
@@ -119,6 +135,7 @@ class AffineTransform : public Operation {
   AffineTransform(const cv::Mat& matrix);
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   cv::Mat matrix_;
@@ -138,6 +155,7 @@ class ColorJitter : public Operation {
               double saturation_range, int hue_range);
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   double brightness_range_, contrast_range_, saturation_range_;
@@ -153,6 +171,7 @@ class HistogramEqualization : public Operation {
   HistogramEqualization();
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 };
 
 /**
@@ -164,6 +183,7 @@ class WhiteBalance : public Operation {
   WhiteBalance();
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 };
 
 /**
@@ -175,6 +195,7 @@ class ToGrayscale : public Operation {
   ToGrayscale();
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 };
 
 /**
@@ -186,6 +207,7 @@ class AdjustBrightness : public Operation {
   AdjustBrightness(double min_val, double max_val);
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   double min_val_, max_val_;
@@ -200,6 +222,7 @@ class AdjustContrast : public Operation {
   AdjustContrast(double min_val, double max_val);
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   double min_val_, max_val_;
@@ -214,6 +237,7 @@ class AdjustSaturation : public Operation {
   AdjustSaturation(double min_val, double max_val);
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   double min_val_, max_val_;
@@ -228,6 +252,7 @@ class AdjustHue : public Operation {
   AdjustHue(int min_val, int max_val);
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   int min_val_, max_val_;
@@ -248,6 +273,7 @@ class InjectNoise : public Operation {
               double stdev_max);
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   double mean_min_, mean_max_, stdev_min_, stdev_max_;
@@ -263,6 +289,7 @@ class BlurImage : public Operation {
   BlurImage(int min_k, int max_k);
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   int min_k_, max_k_;
@@ -277,6 +304,7 @@ class SharpenImage : public Operation {
   SharpenImage();
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 };
 
 /**
@@ -289,6 +317,7 @@ class RandomErase : public Operation {
   RandomErase(int min_h, int max_h, int min_w, int max_w);
   void apply(Image& img, std::mt19937& rng) const override;
   std::string name() const override;
+  OpCost cost(const cv::Mat& input) const override;
 
  private:
   int min_h_, max_h_, min_w_, max_w_;
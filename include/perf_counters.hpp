@@ -0,0 +1,131 @@
+/**
+ * @file perf_counters.hpp
+ * @brief Per-thread hardware performance counters read through
+ * perf_event_open(2).
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * A PerfCounterGroup counts user-space cycles, instructions, last-level cache
+ * misses and branch misses of the thread that opened it. The counters form a
+ * single perf group, so one read() returns all of them consistently. Opening
+ * fails gracefully (e.g. in containers or with a restrictive
+ * perf_event_paranoid) and individual events the CPU does not support are
+ * skipped.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Hardware events counted by a PerfCounterGroup.
+ */
+enum class PerfEvent : size_t {
+  Cycles,
+  Instructions,
+  LlcMisses,
+  BranchMisses,
+  Count
+};
+
+/// @brief Number of hardware events.
+constexpr size_t kPerfEventCount = static_cast<size_t>(PerfEvent::Count);
+
+/**
+ * @brief Display name of a hardware event (e.g. "llc_misses").
+ * @param event Event to name.
+ */
+const char* perfEventName(PerfEvent event);
+
+/**
+ * @brief Counter values at one point in time, or a difference of two.
+ */
+struct PerfSample {
+  std::array<uint64_t, kPerfEventCount> values{};  ///< Per-event counts.
+  uint64_t time_enabled = 0;  ///< Time the group was enabled (ns).
+  uint64_t time_running = 0;  ///< Time the group was on the PMU (ns).
+
+  /// @return Count of one event.
+  uint64_t operator[](PerfEvent event) const {
+    return values[static_cast<size_t>(event)];
+  }
+
+  /**
+   * @brief Counts accumulated between two samples, scaled up when the group
+   * was multiplexed off the PMU for part of the interval.
+   * @param before Earlier sample.
+   */
+  PerfSample since(const PerfSample& before) const;
+};
+
+/**
+ * @class PerfCounterGroup
+ * @brief Hardware counters of the calling thread.
+ *
+ * Must be created on the thread it measures. Not copyable.
+ */
+class PerfCounterGroup {
+ public:
+  /**
+   * @brief Open and enable the counters for the calling thread.
+   *
+   * On failure the group is unavailable and reason() explains why.
+   */
+  PerfCounterGroup();
+
+  /// @brief Closes all counters.
+  ~PerfCounterGroup();
+
+  PerfCounterGroup(const PerfCounterGroup&) = delete;
+  PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+  /// @return True if at least the cycle counter could be opened.
+  bool available() const { return fds_[0] >= 0; }
+
+  /// @return True if a specific event is being counted.
+  bool counting(PerfEvent event) const {
+    return fds_[static_cast<size_t>(event)] >= 0;
+  }
+
+  /// @return Why the counters are unavailable (empty if available).
+  const std::string& reason() const { return reason_; }
+
+  /**
+   * @brief Read all counters with a single system call.
+   * @return Current counts (zero if unavailable).
+   */
+  PerfSample read() const;
+
+ private:
+  std::array<int, kPerfEventCount> fds_;  ///< Event file descriptors.
+  std::string reason_;                    ///< Open failure description.
+};
+
+/**
+ * @brief Accumulated hardware counts of one pipeline operation.
+ */
+struct PerfTotals {
+  uint64_t calls = 0;  ///< Measured applications.
+  std::array<uint64_t, kPerfEventCount> values{};  ///< Summed counts.
+
+  /**
+   * @brief Add the counts of one application.
+   * @param delta Difference of the samples around the call.
+   */
+  void add(const PerfSample& delta);
+
+  /// @brief Add another set of totals.
+  void merge(const PerfTotals& other);
+
+  /// @return Count of one event.
+  uint64_t operator[](PerfEvent event) const {
+    return values[static_cast<size_t>(event)];
+  }
+
+  /// @return Instructions per cycle (0 if no cycles were counted).
+  double ipc() const;
+};
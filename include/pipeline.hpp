@@ -27,6 +27,8 @@
 #include "image.hpp"
 #include "json.hpp"
 #include "operation.hpp"
+#include "probes.hpp"
+#include "profiler.hpp"
 
 /**
  * @class Pipeline
@@ -64,9 +66,46 @@ class Pipeline {
    */
   void apply(Image& img, unsigned int seed);
 
+  /**
+   * @brief Apply the pipeline drawing every random choice from a given
+   * engine, with no thread or time entropy mixed in.
+   * @param img Image to transform in-place.
+   * @param rand Random engine; the same state gives the same output.
+   */
+  void apply(Image& img, std::mt19937& rand) const;
+
+  /**
+   * @brief Apply the pipeline, recording per-operation latencies.
+   * @param img Image to transform in-place.
+   * @param profile Profile of the calling thread.
+   */
+  void apply(Image& img, ThreadProfile& profile);
+
+  /// @return Number of operations in the pipeline.
+  size_t size() const;
+
+  /**
+   * @brief Short display names of the operations, in pipeline order.
+   * @return Operation names without their description (e.g. "ColorJitter").
+   */
+  std::vector<std::string> operationLabels() const;
+
  private:
+  /**
+   * @brief Apply each operation with its probability using a given RNG.
+   * @param img Image to transform in-place.
+   * @param rand Seeded random engine.
+   * @param profile Optional profile receiving per-operation latencies.
+   */
+  void applyOperations(Image& img, std::mt19937& rand,
+                       ThreadProfile* profile) const;
+
+  /// @brief Seed a per-image random engine from the base seed.
+  std::mt19937 makeEngine(const Image& img) const;
+
   std::vector<OperationEntry>
       operations_;          ///< Stored transformation operations.
+  std::vector<std::string> labels_;  ///< Short operation names.
   unsigned int base_seed_;  ///< Seed used for deterministic augmentation.
 };
 
@@ -0,0 +1,44 @@
+/**
+ * @file probes.hpp
+ * @brief Static USDT tracepoints for attaching bpftrace or perf to a running
+ * augmento process.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * When built with AUGMENTO_USDT and <sys/sdt.h> is available, each probe
+ * compiles to a single nop plus an ELF note describing its arguments; nothing
+ * happens until a tracer attaches. Otherwise the macros expand to nothing.
+ * Probe arguments must therefore be cheap to evaluate (pointers and integers).
+ *
+ * All probes use the provider name "augmento":
+ *  - task__start(path) / task__end(path, ok)    in producerPool
+ *  - op__start(name, index, cols, rows)         before each Operation::apply
+ *  - op__end(name, index, cols, rows)           after each Operation::apply
+ *  - queue__push(queue, depth, capacity)        after a SafeQueue push
+ *  - queue__pop(queue, depth, capacity)         after a SafeQueue pop
+ *  - save__start(name, id) / save__end(name, id, bytes)  in consumerThread
+ *
+ * Example scripts live in examples/bpftrace/.
+ */
+
+#pragma once
+
+#if defined(AUGMENTO_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define AUGMENTO_HAVE_USDT 1
+#endif
+#endif
+
+#ifdef AUGMENTO_HAVE_USDT
+#define AUGMENTO_PROBE1(name, a) DTRACE_PROBE1(augmento, name, a)
+#define AUGMENTO_PROBE2(name, a, b) DTRACE_PROBE2(augmento, name, a, b)
+#define AUGMENTO_PROBE3(name, a, b, c) DTRACE_PROBE3(augmento, name, a, b, c)
+#define AUGMENTO_PROBE4(name, a, b, c, d) \
+  DTRACE_PROBE4(augmento, name, a, b, c, d)
+#else
+#define AUGMENTO_PROBE1(name, a) ((void)0)
+#define AUGMENTO_PROBE2(name, a, b) ((void)0)
+#define AUGMENTO_PROBE3(name, a, b, c) ((void)0)
+#define AUGMENTO_PROBE4(name, a, b, c, d) ((void)0)
+#endif
@@ -0,0 +1,614 @@
+/**
+ * @file profiler.hpp
+ * @brief Low-overhead latency histograms and per-stage profiling for augmento.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * Every worker thread owns a ThreadProfile and records stage and per-operation
+ * latencies into log-linear (HDR-style) histograms without any locking. Once
+ * the workers are joined, the per-thread profiles are merged into a RunProfile
+ * that renders the run-end report as text or JSON.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "json_writer.hpp"
+#include "op_cost.hpp"
+#include "perf_counters.hpp"
+#include "slow_tasks.hpp"
+#include "trace.hpp"
+
+/**
+ * @brief Current monotonic time in nanoseconds.
+ */
+inline uint64_t nowNs() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+/**
+ * @brief Formats a nanosecond duration with a human-readable unit.
+ * @param ns Duration in nanoseconds.
+ * @return String such as "850ns", "12.4us", "3.21ms" or "1.50s".
+ */
+std::string formatDuration(double ns);
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of nanosecond latencies.
+ *
+ * Values are bucketed by power of two, with 32 linear sub-buckets per power,
+ * bounding the relative error of reported percentiles to about 3%. Values
+ * above roughly 36 minutes are clamped into the last bucket.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBits = 5;                    ///< log2(sub-buckets)
+  static constexpr uint64_t kSubCount = 1ull << kSubBits;  ///< Sub-buckets.
+  static constexpr int kMaxBits = 41;                   ///< Clamp above 2^41ns.
+  static constexpr size_t kBucketCount =
+      (kMaxBits - kSubBits + 1) * kSubCount;            ///< Total buckets.
+
+  LatencyHistogram();
+
+  /**
+   * @brief Record a single latency sample.
+   * @param ns Latency in nanoseconds.
+   */
+  void record(uint64_t ns);
+
+  /**
+   * @brief Add all samples of another histogram to this one.
+   * @param other Histogram to merge.
+   */
+  void merge(const LatencyHistogram& other);
+
+  /**
+   * @brief Estimate a percentile.
+   * @param q Quantile in [0, 1].
+   * @return Estimated latency in nanoseconds (0 when empty).
+   */
+  uint64_t percentile(double q) const;
+
+  /// @return Number of recorded samples.
+  uint64_t count() const { return count_; }
+
+  /// @return Sum of all recorded samples in nanoseconds.
+  uint64_t total() const { return total_; }
+
+  /// @return Smallest recorded sample (0 when empty).
+  uint64_t min() const { return count_ ? min_ : 0; }
+
+  /// @return Largest recorded sample.
+  uint64_t max() const { return max_; }
+
+  /// @return Mean of recorded samples in nanoseconds.
+  double mean() const {
+    return count_ ? static_cast<double>(total_) / count_ : 0.0;
+  }
+
+ private:
+  /// @brief Map a value to its bucket index.
+  static size_t bucketIndex(uint64_t ns);
+
+  /// @brief Representative (midpoint) value of a bucket.
+  static uint64_t bucketValue(size_t index);
+
+  std::vector<uint64_t> buckets_;  ///< Bucket counts.
+  uint64_t count_ = 0;             ///< Sample count.
+  uint64_t total_ = 0;             ///< Sum of samples.
+  uint64_t min_ = UINT64_MAX;      ///< Smallest sample.
+  uint64_t max_ = 0;               ///< Largest sample.
+};
+
+/**
+ * @brief Fixed processing stages timed around the augmentation pipeline.
+ */
+enum class Stage : size_t {
+  Read = 0,  ///< Reading encoded bytes from disk.
+  Decode,    ///< Decoding bytes into a cv::Mat.
+  Augment,   ///< Whole pipeline (sum of sampled operations).
+  Encode,    ///< Encoding the augmented image.
+  Write,     ///< Writing encoded bytes (and history) to disk.
+  Count
+};
+
+/// @brief Number of fixed stages.
+constexpr size_t kStageCount = static_cast<size_t>(Stage::Count);
+
+/**
+ * @brief Lower-case display name of a stage.
+ */
+const char* stageName(Stage stage);
+
+/**
+ * @brief Spans of a task's life measured from its arrival, queue waits
+ * included.
+ */
+enum class Sojourn : size_t {
+  Admission = 0,  ///< Arrival to the start of its read (path queue wait).
+  Handoff,        ///< Entering the image queue to the start of its encode.
+  EndToEnd,       ///< Arrival until fully saved.
+  Count
+};
+
+/// @brief Number of sojourn spans.
+constexpr size_t kSojournCount = static_cast<size_t>(Sojourn::Count);
+
+/**
+ * @brief Lower-case display name of a sojourn span.
+ */
+const char* sojournName(Sojourn span);
+
+/**
+ * @brief Identifiers of non-operation spans recorded in a trace.
+ *
+ * Values below kStageCount mirror the Stage enum; pipeline operations are
+ * recorded as kTraceOpBase + operation index.
+ */
+enum class TraceSpan : uint32_t {
+  WaitPopPaths = kStageCount,  ///< Producer blocked on an empty path queue.
+  WaitPushImages,              ///< Producer blocked on a full image queue.
+  WaitPopImages,               ///< Consumer blocked on an empty image queue.
+  WaitPushPaths,               ///< Feeder blocked on a full path queue.
+  Count
+};
+
+/// @brief First span identifier used for pipeline operations.
+constexpr uint32_t kTraceOpBase = static_cast<uint32_t>(TraceSpan::Count);
+
+/// @brief Queue operations shorter than this are not traced as waits.
+constexpr uint64_t kMinTracedWaitNs = 1000;
+
+/**
+ * @brief Counters of a ThreadProfile that other threads may read while the
+ * owning thread is still running (e.g. for progress reporting).
+ *
+ * Only the owning thread writes, so updates are plain relaxed load/store
+ * pairs rather than read-modify-write instructions. The struct is cache-line
+ * aligned to keep threads from sharing lines.
+ */
+struct alignas(64) LiveCounters {
+  std::atomic<uint64_t> completed{0};  ///< Images fully written.
+  std::atomic<uint64_t> failed{0};     ///< Failed tasks.
+  std::atomic<uint64_t> bytes_in{0};   ///< Encoded bytes read.
+  std::atomic<uint64_t> bytes_out{0};  ///< Encoded bytes written.
+  std::array<std::atomic<uint64_t>, kStageCount> busy_ns{};  ///< Stage time.
+
+  LiveCounters() = default;
+  LiveCounters(const LiveCounters& other) { *this = other; }
+  LiveCounters& operator=(const LiveCounters& other);
+
+  /// @brief Single-writer increment.
+  static void add(std::atomic<uint64_t>& counter, uint64_t v) {
+    counter.store(counter.load(std::memory_order_relaxed) + v,
+                  std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief Live counters of one pipeline operation, written by a single thread.
+ */
+struct LiveOpCounters {
+  std::atomic<uint64_t> fired{0};    ///< Times the operation was applied.
+  std::atomic<uint64_t> busy_ns{0};  ///< Time spent in the operation.
+
+  LiveOpCounters() = default;
+  LiveOpCounters(const LiveOpCounters& other) { *this = other; }
+  LiveOpCounters& operator=(const LiveOpCounters& other);
+};
+
+/**
+ * @brief Codec and I/O totals of the images of one input format.
+ *
+ * Input side fields are recorded by producers, output side fields by the
+ * consumers encoding and writing the same images.
+ */
+struct FormatTotals {
+  uint64_t images = 0;     ///< Images read and decoded.
+  uint64_t bytes_in = 0;   ///< Encoded bytes read.
+  uint64_t pixels = 0;     ///< Decoded pixels.
+  uint64_t read_ns = 0;    ///< Time reading files.
+  uint64_t decode_ns = 0;  ///< Time decoding.
+  uint64_t saved = 0;      ///< Images handled by a consumer.
+  uint64_t bytes_out = 0;  ///< Encoded bytes produced.
+  uint64_t encode_ns = 0;  ///< Time encoding.
+  uint64_t write_ns = 0;   ///< Time writing files.
+
+  /// @brief Add another set of totals to this one.
+  void merge(const FormatTotals& other);
+};
+
+/**
+ * @brief Input formats that codec and I/O totals are kept for.
+ */
+enum class InputFormat : size_t {
+  None = 0,  ///< No extension.
+  Jpg,       ///< .jpg, .jpeg
+  Png,       ///< .png
+  Webp,      ///< .webp
+  Bmp,       ///< .bmp
+  Tif,       ///< .tif, .tiff
+  Pnm,       ///< .pbm, .pgm, .ppm, .pnm
+  Jp2,       ///< .jp2
+  Exr,       ///< .exr
+  Hdr,       ///< .hdr
+  Other,     ///< Any other extension.
+  Count
+};
+
+/// @brief Number of input formats.
+constexpr size_t kInputFormatCount = static_cast<size_t>(InputFormat::Count);
+
+/**
+ * @brief Input format of a path, from its extension (case-insensitive).
+ * Allocation-free, so it may run per image.
+ * @param path Image path.
+ */
+InputFormat inputFormatOf(const std::string& path);
+
+/**
+ * @brief Lower-case display name of an input format ("jpg", "none", ...).
+ */
+const char* formatName(InputFormat format);
+
+/**
+ * @brief Normalised input format of a path ("jpg", "png", "tif", ...).
+ * @param path Image path.
+ * @return formatName(inputFormatOf(path)).
+ */
+std::string inputFormat(const std::string& path);
+
+/**
+ * @class ThreadProfile
+ * @brief Per-thread collection of stage and operation histograms.
+ *
+ * A ThreadProfile is written by exactly one thread. Its histograms are read
+ * only after that thread has been joined, so they need no synchronisation;
+ * live() and liveOps() may be read at any time.
+ */
+class ThreadProfile {
+ public:
+  /**
+   * @brief Construct a profile for a pipeline with a given number of ops.
+   * @param numOps Number of operations in the pipeline.
+   */
+  explicit ThreadProfile(size_t numOps = 0);
+
+  /**
+   * @brief Record the latency of a fixed stage.
+   * @param stage Stage being timed.
+   * @param start_ns Start time from nowNs().
+   * @param end_ns End time from nowNs().
+   */
+  void recordStage(Stage stage, uint64_t start_ns, uint64_t end_ns) {
+    stages_[static_cast<size_t>(stage)].record(end_ns - start_ns);
+    LiveCounters::add(live_.busy_ns[static_cast<size_t>(stage)],
+                      end_ns - start_ns);
+    if (trace_)
+      trace_->record(static_cast<uint32_t>(stage), start_ns, end_ns);
+  }
+
+  /**
+   * @brief Record how long a task took from its arrival to a point.
+   * @param span Which span this is.
+   * @param ns Duration in nanoseconds.
+   */
+  void recordSojourn(Sojourn span, uint64_t ns) {
+    sojourns_[static_cast<size_t>(span)].record(ns);
+  }
+
+  /**
+   * @brief Record the latency of a pipeline operation that fired.
+   * @param index Position of the operation in the pipeline.
+   * @param start_ns Start time from nowNs().
+   * @param end_ns End time from nowNs().
+   */
+  void recordOp(size_t index, uint64_t start_ns, uint64_t end_ns) {
+    if (index < ops_.size()) {
+      ops_[index].record(end_ns - start_ns);
+      LiveCounters::add(live_ops_[index].fired, 1);
+      LiveCounters::add(live_ops_[index].busy_ns, end_ns - start_ns);
+    }
+    if (trace_)
+      trace_->record(kTraceOpBase + static_cast<uint32_t>(index), start_ns,
+                     end_ns);
+  }
+
+  /**
+   * @brief Record the analytic cost of a pipeline operation that fired.
+   * @param index Position of the operation in the pipeline.
+   * @param cost Estimate returned by Operation::cost().
+   */
+  void recordOpCost(size_t index, const OpCost& cost) {
+    if (index < op_cost_.size()) op_cost_[index] += cost;
+  }
+
+  /**
+   * @brief Record hardware counts of a pipeline operation that fired.
+   * @param index Position of the operation in the pipeline.
+   * @param delta Counter difference around the call.
+   */
+  void recordOpPerf(size_t index, const PerfSample& delta) {
+    if (index < op_perf_.size()) op_perf_[index].add(delta);
+  }
+
+  /**
+   * @brief Record time spent blocked on a queue (traced only).
+   * @param span Which queue wait this is.
+   * @param start_ns Start time from nowNs().
+   * @param end_ns End time from nowNs().
+   */
+  void recordWait(TraceSpan span, uint64_t start_ns, uint64_t end_ns) {
+    if (trace_ && end_ns - start_ns >= kMinTracedWaitNs)
+      trace_->record(static_cast<uint32_t>(span), start_ns, end_ns);
+  }
+
+  /**
+   * @brief Attach a trace buffer receiving a span for every record call.
+   * @param trace Buffer owned by a Tracer, or nullptr to disable tracing.
+   */
+  void setTrace(TraceBuffer* trace) { trace_ = trace; }
+
+  /// @return True when spans are being traced.
+  bool tracing() const { return trace_ != nullptr; }
+
+  /**
+   * @brief Attach hardware counters opened on the owning thread.
+   * @param perf Counter group, or nullptr to stop sampling.
+   */
+  void setPerf(const PerfCounterGroup* perf) {
+    perf_ = perf;
+    if (perf && op_perf_.size() < ops_.size()) op_perf_.resize(ops_.size());
+  }
+
+  /// @return Attached hardware counters, or nullptr.
+  const PerfCounterGroup* perf() const { return perf_; }
+
+  /**
+   * @brief Attach a log receiving the tasks this thread finishes.
+   * @param log Shared slowest-task log, or nullptr to stop recording.
+   */
+  void setSlowTasks(SlowTaskLog* log) { slow_tasks_ = log; }
+
+  /// @return Attached slowest-task log, or nullptr.
+  SlowTaskLog* slowTasks() const { return slow_tasks_; }
+
+  /**
+   * @brief Keep each task's operation timings (TaskTiming::ops), which the
+   * slowest-task log reports.
+   * @param enable Whether to keep them.
+   */
+  void setTaskOpTiming(bool enable) { task_op_timing_ = enable; }
+
+  /// @return True when task operation timings are kept.
+  bool taskOpTiming() const { return task_op_timing_; }
+
+  /**
+   * @brief Sum each fired operation's analytic cost (for roofline reports).
+   * @param enable Whether to evaluate Operation::cost().
+   */
+  void setCostModel(bool enable) { cost_model_ = enable; }
+
+  /// @return True when operation costs are summed.
+  bool costModel() const { return cost_model_; }
+
+  /// @brief Count a task that failed with an exception.
+  void recordFailure() { LiveCounters::add(live_.failed, 1); }
+
+  /// @brief Count an image that was fully written.
+  void recordCompleted() { LiveCounters::add(live_.completed, 1); }
+
+  /// @brief Count encoded bytes read from disk.
+  void recordBytesIn(uint64_t bytes) {
+    LiveCounters::add(live_.bytes_in, bytes);
+  }
+
+  /// @brief Count encoded bytes written to disk.
+  void recordBytesOut(uint64_t bytes) {
+    LiveCounters::add(live_.bytes_out, bytes);
+  }
+
+  /**
+   * @brief Record reading and decoding one image of a given input format.
+   * @param format Input format (see inputFormatOf()).
+   * @param bytes Encoded size.
+   * @param pixels Decoded pixel count.
+   * @param read_ns Time reading the file.
+   * @param decode_ns Time decoding.
+   */
+  void recordFormatInput(InputFormat format, uint64_t bytes, uint64_t pixels,
+                         uint64_t read_ns, uint64_t decode_ns) {
+    FormatTotals& f = formats_[static_cast<size_t>(format)];
+    ++f.images;
+    f.bytes_in += bytes;
+    f.pixels += pixels;
+    f.read_ns += read_ns;
+    f.decode_ns += decode_ns;
+  }
+
+  /**
+   * @brief Record encoding and writing one image of a given input format.
+   * @param format Input format of the source image.
+   * @param bytes Encoded output size (0 when encoding was skipped).
+   * @param encode_ns Time encoding.
+   * @param write_ns Time writing.
+   */
+  void recordFormatOutput(InputFormat format, uint64_t bytes,
+                          uint64_t encode_ns, uint64_t write_ns) {
+    FormatTotals& f = formats_[static_cast<size_t>(format)];
+    ++f.saved;
+    f.bytes_out += bytes;
+    f.encode_ns += encode_ns;
+    f.write_ns += write_ns;
+  }
+
+  /// @return Histogram of a fixed stage.
+  const LatencyHistogram& stage(Stage stage) const {
+    return stages_[static_cast<size_t>(stage)];
+  }
+
+  /// @return Histogram of a sojourn span.
+  const LatencyHistogram& sojourn(Sojourn span) const {
+    return sojourns_[static_cast<size_t>(span)];
+  }
+
+  /// @return Per-operation histograms, in pipeline order.
+  const std::vector<LatencyHistogram>& ops() const { return ops_; }
+
+  /// @return Per-operation hardware counts (empty unless sampled).
+  const std::vector<PerfTotals>& opPerf() const { return op_perf_; }
+
+  /// @return Per-operation summed analytic costs, in pipeline order.
+  const std::vector<OpCost>& opCosts() const { return op_cost_; }
+
+  /// @return Codec and I/O totals, indexed by InputFormat.
+  const std::array<FormatTotals, kInputFormatCount>& formats() const {
+    return formats_;
+  }
+
+  /// @return Number of failed tasks.
+  uint64_t failures() const { return live_.failed.load(); }
+
+  /// @return Counters that may be read while the owner is running.
+  const LiveCounters& live() const { return live_; }
+
+  /// @return Per-operation counters that may be read while running.
+  const std::vector<LiveOpCounters>& liveOps() const { return live_ops_; }
+
+ private:
+  std::array<LatencyHistogram, kStageCount> stages_;  ///< Stage histograms.
+  std::array<LatencyHistogram, kSojournCount> sojourns_;  ///< Task spans.
+  std::vector<LatencyHistogram> ops_;  ///< Operation histograms.
+  LiveCounters live_;                  ///< Concurrently readable counters.
+  std::vector<LiveOpCounters> live_ops_;  ///< Readable operation counters.
+  std::vector<PerfTotals> op_perf_;    ///< Operation hardware counts.
+  std::vector<OpCost> op_cost_;        ///< Operation analytic costs.
+  std::array<FormatTotals, kInputFormatCount> formats_;  ///< Per format.
+  TraceBuffer* trace_ = nullptr;       ///< Optional span sink.
+  const PerfCounterGroup* perf_ = nullptr;  ///< Optional hardware counters.
+  SlowTaskLog* slow_tasks_ = nullptr;  ///< Optional slowest-task log.
+  bool task_op_timing_ = false;        ///< Keep TaskTiming::ops.
+  bool cost_model_ = false;            ///< Sum Operation::cost().
+};
+
+/**
+ * @class RunProfile
+ * @brief Merged profile of a complete run with text and JSON reporting.
+ */
+class RunProfile {
+ public:
+  RunProfile() = default;
+
+  /**
+   * @brief Construct an empty run profile for a set of operations.
+   * @param opLabels Short display names of pipeline operations, in order.
+   */
+  explicit RunProfile(std::vector<std::string> opLabels);
+
+  /**
+   * @brief Merge a worker's profile into the run profile.
+   * @param profile Per-thread profile (its thread must have finished).
+   */
+  void merge(const ThreadProfile& profile);
+
+  /**
+   * @brief Set the wall-clock duration of the run.
+   * @param ns Duration in nanoseconds.
+   */
+  void setWallTime(uint64_t ns) { wall_ns_ = ns; }
+
+  /// @return Wall-clock duration of the run in nanoseconds.
+  uint64_t wallTime() const { return wall_ns_; }
+
+  /// @return Merged histogram of a fixed stage.
+  const LatencyHistogram& stage(Stage stage) const {
+    return stages_[static_cast<size_t>(stage)];
+  }
+
+  /// @return Merged histogram of a sojourn span.
+  const LatencyHistogram& sojourn(Sojourn span) const {
+    return sojourns_[static_cast<size_t>(span)];
+  }
+
+  /// @return Merged per-operation histograms, in pipeline order.
+  const std::vector<LatencyHistogram>& ops() const { return ops_; }
+
+  /// @return Operation labels, in pipeline order.
+  const std::vector<std::string>& opLabels() const { return op_labels_; }
+
+  /// @return Merged per-operation hardware counts, in pipeline order.
+  const std::vector<PerfTotals>& opPerf() const { return op_perf_; }
+
+  /// @return True if any hardware counts were recorded.
+  bool hasPerf() const;
+
+  /// @return Merged per-operation analytic costs, in pipeline order.
+  const std::vector<OpCost>& opCosts() const { return op_cost_; }
+
+  /// @return Merged codec and I/O totals per input format.
+  const std::map<std::string, FormatTotals>& formats() const {
+    return formats_;
+  }
+
+  /// @return Total number of failed tasks.
+  uint64_t failures() const { return failures_; }
+
+  /// @return Total number of images fully written.
+  uint64_t completed() const { return completed_; }
+
+  /// @return Total encoded bytes read.
+  uint64_t bytesIn() const { return bytes_in_; }
+
+  /// @return Total encoded bytes written.
+  uint64_t bytesOut() const { return bytes_out_; }
+
+  /**
+   * @brief Write a human-readable report.
+   * @param out Output stream.
+   */
+  void writeText(std::ostream& out) const;
+
+  /**
+   * @brief Write the report as a JSON object.
+   * @param json Writer positioned where a value is expected.
+   */
+  void writeJson(JsonWriter& json) const;
+
+  /**
+   * @brief Write per-format codec and I/O throughput as text.
+   * @param out Output stream.
+   */
+  void writeFormatsText(std::ostream& out) const;
+
+  /**
+   * @brief Write per-format codec and I/O throughput as a JSON array.
+   * @param json Writer positioned where a value is expected.
+   */
+  void writeFormatsJson(JsonWriter& json) const;
+
+ private:
+  std::vector<std::string> op_labels_;                ///< Operation labels.
+  std::array<LatencyHistogram, kStageCount> stages_;  ///< Stage histograms.
+  std::array<LatencyHistogram, kSojournCount> sojourns_;  ///< Task spans.
+  std::vector<LatencyHistogram> ops_;  ///< Operation histograms.
+  std::vector<PerfTotals> op_perf_;    ///< Operation hardware counts.
+  std::vector<OpCost> op_cost_;        ///< Operation analytic costs.
+  std::map<std::string, FormatTotals> formats_;  ///< Per input format.
+  uint64_t failures_ = 0;              ///< Failed task count.
+  uint64_t completed_ = 0;             ///< Images fully written.
+  uint64_t bytes_in_ = 0;              ///< Encoded bytes read.
+  uint64_t bytes_out_ = 0;             ///< Encoded bytes written.
+  uint64_t wall_ns_ = 0;               ///< Wall-clock duration.
+};
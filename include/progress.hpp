@@ -0,0 +1,102 @@
+/**
+ * @file progress.hpp
+ * @brief Rate-limited live progress reporting for augmento runs.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * The ThreadController monitor thread periodically hands a ProgressSnapshot to
+ * a ProgressReporter, which prints at most one status line per interval with
+ * throughput, ETA, per-stage utilisation and queue depths. On a terminal the
+ * line is rewritten in place; otherwise one line is emitted per interval.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "profiler.hpp"
+
+/**
+ * @brief Aggregated live counters at one point in time.
+ */
+struct ProgressSnapshot {
+  uint64_t t_ns = 0;       ///< Time since the start of the run.
+  uint64_t completed = 0;  ///< Images written.
+  uint64_t failed = 0;     ///< Failed tasks.
+  uint64_t bytes_in = 0;   ///< Encoded bytes read.
+  uint64_t bytes_out = 0;  ///< Encoded bytes written.
+  std::array<uint64_t, kStageCount> busy_ns{};  ///< Summed stage time.
+  size_t path_depth = 0;   ///< Path queue depth.
+  size_t path_capacity = 0;   ///< Path queue capacity.
+  size_t image_depth = 0;  ///< Image queue depth.
+  size_t image_capacity = 0;  ///< Image queue capacity.
+  std::vector<uint64_t> op_fired;    ///< Applications per operation.
+  std::vector<uint64_t> op_busy_ns;  ///< Time spent per operation.
+
+  /**
+   * @brief Add the live counters of one thread.
+   * @param profile Profile of a running (or finished) thread.
+   */
+  void add(const ThreadProfile& profile);
+};
+
+/**
+ * @class ProgressReporter
+ * @brief Prints rate-limited progress lines from periodic snapshots.
+ */
+class ProgressReporter {
+ public:
+  /**
+   * @brief Construct a reporter.
+   * @param out Output stream.
+   * @param totalTasks Total number of images the run will produce.
+   * @param producers Number of producer threads (read, decode, augment).
+   * @param consumers Number of consumer threads (encode, write).
+   * @param interval Minimum time between two lines.
+   * @param inPlace Rewrite a single status line instead of appending lines.
+   */
+  ProgressReporter(std::ostream& out, uint64_t totalTasks, size_t producers,
+                   size_t consumers, std::chrono::milliseconds interval,
+                   bool inPlace);
+
+  /**
+   * @brief Offer a new snapshot; prints if the interval has elapsed.
+   * @param snap Current counters.
+   */
+  void update(const ProgressSnapshot& snap);
+
+  /**
+   * @brief Print a final line covering the whole run.
+   * @param snap Counters at the end of the run.
+   */
+  void finish(const ProgressSnapshot& snap);
+
+  /**
+   * @brief Whether an output stream is an interactive terminal.
+   * @param out Stream to test (only std::cout/std::cerr can be terminals).
+   */
+  static bool isTerminal(const std::ostream& out);
+
+ private:
+  /**
+   * @brief Format a status line from two snapshots.
+   * @param prev Snapshot at the start of the window.
+   * @param cur Snapshot at the end of the window.
+   */
+  std::string format(const ProgressSnapshot& prev,
+                     const ProgressSnapshot& cur) const;
+
+  std::ostream& out_;          ///< Output stream.
+  uint64_t total_;             ///< Total tasks.
+  size_t producers_;           ///< Producer threads.
+  size_t consumers_;           ///< Consumer threads.
+  uint64_t interval_ns_;       ///< Minimum time between lines.
+  bool in_place_;              ///< Rewrite a single line.
+  size_t last_width_ = 0;      ///< Length of the last in-place line.
+  ProgressSnapshot last_;      ///< Snapshot at the last printed line.
+};
@@ -0,0 +1,125 @@
+/**
+ * @file queue_monitor.hpp
+ * @brief Occupancy sampling and run-end reporting for augmento's queues.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * ThreadController samples the depth of its path and image queues at a fixed
+ * period while a run is in progress. Together with the blocking and lock
+ * counters kept by SafeQueue itself, the samples form a QueueReport that shows
+ * which side of each queue was waiting on the other.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "json_writer.hpp"
+#include "multithread.hpp"
+
+/**
+ * @brief One occupancy sample.
+ */
+struct QueueSample {
+  uint64_t t_ns;  ///< Time since the start of the run.
+  size_t depth;   ///< Queue depth at that time.
+};
+
+/**
+ * @class OccupancySeries
+ * @brief Bounded time series of queue depth with running summary.
+ *
+ * The series keeps at most a fixed number of samples: once full, every other
+ * sample is discarded and the recording stride doubles, so arbitrarily long
+ * runs keep an evenly spaced overview. Summary statistics use every sample.
+ */
+class OccupancySeries {
+ public:
+  /**
+   * @brief Construct an empty series.
+   * @param capacity Queue capacity (depth at which the queue is full).
+   * @param maxSamples Maximum number of samples retained.
+   */
+  explicit OccupancySeries(size_t capacity = 0, size_t maxSamples = 2048);
+
+  /**
+   * @brief Add a depth sample.
+   * @param t_ns Time since the start of the run.
+   * @param depth Observed depth.
+   */
+  void add(uint64_t t_ns, size_t depth);
+
+  /// @return Retained samples in time order.
+  const std::vector<QueueSample>& samples() const { return samples_; }
+
+  /// @return Mean sampled depth.
+  double meanDepth() const;
+
+  /// @return Fraction of samples where the queue was full.
+  double fullFraction() const;
+
+  /// @return Fraction of samples where the queue was empty.
+  double emptyFraction() const;
+
+  /// @return Number of samples taken.
+  uint64_t sampleCount() const { return seen_; }
+
+ private:
+  std::vector<QueueSample> samples_;  ///< Retained (decimated) samples.
+  size_t capacity_;                   ///< Queue capacity.
+  size_t max_samples_;                ///< Retention limit.
+  uint64_t stride_ = 1;               ///< Keep every stride-th sample.
+  uint64_t seen_ = 0;                 ///< Samples taken.
+  uint64_t full_ = 0;                 ///< Samples at capacity.
+  uint64_t empty_ = 0;                ///< Samples at zero depth.
+  double depth_sum_ = 0.0;            ///< Sum of sampled depths.
+};
+
+/**
+ * @brief Everything known about one queue at the end of a run.
+ */
+struct QueueReport {
+  std::string name;        ///< Display name ("paths", "images").
+  std::string pushers;     ///< Who pushes (e.g. "feeder").
+  std::string poppers;     ///< Who pops (e.g. "producers").
+  size_t push_threads;     ///< Number of pushing threads.
+  size_t pop_threads;      ///< Number of popping threads.
+  size_t capacity;         ///< Queue capacity.
+  QueueStats stats;        ///< Counters from SafeQueue.
+  OccupancySeries series;  ///< Sampled occupancy.
+
+  /**
+   * @brief Fraction of the pushing threads' time spent blocked on a full
+   * queue.
+   * @param wall_ns Run duration.
+   */
+  double pushBlockedFraction(uint64_t wall_ns) const;
+
+  /**
+   * @brief Fraction of the popping threads' time spent blocked on an empty
+   * queue.
+   * @param wall_ns Run duration.
+   */
+  double popBlockedFraction(uint64_t wall_ns) const;
+};
+
+/**
+ * @brief Write a human-readable summary of queue behaviour.
+ * @param out Output stream.
+ * @param queues Reports for each queue.
+ * @param wall_ns Run duration.
+ */
+void writeQueueText(std::ostream& out, const std::vector<QueueReport>& queues,
+                    uint64_t wall_ns);
+
+/**
+ * @brief Write queue reports as a JSON array.
+ * @param json Writer positioned where a value is expected.
+ * @param queues Reports for each queue.
+ * @param wall_ns Run duration.
+ */
+void writeQueueJson(JsonWriter& json, const std::vector<QueueReport>& queues,
+                    uint64_t wall_ns);
@@ -0,0 +1,95 @@
+/**
+ * @file roofline.hpp
+ * @brief Roofline placement of pipeline operations against measured machine
+ * peaks.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * Each operation's analytic cost (see op_cost.hpp) is divided by its measured
+ * time to obtain achieved bandwidth and arithmetic throughput. Comparing these
+ * with the single-core peaks of the host shows whether an operation is
+ * bandwidth-bound (a fusion candidate) or compute-bound (a SIMD candidate),
+ * and how far it is from its ceiling.
+ */
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "json_writer.hpp"
+#include "profiler.hpp"
+
+/**
+ * @brief Single-core memory bandwidth and arithmetic throughput of the host.
+ *
+ * Operations run on one worker thread each, so single-core peaks are the
+ * relevant ceilings.
+ */
+struct MachinePeaks {
+  double bandwidth_gbs = 0.0;  ///< STREAM-triad bandwidth (GB/s).
+  double gops = 0.0;           ///< Multiply-add throughput (Gop/s).
+
+  /**
+   * @brief Measure peaks with short triad and multiply-add kernels.
+   * @return Best of several repetitions (takes a few hundred milliseconds).
+   */
+  static MachinePeaks measure();
+
+  /// @return Arithmetic intensity (op/byte) where the two roofs meet.
+  double ridge() const { return bandwidth_gbs > 0 ? gops / bandwidth_gbs : 0; }
+
+  /**
+   * @brief Attainable throughput at a given arithmetic intensity.
+   * @param intensity Operations per byte.
+   * @return min(peak compute, intensity * peak bandwidth) in Gop/s.
+   */
+  double attainable(double intensity) const;
+};
+
+/**
+ * @brief Position of one operation on the roofline.
+ */
+struct RooflinePoint {
+  size_t index = 0;             ///< Position in the pipeline.
+  std::string label;            ///< Operation label.
+  uint64_t calls = 0;           ///< Timed applications.
+  double intensity = 0.0;       ///< Operations per byte.
+  double achieved_gbs = 0.0;    ///< Achieved bandwidth (GB/s).
+  double achieved_gops = 0.0;   ///< Achieved throughput (Gop/s).
+  double attainable_gops = 0.0; ///< Roofline ceiling at this intensity.
+  bool memory_bound = false;    ///< Intensity below the ridge point.
+
+  /// @return Fraction of the roofline ceiling reached.
+  double efficiency() const {
+    return attainable_gops > 0 ? achieved_gops / attainable_gops : 0.0;
+  }
+};
+
+/**
+ * @brief Place every operation that fired on the roofline.
+ * @param profile Merged run profile with latencies and analytic costs.
+ * @param peaks Machine peaks.
+ * @return One point per operation with at least one timed call.
+ */
+std::vector<RooflinePoint> rooflinePoints(const RunProfile& profile,
+                                          const MachinePeaks& peaks);
+
+/**
+ * @brief Write a human-readable roofline table.
+ * @param out Output stream.
+ * @param profile Merged run profile.
+ * @param peaks Machine peaks.
+ */
+void writeRooflineText(std::ostream& out, const RunProfile& profile,
+                       const MachinePeaks& peaks);
+
+/**
+ * @brief Write peaks and roofline points as a JSON object.
+ * @param json Writer positioned where a value is expected.
+ * @param profile Merged run profile.
+ * @param peaks Machine peaks.
+ */
+void writeRooflineJson(JsonWriter& json, const RunProfile& profile,
+                       const MachinePeaks& peaks);
@@ -0,0 +1,236 @@
+/**
+ * @file service.hpp
+ * @brief Local augmentation service over a Unix domain socket.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * `augmento --serve-socket <path>` keeps one worker pool alive for many
+ * small jobs on the same machine. A client sends a request (pipeline id,
+ * image bytes or a path, number of variants, seed, output format) and gets
+ * the augmented images back encoded. Requests are queued per client, where a
+ * client is the peer process. A dispatcher serves the clients round-robin,
+ * coalescing the head requests that use the same pipeline and format into one
+ * pool batch. Requests that would push the number of pending images over
+ * the global or per-client limit are answered at once with
+ * ServiceStatus::Busy.
+ *
+ * Wire format (native byte order, both ends are on one machine):
+ *
+ *   request:  ServiceRequestHeader, pipeline id, format, payload
+ *             (payload: encoded image bytes, or a path readable by the server)
+ *   response: ServiceResponseHeader, message, then `count` times
+ *             { uint64_t length; uint8_t bytes[length]; }  (length 0: failed)
+ *
+ * A connection may carry any number of requests, answered in order.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "augmenter.hpp"
+#include "pipeline.hpp"
+
+/// First field of every request ("AUGQ").
+constexpr uint32_t kServiceRequestMagic = 0x51475541;
+
+/// First field of every response ("AUGA").
+constexpr uint32_t kServiceResponseMagic = 0x41475541;
+
+/// Protocol version carried by requests.
+constexpr uint16_t kServiceVersion = 1;
+
+/**
+ * @brief Fixed-size head of a request.
+ */
+struct ServiceRequestHeader {
+  uint32_t magic = kServiceRequestMagic;
+  uint16_t version = kServiceVersion;
+  uint16_t source = 0;        ///< 0: payload is image bytes, 1: a path.
+  uint32_t count = 1;         ///< Augmented variants wanted.
+  uint32_t pipeline_len = 0;  ///< Bytes of the pipeline id ("" = default).
+  uint64_t seed = 0;          ///< Variant j is reproducible from (seed, j).
+  uint32_t format_len = 0;    ///< Bytes of the output extension ("" = .jpg).
+  uint32_t reserved = 0;
+  uint64_t payload_len = 0;   ///< Bytes of the image or path.
+};
+
+/**
+ * @brief Outcome of a request.
+ */
+enum class ServiceStatus : int32_t {
+  Ok = 0,               ///< Images follow (failed ones with length 0).
+  Busy = 1,             ///< Rejected by admission control; retry later.
+  BadRequest = 2,       ///< Malformed request or unreadable path.
+  UnknownPipeline = 3,  ///< No pipeline with that id.
+  ShuttingDown = 4      ///< The server is stopping.
+};
+
+/**
+ * @brief Fixed-size head of a response.
+ */
+struct ServiceResponseHeader {
+  uint32_t magic = kServiceResponseMagic;
+  int32_t status = 0;        ///< ServiceStatus.
+  uint32_t count = 0;        ///< Images that follow.
+  uint32_t message_len = 0;  ///< Bytes of the explanatory message.
+};
+
+/**
+ * @brief Limits and pool size of the service.
+ */
+struct ServiceSettings {
+  std::string socket_path;       ///< Filesystem path of the socket.
+  size_t workers = 1;            ///< Augmentation threads.
+  size_t queue_capacity = 128;   ///< Pool queue capacity.
+  size_t max_batch = 64;         ///< Images coalesced into one pool batch.
+  size_t max_pending = 1024;     ///< Admitted, unfinished images (all).
+  size_t max_client_pending = 256;  ///< Admitted, unfinished images (each).
+  uint32_t max_count = 256;      ///< Variants per request (at most the
+                                 ///< pending limits; more: BadRequest).
+  uint64_t max_payload = 64ull << 20;  ///< Bytes of image or path.
+};
+
+/**
+ * @class AugmentService
+ * @brief Serves augmentation requests on a Unix domain socket.
+ *
+ * Construction binds the socket and starts the accept, dispatch and worker
+ * threads; destruction answers queued requests with ShuttingDown, finishes
+ * those already in the pool, and removes the socket file.
+ */
+class AugmentService {
+ public:
+  /**
+   * @brief Start serving. Throws std::runtime_error if the socket cannot be
+   * bound.
+   * @param pipelines Pipelines by id; requests with an empty id use
+   * "default".
+   * @param settings Socket path, pool size and limits.
+   */
+  AugmentService(std::map<std::string, Pipeline> pipelines,
+                 ServiceSettings settings);
+
+  /// @brief Stop serving (see class description).
+  ~AugmentService();
+
+  AugmentService(const AugmentService&) = delete;
+  AugmentService& operator=(const AugmentService&) = delete;
+
+  /// @return Counters of the shared worker pool.
+  ProgressSnapshot snapshot() const;
+
+  /// @return Requests rejected by admission control so far.
+  uint64_t rejected() const;
+
+ private:
+  /// A reply on its way back to a client.
+  struct Reply {
+    ServiceStatus status = ServiceStatus::Ok;
+    std::string message;
+    std::vector<std::vector<uchar>> images;
+  };
+
+  /// An admitted request waiting for, or in, the pool.
+  struct Pending {
+    uint64_t client = 0;
+    const Pipeline* pipeline = nullptr;
+    std::string key;      ///< Pipeline id and format; equal keys coalesce.
+    std::string format;   ///< Output extension.
+    cv::Mat image;        ///< Decoded once, shared by all variants.
+    uint32_t count = 0;
+    uint64_t seed = 0;
+    std::promise<Reply> reply;
+  };
+
+  /// One client connection and its thread.
+  struct Connection {
+    int fd = -1;
+    std::thread thread;
+    std::atomic<bool> finished{false};
+  };
+
+  /// @brief Accept loop; also reaps finished connections.
+  void acceptLoop();
+
+  /**
+   * @brief Read requests from one connection and answer them in order.
+   * @param conn Connection to serve.
+   */
+  void serveConnection(Connection& conn);
+
+  /**
+   * @brief Validate, decode and admit one request.
+   * @param client Peer process of the connection.
+   * @param head Request header.
+   * @param pipeline_id Requested pipeline.
+   * @param format Requested output extension.
+   * @param payload Image bytes or path.
+   * @return Future reply (already set if the request was not admitted).
+   */
+  std::future<Reply> admit(uint64_t client, const ServiceRequestHeader& head,
+                           const std::string& pipeline_id, std::string format,
+                           std::vector<uchar> payload);
+
+  /// @brief Dispatcher loop: coalesce queued requests into pool batches.
+  void dispatchLoop();
+
+  /**
+   * @brief Remove a fair, coalesced batch of requests from the queues.
+   * Called with mtx_ held and at least one request queued.
+   * @return Requests of the batch.
+   */
+  std::vector<std::shared_ptr<Pending>> takeBatch();
+
+  /**
+   * @brief Hand a batch to the pool; its callback answers every request.
+   * @param batch Requests to run together.
+   */
+  void submit(std::vector<std::shared_ptr<Pending>> batch);
+
+  /**
+   * @brief Return a request's images to the admission budget. Called with
+   * mtx_ held.
+   * @param request Finished or abandoned request.
+   */
+  void releaseImages(const Pending& request);
+
+  std::map<std::string, Pipeline> pipelines_;  ///< Pipelines by id.
+  ServiceSettings settings_;                   ///< Limits and pool size.
+  Augmenter augmenter_;                        ///< Shared worker pool.
+  int listen_fd_ = -1;                         ///< Listening socket.
+  std::atomic<bool> stop_{false};              ///< Set to stop every loop.
+
+  mutable std::mutex mtx_;      ///< Guards everything below.
+  std::condition_variable cv_;  ///< Wakes the dispatcher.
+  std::map<uint64_t, std::deque<std::shared_ptr<Pending>>> queues_;
+  uint64_t next_client_ = 0;    ///< Round-robin position.
+  size_t pending_images_ = 0;   ///< Admitted, unfinished images.
+  std::map<uint64_t, size_t> client_images_;  ///< The same, per client.
+  size_t in_flight_images_ = 0; ///< Images handed to the pool.
+  uint64_t rejected_ = 0;       ///< Busy replies.
+
+  std::list<Connection> connections_;  ///< Accepted connections.
+  std::thread accept_thread_;          ///< Runs acceptLoop().
+  std::thread dispatch_thread_;        ///< Runs dispatchLoop().
+};
+
+/**
+ * @brief Run an AugmentService until SIGINT or SIGTERM arrives.
+ * @param pipelines Pipelines by id.
+ * @param settings Socket path, pool size and limits.
+ * @param log Stream receiving status lines.
+ */
+void serveSocket(std::map<std::string, Pipeline> pipelines,
+                 const ServiceSettings& settings, std::ostream& log);
@@ -15,10 +15,17 @@
 
 #include <chrono>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
+#include "advisor.hpp"
+#include "estimator.hpp"
 #include "json.hpp"
 #include "pipeline.hpp"
+#include "roofline.hpp"
+#include "service.hpp"
+#include "shm_ring.hpp"
 #include "thread_controller.hpp"
 
 namespace fs = std::filesystem;
@@ -45,7 +52,20 @@ class SessionManager {
    * Recognixed flags:
    * - --config <path> or -c <path>: JSON configuration path
    * - --tui: Use TUI mode instead of config file
-   * - --dry-run: Perform setup but skip augmentation execution
+   * - --dry-run: Estimate the job from a sample instead of running it
+   * - --dry-run-samples <n>: Tasks sampled by --dry-run
+   * - --profile <path>: Write the run summary (latencies, queues) as JSON
+   * - --trace <path>: Write a Chrome trace-event timeline of the run
+   * - --slowest <n>: Report the n slowest tasks of the run
+   * - --advise: Diagnose the run's bottleneck and recommend settings
+   * - --io-only: Run read, decode, encode and write with an empty pipeline
+   * - --skip-write / --skip-encode: Stop consumers before writing / encoding
+   * - --cold-cache: Drop inputs from the page cache before the run
+   * - --serve-shm <name>: Serve batches into a shared-memory ring, shaped by
+   *   --shm-batch, --shm-shape, --shm-layout, --shm-slots and --shm-epochs
+   * - --serve-socket <path>: Serve requests on a Unix socket, with more
+   *   pipelines from --socket-pipeline <id>=<config> and limits from
+   *   --socket-batch, --socket-max-pending and --socket-client-pending
    * - --help: Show user help on how to use the user interface
    * Unrecognized arguments throw an error.
    */
@@ -71,6 +91,37 @@ class SessionManager {
    */
   void launchThreads();
 
+  /**
+   * @brief Runs a sample of tasks in memory and reports the estimated time,
+   * output size and memory of the full job (saved as JSON with --profile).
+   */
+  void dryRun();
+
+  /**
+   * @brief Serves augmented, fixed-shape batches into a shared-memory ring
+   * for a trainer process until the epochs are done or it is interrupted.
+   */
+  void serveShm();
+
+  /**
+   * @brief Serves augmentation requests from local clients on a Unix domain
+   * socket until it is interrupted.
+   */
+  void serveService();
+
+  /**
+   * @brief Prints and/or saves the run summary (latency profile and queue
+   * behaviour) of a finished run.
+   * @param controller Thread controller that executed the run.
+   */
+  void reportRun(const ThreadController& controller) const;
+
+  /**
+   * @brief Saves the recorded timeline as Chrome trace-event JSON.
+   * @param tracer Tracer holding the per-thread spans.
+   */
+  void writeTrace(const Tracer& tracer) const;
+
   std::string config_path_;            ///< Path to the JSON configuration file.
   ConfigSpec config_;                  ///< Parsed configuration values.
   Pipeline pipeline_;                  ///< Configured augmentation pipeline.
@@ -78,4 +129,23 @@ class SessionManager {
   int argc_;                           ///< Argument count from main().
   char** argv_;                        ///< Argument vector from main().
   bool dry_run_ = false;	       ///< Note whether dry run.
+  size_t dry_run_samples_ = 16;        ///< Tasks sampled by a dry run.
+  std::string profile_path_;           ///< Optional JSON profile output path.
+  std::string trace_path_;             ///< Optional Chrome trace output path.
+  uint16_t metrics_port_ = 0;          ///< Optional metrics HTTP port.
+  std::string metrics_path_;           ///< Optional metrics textfile path.
+  bool perf_counters_ = false;         ///< Sample hardware counters.
+  bool roofline_ = false;              ///< Report a roofline.
+  bool mem_profile_ = false;           ///< Report memory per stage.
+  size_t slowest_ = 0;                 ///< Slowest tasks to report.
+  bool advise_ = false;                ///< Report bottleneck advice.
+  bool io_only_ = false;               ///< Run with an empty pipeline.
+  SinkMode sink_ = SinkMode::Full;     ///< What consumers do with images.
+  bool cold_cache_ = false;            ///< Drop inputs from the page cache.
+  MachinePeaks peaks_;                 ///< Peaks measured at startup.
+  bool serve_shm_ = false;             ///< Run as a shared-memory server.
+  ShmServeSettings shm_;               ///< Shared-memory ring settings.
+  bool serve_socket_ = false;          ///< Run as a socket service.
+  ServiceSettings socket_;             ///< Socket service settings.
+  std::map<std::string, std::string> socket_pipelines_;  ///< Extra configs.
 };
@@ -0,0 +1,131 @@
+/**
+ * @file shm_ring.hpp
+ * @brief Producer side of the shared-memory batch ring and the
+ * `--serve-shm` daemon loop.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * The layout and the consumer live in augmento_ring.h, which trainers
+ * include directly. ShmRingWriter creates the shared-memory object and
+ * publishes batches in order; serveShmRing() keeps an Augmenter busy
+ * filling ring slots in place, one BatchCollator per slot, until the
+ * requested number of epochs is done or the process is interrupted.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "augmento_ring.h"
+#include "pipeline.hpp"
+#include "tensor.hpp"
+
+/**
+ * @class ShmRingWriter
+ * @brief Creates a batch ring in POSIX shared memory and publishes into it.
+ *
+ * Batches are identified by their sequence number. The producer may fill
+ * several slots at once, but publishes them in sequence order.
+ */
+class ShmRingWriter {
+ public:
+  /**
+   * @brief Create and map the ring. An existing object of the same name is
+   * replaced only when it is stale: closed, never initialised, or left by a
+   * producer process that no longer exists. A live server's ring makes this
+   * throw instead. Throws std::runtime_error on failure.
+   * @param name Shared-memory name, e.g. "/augmento".
+   * @param slots Batches the ring holds (at least 1).
+   * @param batch Images per batch.
+   * @param height Image height.
+   * @param width Image width.
+   * @param channels Channels per pixel.
+   * @param depth OpenCV depth of the elements.
+   * @param layout NHWC or NCHW.
+   */
+  ShmRingWriter(const std::string& name, uint32_t slots, size_t batch,
+                int height, int width, int channels, int depth,
+                TensorLayout layout);
+
+  /// @brief Close the ring, unmap it and remove its name.
+  ~ShmRingWriter();
+
+  ShmRingWriter(const ShmRingWriter&) = delete;
+  ShmRingWriter& operator=(const ShmRingWriter&) = delete;
+
+  /**
+   * @brief Block until the consumer has released the slot batch `sequence`
+   * will use (backpressure).
+   * @param sequence Batch to be written.
+   * @param stop Polled while waiting; waiting ends when it becomes true.
+   * @return True once writable, false if stopped.
+   */
+  bool waitWritable(uint32_t sequence, const std::atomic<bool>& stop);
+
+  /**
+   * @brief Tensor memory of the slot used by a batch.
+   * @param sequence Batch number.
+   * @return 64-byte aligned start of the slot's tensor.
+   */
+  uchar* tensor(uint32_t sequence) const;
+
+  /**
+   * @brief Make the next batch visible to the consumer.
+   * @param sequence Batch number; must be the next unpublished one.
+   * @param images Valid images in the batch.
+   * @param failures Images that failed and were left zeroed.
+   * @param epoch Pass over the dataset.
+   */
+  void publish(uint32_t sequence, uint32_t images, uint32_t failures,
+               uint64_t epoch);
+
+  /// @brief Tell the consumer that no more batches will follow.
+  void close();
+
+  /// @return Batches the ring holds.
+  uint32_t slots() const;
+
+  /// @return Time spent in waitWritable() because the consumer was behind.
+  uint64_t waitNs() const;
+
+ private:
+  std::string name_;                       ///< Shared-memory name.
+  augmento_ring_header* header_ = nullptr; ///< Start of the mapping.
+  size_t size_ = 0;                        ///< Bytes mapped.
+  uint64_t wait_ns_ = 0;                   ///< Backpressure time.
+};
+
+/**
+ * @brief Settings of the `--serve-shm` daemon mode.
+ */
+struct ShmServeSettings {
+  std::string name = "/augmento";  ///< Shared-memory name.
+  uint32_t slots = 4;              ///< Batches in the ring.
+  size_t batch = 32;               ///< Images per batch.
+  int height = 224, width = 224, channels = 3;  ///< Image shape.
+  TensorLayout layout = TensorLayout::NHWC;     ///< Tensor layout.
+  uint64_t epochs = 0;       ///< Passes over the inputs (0: until stopped).
+  unsigned seed = 0;         ///< Seed of the per-epoch shuffle.
+  size_t workers = 1;        ///< Augmentation threads.
+  size_t queue_capacity = 128;  ///< Pending images before reading blocks.
+};
+
+/**
+ * @brief Serve shuffled, augmented, fixed-shape batches into a
+ * shared-memory ring until the epochs are done or SIGINT/SIGTERM arrives.
+ *
+ * Images of another size are resized to the ring's shape.
+ * @param paths Input images.
+ * @param pipeline Augmentation pipeline.
+ * @param settings Ring shape and run length.
+ * @param log Stream receiving progress lines.
+ * @return Batches published.
+ */
+uint64_t serveShmRing(const std::vector<std::filesystem::path>& paths,
+                      const Pipeline& pipeline,
+                      const ShmServeSettings& settings, std::ostream& log);
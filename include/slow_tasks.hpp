@@ -0,0 +1,118 @@
+/**
+ * @file slow_tasks.hpp
+ * @brief Bounded flight recorder of the slowest tasks of a run.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * Every Image carries a TaskTiming filled in by its producer (read, decode,
+ * augment and the operations that fired). When the image has been written,
+ * the consumer completes the record with its queue wait, encode and write
+ * times and offers it to a SlowTaskLog, which keeps only the N tasks with the
+ * longest service time. Tail outliers can then be found without tracing the
+ * whole run.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "json_writer.hpp"
+#include "task_timing.hpp"
+
+/**
+ * @brief Complete record of one finished task.
+ */
+struct SlowTask {
+  std::string path;         ///< Source path.
+  TaskTiming timing;        ///< Producer-side timing.
+  uint64_t queued_ns = 0;   ///< From enqueue to the start of encoding.
+  uint64_t encode_ns = 0;   ///< Time encoding.
+  uint64_t write_ns = 0;    ///< Time writing.
+  uint64_t bytes_out = 0;   ///< Encoded output size.
+  int out_width = 0;        ///< Width after augmentation.
+  int out_height = 0;       ///< Height after augmentation.
+
+  /// @return Time the task kept a thread busy (excludes queue waits).
+  uint64_t serviceNs() const {
+    return timing.read_ns + timing.decode_ns + timing.augment_ns + encode_ns +
+           write_ns;
+  }
+};
+
+/**
+ * @class SlowTaskLog
+ * @brief Keeps the N finished tasks with the longest service time.
+ *
+ * Tasks faster than the current N-th slowest are rejected by consider()
+ * with a single relaxed load, so checking every task costs nearly nothing
+ * once the log is full.
+ */
+class SlowTaskLog {
+ public:
+  /**
+   * @brief Construct an empty log.
+   * @param capacity Number of tasks to keep.
+   */
+  explicit SlowTaskLog(size_t capacity);
+
+  /**
+   * @brief Count a finished task and check whether it would be kept.
+   *
+   * Lets callers skip building a SlowTask for the common, fast case.
+   * @param service_ns Service time of the task (see SlowTask::serviceNs).
+   * @return True if the task is slower than the N-th slowest so far.
+   */
+  bool consider(uint64_t service_ns) {
+    considered_.fetch_add(1, std::memory_order_relaxed);
+    return capacity_ > 0 &&
+           service_ns > threshold_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Insert a task that passed consider().
+   * @param task Task record; moved from only if it is kept.
+   */
+  void offer(SlowTask&& task);
+
+  /// @brief Forget all tasks (e.g. before a new run).
+  void clear();
+
+  /// @return Kept tasks, slowest first.
+  std::vector<SlowTask> slowest() const;
+
+  /// @return Number of tasks considered since the last clear().
+  uint64_t considered() const { return considered_.load(std::memory_order_relaxed); }
+
+  /// @return Maximum number of tasks kept.
+  size_t capacity() const { return capacity_; }
+
+ private:
+  size_t capacity_;                    ///< Number of tasks to keep.
+  mutable std::mutex mtx_;             ///< Guards heap_.
+  std::vector<SlowTask> heap_;         ///< Min-heap on service time.
+  std::atomic<uint64_t> threshold_{0}; ///< Service time to beat when full.
+  std::atomic<uint64_t> considered_{0};   ///< Tasks considered.
+};
+
+/**
+ * @brief Write the slowest tasks as a human-readable list.
+ * @param out Output stream.
+ * @param log Log of the run.
+ * @param opLabels Operation names, in pipeline order.
+ */
+void writeSlowTasksText(std::ostream& out, const SlowTaskLog& log,
+                        const std::vector<std::string>& opLabels);
+
+/**
+ * @brief Write the slowest tasks as a JSON array.
+ * @param json Writer positioned where a value is expected.
+ * @param log Log of the run.
+ * @param opLabels Operation names, in pipeline order.
+ */
+void writeSlowTasksJson(JsonWriter& json, const SlowTaskLog& log,
+                        const std::vector<std::string>& opLabels);
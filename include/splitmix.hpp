@@ -0,0 +1,22 @@
+/**
+ * @file splitmix.hpp
+ * @brief splitmix64 hash shared by everything that derives seeds.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief One splitmix64 step: advance by the golden gamma, then finalise.
+ * @param z Value to hash.
+ * @return A well-mixed 64-bit hash of @p z.
+ */
+inline uint64_t splitmix64(uint64_t z) {
+  z += 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
@@ -0,0 +1,37 @@
+/**
+ * @file stop_signal.hpp
+ * @brief Scoped SIGINT/SIGTERM handling for the serving loops.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#pragma once
+
+#include <atomic>
+
+/**
+ * @class StopSignalGuard
+ * @brief Routes SIGINT and SIGTERM to a stop flag while in scope.
+ *
+ * The constructor clears the flag and installs the handlers; the destructor
+ * restores the previous handlers, including when the server throws. One
+ * guard at a time: the flag is process-wide.
+ */
+class StopSignalGuard {
+ public:
+  StopSignalGuard();
+  ~StopSignalGuard();
+
+  StopSignalGuard(const StopSignalGuard&) = delete;
+  StopSignalGuard& operator=(const StopSignalGuard&) = delete;
+
+  /// @return True once SIGINT or SIGTERM has been received.
+  bool stopped() const;
+
+  /// @return The flag itself, for waits that poll it.
+  const std::atomic<bool>& flag() const;
+
+ private:
+  void (*previous_int_)(int);   ///< SIGINT handler to restore.
+  void (*previous_term_)(int);  ///< SIGTERM handler to restore.
+};
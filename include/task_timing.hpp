@@ -0,0 +1,39 @@
+/**
+ * @file task_timing.hpp
+ * @brief Per-task timing record carried by every Image.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * Filled in by the producer and read by the consumer; SlowTaskLog keeps the
+ * records of the slowest tasks (see slow_tasks.hpp).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Time spent in one pipeline operation that fired on a task.
+ */
+struct OpTiming {
+  uint32_t index = 0;  ///< Position of the operation in the pipeline.
+  uint64_t ns = 0;     ///< Time spent in the operation.
+};
+
+/**
+ * @brief Producer-side timing of one task, carried along with its image.
+ */
+struct TaskTiming {
+  uint64_t arrival_ns = 0;   ///< When the task arrived, from nowNs().
+  uint64_t start_ns = 0;     ///< Start of the read, from nowNs().
+  uint64_t read_ns = 0;      ///< Time reading the encoded file.
+  uint64_t decode_ns = 0;    ///< Time decoding.
+  uint64_t augment_ns = 0;   ///< Time in the whole pipeline.
+  uint64_t enqueued_ns = 0;  ///< When the image entered the image queue.
+  uint64_t bytes_in = 0;     ///< Encoded input size.
+  int width = 0;             ///< Decoded width.
+  int height = 0;            ///< Decoded height.
+  int channels = 0;          ///< Decoded channel count.
+  std::vector<OpTiming> ops; ///< Operations that fired, in order.
+};
@@ -0,0 +1,187 @@
+/**
+ * @file tensor.hpp
+ * @brief Zero-copy DLPack views of augmented images and a batch collator.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * Training frameworks (PyTorch, JAX, TensorFlow, CuPy) import tensors through
+ * DLPack: a plain C struct describing data pointer, shape, strides and dtype,
+ * plus a deleter the consumer calls when it is done. toDLPack() wraps a single
+ * cv::Mat without copying its pixels, and BatchCollator lays a whole batch out
+ * in one contiguous NHWC or NCHW buffer that is handed over the same way.
+ *
+ * When <dlpack/dlpack.h> is available it is used; otherwise the structs below
+ * declare the same, ABI-compatible, unversioned layout.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <opencv2/core.hpp>
+#include <vector>
+
+#if __has_include(<dlpack/dlpack.h>)
+#include <dlpack/dlpack.h>
+#else
+extern "C" {
+
+/// Device holding the data (only CPU memory is produced here).
+typedef enum { kDLCPU = 1 } DLDeviceType;
+
+typedef struct {
+  DLDeviceType device_type;
+  int32_t device_id;
+} DLDevice;
+
+/// Element kind of a tensor.
+typedef enum {
+  kDLInt = 0U,
+  kDLUInt = 1U,
+  kDLFloat = 2U,
+} DLDataTypeCode;
+
+typedef struct {
+  uint8_t code;
+  uint8_t bits;
+  uint16_t lanes;
+} DLDataType;
+
+typedef struct {
+  void* data;
+  DLDevice device;
+  int32_t ndim;
+  DLDataType dtype;
+  int64_t* shape;
+  int64_t* strides;  ///< In elements, not bytes.
+  uint64_t byte_offset;
+} DLTensor;
+
+typedef struct DLManagedTensor {
+  DLTensor dl_tensor;
+  void* manager_ctx;
+  void (*deleter)(struct DLManagedTensor* self);
+} DLManagedTensor;
+
+}  // extern "C"
+#endif
+
+/**
+ * @brief Order of the dimensions of a collated batch.
+ */
+enum class TensorLayout {
+  NHWC,  ///< Channels interleaved, as OpenCV stores them.
+  NCHW   ///< One plane per channel, as most PyTorch models expect.
+};
+
+/**
+ * @brief DLPack element type of an OpenCV depth.
+ * @param depth OpenCV depth (CV_8U, CV_32F, ...).
+ * @return Single-lane DLPack type; throws std::invalid_argument if unknown.
+ */
+DLDataType dlpackType(int depth);
+
+/**
+ * @brief Borrow an image as an (H, W, C) DLPack tensor without copying.
+ *
+ * The tensor holds a reference to the cv::Mat's buffer, which stays alive
+ * until the consumer calls the deleter. Row padding (e.g. a Mat that is a
+ * region of a larger one) is expressed through the strides.
+ * @param image Non-empty image.
+ * @return Managed tensor; ownership passes to the caller.
+ */
+DLManagedTensor* toDLPack(const cv::Mat& image);
+
+/**
+ * @class BatchCollator
+ * @brief Writes N images straight into one contiguous batch tensor.
+ *
+ * The buffer is allocated once per batch, 64-byte aligned. put() copies an
+ * augmented image into its slot (splitting channels into planes for NCHW),
+ * which is the only copy between augmentation and the framework. Calls to
+ * put() for different indices may run concurrently. release() hands the
+ * filled buffer over as a DLPack tensor and starts a new one.
+ */
+class BatchCollator {
+ public:
+  /**
+   * @brief Allocate the first batch buffer.
+   * @param batch Images per batch (N).
+   * @param height Image height (H); every image must match.
+   * @param width Image width (W).
+   * @param channels Channels per pixel (C).
+   * @param depth OpenCV depth of the elements (default CV_8U).
+   * @param layout NHWC (default) or NCHW.
+   */
+  BatchCollator(size_t batch, int height, int width, int channels,
+                int depth = CV_8U, TensorLayout layout = TensorLayout::NHWC);
+
+  /**
+   * @brief Copy an image into slot `index` of the current batch.
+   * @param index Slot, below batchSize().
+   * @param image Image of H x W x C elements of the batch's depth (any
+   * height and width with setResize()). Images with 1, 3 or 4 channels are
+   * converted (grey, BGR, BGRA) when the batch has another of these counts.
+   */
+  void put(size_t index, const cv::Mat& image);
+
+  /**
+   * @brief Zero slot `index`, e.g. after its image failed.
+   * @param index Slot, below batchSize().
+   */
+  void clear(size_t index);
+
+  /**
+   * @brief Resize images of another height or width to the batch's, instead
+   * of rejecting them. Channels and depth must still match.
+   * @param enable Whether to resize.
+   */
+  void setResize(bool enable = true);
+
+  /**
+   * @brief Write into caller-owned memory (e.g. a shared-memory slot)
+   * instead of an own buffer. The memory must hold bytes(), stay valid while
+   * in use and outlive any tensor released from it.
+   * @param data Start of the memory, ideally 64-byte aligned.
+   */
+  void attach(uchar* data);
+
+  /**
+   * @brief Writable view of one NHWC slot, so an image can be produced in
+   * place (e.g. as the destination of a final resize).
+   * @param index Slot, below batchSize().
+   * @return H x W Mat header over the slot (throws for NCHW).
+   */
+  cv::Mat slot(size_t index);
+
+  /**
+   * @brief Hand the current batch over and start a new buffer.
+   * @return Managed (N, H, W, C) or (N, C, H, W) tensor; ownership passes to
+   * the caller.
+   */
+  DLManagedTensor* release();
+
+  /// @return Images per batch.
+  size_t batchSize() const;
+
+  /// @return Bytes of one batch buffer.
+  size_t bytes() const;
+
+  /// @return Dimension order of the batch tensor.
+  TensorLayout layout() const;
+
+ private:
+  /// @brief Allocate a fresh, aligned batch buffer.
+  void allocate();
+
+  /// @return Start of slot `index` (throws if out of range).
+  uchar* slotData(size_t index) const;
+
+  size_t batch_;                   ///< Images per batch.
+  int height_, width_, channels_;  ///< Per-image shape.
+  int depth_;                      ///< OpenCV element depth.
+  TensorLayout layout_;            ///< Dimension order.
+  size_t image_bytes_;             ///< Bytes of one slot.
+  bool resize_ = false;            ///< Resize mismatched images.
+  std::shared_ptr<uchar> buffer_;  ///< Current batch buffer.
+};
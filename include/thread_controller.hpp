@@ -4,21 +4,30 @@
  * @author Emmanuel Butsana
  * @date July 24, 2025
  *
- * Manages multiple producer threads and a single consumer thread using
+ * Manages multiple producer threads and one or more consumer threads using
  * thread-safe queues to perform parallel image augmentation.
  * Handles task distribution, queueing, and lifecycle management.
  */
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "mem_tracker.hpp"
+#include "metrics.hpp"
 #include "multithread.hpp"
 #include "pipeline.hpp"
+#include "profiler.hpp"
+#include "progress.hpp"
+#include "queue_monitor.hpp"
+#include "trace.hpp"
 
 namespace fs = std::filesystem;
 
@@ -27,7 +36,7 @@ namespace fs = std::filesystem;
  * @brief Manages a thread pool for parallel image augmentation tasks.
  *
  * Launches multiple producer threads to apply augmentations on images
- * and a consumer thread to save augmented images to disk.
+ * and consumer threads to save augmented images to disk.
  * Supports configurable number of threads and queue capacities.
  */
 class ThreadController {
@@ -54,6 +63,143 @@ class ThreadController {
            Pipeline& pipeline, const std::string& output_dir,
            bool verbose = false, bool save_specs = false);
 
+  /**
+   * @brief Merged latency profile of the last call to run().
+   * @return Run profile with stage and per-operation histograms.
+   */
+  const RunProfile& profile() const;
+
+  /**
+   * @brief Set the number of consumer threads encoding and writing images.
+   * @param numWriters Writer threads used by subsequent runs (at least 1).
+   */
+  void setWriterCount(size_t numWriters);
+
+  /**
+   * @brief Pin every worker thread of subsequent runs to its own CPU.
+   *
+   * Producers take the first n CPUs the process may run on (its affinity
+   * mask) and writers the following ones, wrapping around when there are
+   * more threads than CPUs. A thread that cannot be pinned logs a warning
+   * and runs unpinned. Ignored where thread affinity is unsupported.
+   * @param enable Whether to pin.
+   */
+  void enableCpuPinning(bool enable = true);
+
+  /**
+   * @brief Choose what consumers do with augmented images in subsequent
+   * runs.
+   * @param sink Encode and write (default), encode only, or neither.
+   */
+  void setSinkMode(SinkMode sink);
+
+  /**
+   * @brief Choose the codec consumers encode with in subsequent runs.
+   * @param ext Output file extension (e.g. ".jpg", ".png", ".webp").
+   */
+  void setOutputFormat(const std::string& ext);
+
+  /**
+   * @brief Set how many images each consumer collects before saving them.
+   * @param batchSize Images per batch in subsequent runs (at least 1).
+   */
+  void setWriterBatchSize(size_t batchSize);
+
+  /**
+   * @brief Offer tasks at a fixed rate instead of as fast as the producers
+   * accept them (open loop).
+   *
+   * Each task is stamped with its scheduled arrival time, so when the feeder
+   * falls behind because the path queue is full, the delay still counts
+   * towards the task's latency instead of being hidden.
+   * @param rate Arrivals per second in subsequent runs (0 feeds closed-loop).
+   * @param poisson Exponentially distributed gaps instead of constant ones.
+   * @param seed Seed of the arrival process.
+   */
+  void setArrivalRate(double rate, bool poisson = true, unsigned seed = 1);
+
+  /**
+   * @brief Set how often verbose runs print a progress line.
+   * @param interval Minimum time between progress lines (0 disables them).
+   */
+  void setProgressInterval(std::chrono::milliseconds interval);
+
+  /**
+   * @brief Expose live metrics of subsequent runs in Prometheus format.
+   * @param port Serve GET /metrics on 127.0.0.1:port (0 disables).
+   * @param textfile Periodically rewrite this file for node_exporter's
+   * textfile collector (empty disables).
+   */
+  void enableMetrics(uint16_t port, const std::string& textfile = "");
+
+  /**
+   * @brief Sample hardware counters (cycles, instructions, LLC and branch
+   * misses) around every operation in subsequent runs. Falls back to plain
+   * timing with a warning if perf events are unavailable.
+   * @param enable Whether to sample.
+   */
+  void enablePerfCounters(bool enable = true);
+
+  /**
+   * @brief Count cv::Mat memory per stage and sample RSS in subsequent runs.
+   *
+   * Installs a counting allocator as OpenCV's process-wide default.
+   */
+  void enableMemoryTracking();
+
+  /**
+   * @brief Memory report of the last call to run().
+   * @return Report (empty unless memory tracking was enabled).
+   */
+  const MemoryReport& memoryReport() const;
+
+  /**
+   * @brief Keep the slowest finished tasks of subsequent runs.
+   * @param count Number of tasks to keep (0 disables).
+   */
+  void enableSlowTasks(size_t count);
+
+  /**
+   * @brief Evict each input from the page cache before it is read again by
+   * a later iteration of subsequent runs, so every pass reads from storage.
+   * The first pass is the caller's to drop (see Image::dropCache()).
+   * @param enable Whether to drop pages between iterations.
+   */
+  void enableColdCache(bool enable = true);
+
+  /**
+   * @brief Sum every operation's analytic cost in subsequent runs, as
+   * needed by roofline reports. Off by default, since evaluating the cost
+   * model on every operation is wasted work otherwise.
+   * @param enable Whether to sum costs.
+   */
+  void enableCostModel(bool enable = true);
+
+  /**
+   * @brief Slowest tasks of the last run, if enabled.
+   * @return Log of the slowest tasks, or nullptr.
+   */
+  const SlowTaskLog* slowTasks() const;
+
+  /**
+   * @brief Record a per-thread timeline of subsequent runs.
+   * @param eventsPerThread Ring buffer capacity of each thread.
+   */
+  void enableTracing(size_t eventsPerThread = Tracer::kDefaultCapacity);
+
+  /**
+   * @brief Timeline of the last run, if tracing was enabled.
+   * @return Tracer holding per-thread spans, or nullptr.
+   */
+  const Tracer* tracer() const;
+
+  /**
+   * @brief Occupancy and contention report of the internal queues for the
+   * last call to run().
+   * @return Reports for the path queue and the image queue.
+   */
+  const std::vector<QueueReport>& queueReports() const;
+
  private:
   /**
    * @brief Launches producer threads that pull tasks from pathQueue_ and push
@@ -65,7 +211,7 @@ class ThreadController {
   void launchProducers(Pipeline& pipeline);
 
   /**
-   * @brief Launches consumer thread that saves augmented images from
+   * @brief Launches the consumer threads that save augmented images from
    * imageQueue_ to disk.
    * @param output_dir Directory to save images.
    */
@@ -77,12 +223,74 @@ class ThreadController {
    */
   void waitForCompletion();
 
+  /**
+   * @brief Launches the monitor thread that periodically samples queue
+   * depths until waitForCompletion() stops it.
+   */
+  void launchMonitor();
+
+  /**
+   * @brief Takes one sample of every monitored quantity.
+   * @param t_ns Time since the start of the run.
+   */
+  void sample(uint64_t t_ns);
+
+  /**
+   * @brief Aggregates the live counters of all worker threads.
+   * @param t_ns Time since the start of the run.
+   */
+  ProgressSnapshot snapshot(uint64_t t_ns) const;
+
+  /**
+   * @brief Renders the current live counters as Prometheus text.
+   */
+  std::string renderMetrics() const;
+
   size_t numThreads_;  ///< Number of producer threads.
-  SafeQueue<fs::path>
+  size_t numWriters_ = 1;  ///< Number of consumer threads.
+  bool pin_cpus_ = false;  ///< Pin worker threads to CPUs.
+  SinkMode sink_ = SinkMode::Full;  ///< Consumer behaviour.
+  size_t batch_size_ = 12;          ///< Images per consumer save batch.
+  std::string output_ext_ = ".jpg";  ///< Output codec extension.
+  double arrival_rate_ = 0;         ///< Offered tasks per second (0: closed).
+  bool poisson_arrivals_ = true;    ///< Exponential inter-arrival gaps.
+  unsigned arrival_seed_ = 1;       ///< Seed of the arrival process.
+  SafeQueue<PathTask>
       pathQueue_;  ///< Queue holding image paths to be processed.
   SafeQueue<Image>
       imageQueue_;  ///< Queue holding augmented images ready to save.
   std::vector<std::thread> producers_;     ///< Vector of producer threads.
-  std::thread consumer_;                   ///< Consumer thread.
-  std::atomic<size_t> totalTasks_{0};      ///< Total tasks available
+  std::vector<std::thread> consumers_;     ///< Consumer threads.
+  std::atomic<size_t> totalTasks_{0};      ///< Total tasks available.
+  std::vector<ThreadProfile> profiles_;    ///< Per-thread profiles.
+  RunProfile profile_;                     ///< Merged profile of last run.
+  std::unique_ptr<Tracer> tracer_;         ///< Optional timeline recorder.
+  std::thread monitor_;                    ///< Periodic sampling thread.
+  std::mutex monitor_mtx_;                 ///< Guards monitor_stop_.
+  std::condition_variable monitor_cv_;     ///< Wakes the monitor to stop.
+  bool monitor_stop_ = false;              ///< Monitor stop request.
+  uint64_t run_start_ns_ = 0;              ///< Start of the current run.
+  std::vector<QueueReport> queue_reports_; ///< Queue reports of last run.
+  std::chrono::milliseconds progress_interval_{1000};  ///< Progress period.
+  std::unique_ptr<ProgressReporter> progress_;  ///< Active progress output.
+  uint16_t metrics_port_ = 0;                   ///< Metrics HTTP port.
+  std::string metrics_path_;                     ///< Metrics textfile path.
+  std::unique_ptr<MetricsServer> metrics_server_;  ///< Active HTTP endpoint.
+  std::unique_ptr<MetricsTextfile> metrics_file_;  ///< Active textfile.
+  bool perf_counters_ = false;            ///< Sample hardware counters.
+  bool cost_model_ = false;               ///< Sum operation costs.
+  bool cold_cache_ = false;               ///< Drop pages between iterations.
+  bool track_memory_ = false;              ///< Count cv::Mat memory.
+  MemoryReport memory_report_;             ///< Memory report of last run.
+  std::unique_ptr<SlowTaskLog> slow_tasks_; ///< Slowest-task recorder.
+  std::atomic<bool> perf_warned_{false};  ///< Unavailability reported.
+
+  /// Interval between monitor samples.
+  static constexpr std::chrono::milliseconds kSamplePeriod{10};
+
+  /// Monitor samples between two RSS samples.
+  static constexpr uint64_t kRssEvery = 10;
+
+  /// Interval between two rewrites of the metrics textfile.
+  static constexpr std::chrono::milliseconds kMetricsFilePeriod{5000};
 };
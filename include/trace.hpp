@@ -0,0 +1,125 @@
+/**
+ * @file trace.hpp
+ * @brief Per-thread timeline recording and Chrome trace-event export.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ *
+ * Each worker thread appends fixed-size span records to its own TraceBuffer,
+ * a single-writer ring that never locks or allocates once constructed. After
+ * the workers have been joined, Tracer walks every buffer and writes a Chrome
+ * trace-event JSON file that can be opened in chrome://tracing or Perfetto.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A single completed span.
+ */
+struct TraceEvent {
+  uint64_t start_ns;  ///< Start time (steady clock, nanoseconds).
+  uint64_t dur_ns;    ///< Duration in nanoseconds.
+  uint32_t id;        ///< Span identifier (see TraceSpan in profiler.hpp).
+};
+
+/**
+ * @class TraceBuffer
+ * @brief Fixed-capacity single-writer ring buffer of trace events.
+ *
+ * Only the owning thread appends. When the ring is full the oldest events are
+ * overwritten and counted as dropped, so memory stays bounded on long runs.
+ */
+class TraceBuffer {
+ public:
+  /**
+   * @brief Construct a ring holding up to a given number of events.
+   * @param capacity Number of events (rounded up to a power of two).
+   */
+  explicit TraceBuffer(size_t capacity = 0);
+
+  TraceBuffer(TraceBuffer&& other) noexcept;
+  TraceBuffer& operator=(TraceBuffer&& other) noexcept;
+
+  /**
+   * @brief Append a span.
+   * @param id Span identifier.
+   * @param start_ns Start time in nanoseconds.
+   * @param end_ns End time in nanoseconds.
+   */
+  void record(uint32_t id, uint64_t start_ns, uint64_t end_ns) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    events_[head & mask_] = TraceEvent{start_ns, end_ns - start_ns, id};
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  /// @return Number of events currently held (at most the capacity).
+  size_t size() const;
+
+  /// @return Number of events overwritten because the ring was full.
+  uint64_t dropped() const;
+
+  /**
+   * @brief Access held events from oldest to newest.
+   * @param i Index in [0, size()).
+   */
+  const TraceEvent& at(size_t i) const;
+
+ private:
+  std::vector<TraceEvent> events_;  ///< Ring storage.
+  uint64_t mask_ = 0;               ///< Capacity - 1.
+  std::atomic<uint64_t> head_{0};   ///< Total events ever recorded.
+};
+
+/**
+ * @class Tracer
+ * @brief Owns one TraceBuffer per thread and exports them as Chrome JSON.
+ */
+class Tracer {
+ public:
+  static constexpr size_t kDefaultCapacity = 1 << 18;  ///< Events per thread.
+
+  /**
+   * @brief Construct a tracer.
+   * @param eventsPerThread Ring capacity of each thread's buffer.
+   */
+  explicit Tracer(size_t eventsPerThread = kDefaultCapacity);
+
+  /**
+   * @brief Prepare buffers for a run, discarding previous events.
+   * @param threadNames Display name of each traced thread.
+   * @param opLabels Operation labels used to name operation spans.
+   */
+  void reset(std::vector<std::string> threadNames,
+             std::vector<std::string> opLabels);
+
+  /**
+   * @brief Buffer of a traced thread.
+   * @param thread Index in the threadNames passed to reset().
+   */
+  TraceBuffer& buffer(size_t thread) { return buffers_[thread]; }
+
+  /// @return Total events dropped across all buffers.
+  uint64_t dropped() const;
+
+  /**
+   * @brief Write all recorded spans as Chrome trace-event JSON.
+   * @param out Output stream.
+   */
+  void writeChromeJson(std::ostream& out) const;
+
+ private:
+  /// @brief Display name and category of a span identifier.
+  std::pair<std::string, const char*> spanName(uint32_t id) const;
+
+  size_t capacity_;                       ///< Events per thread.
+  uint64_t origin_ns_ = 0;                ///< Time origin of the run.
+  std::vector<TraceBuffer> buffers_;      ///< Per-thread rings.
+  std::vector<std::string> thread_names_; ///< Per-thread display names.
+  std::vector<std::string> op_labels_;    ///< Operation labels.
+};
@@ -0,0 +1,337 @@
+/**
+ * @file advisor.cpp
+ * @brief Implementation of the bottleneck advisor defined in advisor.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/advisor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+/// Utilisation above which a side is considered saturated.
+constexpr double kSaturated = 0.8;
+
+/// Blocked fraction above which waiting is considered significant.
+constexpr double kBlocked = 0.25;
+
+/// Number of operations named for an augment-bound run.
+constexpr size_t kTopOps = 3;
+
+std::string percent(double fraction) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(0) << 100.0 * fraction << "%";
+  return out.str();
+}
+
+double ratio(double part, double whole) { return whole > 0 ? part / whole : 0; }
+
+/* Smallest thread count doing `work` per image at the pace of `pace` */
+size_t threadsFor(double work, double pace) {
+  if (pace <= 0) return 1;
+  return std::max<size_t>(1, static_cast<size_t>(std::ceil(work / pace - 1e-9)));
+}
+
+std::string lower(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+  return s;
+}
+
+}  // namespace
+
+const char* bottleneckName(Bottleneck bottleneck) {
+  switch (bottleneck) {
+    case Bottleneck::Decode: return "decode-bound";
+    case Bottleneck::Augment: return "augment-bound";
+    case Bottleneck::Encode: return "encode-bound";
+    case Bottleneck::Io: return "I/O-bound";
+    case Bottleneck::Feeder: return "feeder-starved";
+    default: return "undetermined";
+  }
+}
+
+Diagnosis diagnoseRun(const RunProfile& profile,
+                      const std::vector<QueueReport>& queues,
+                      const RunShape& shape) {
+  Diagnosis d;
+  uint64_t wall = profile.wallTime();
+  uint64_t images = profile.completed();
+  if (wall == 0 || images == 0 || queues.size() < 2) {
+    d.detail = "no image completed, nothing to diagnose";
+    return d;
+  }
+  const QueueReport& paths = queues[0];
+  const QueueReport& imageq = queues[1];
+
+  auto busy = [&](Stage s) {
+    return static_cast<double>(profile.stage(s).total());
+  };
+  double read = busy(Stage::Read), decode = busy(Stage::Decode),
+         augment = busy(Stage::Augment), encode = busy(Stage::Encode),
+         write = busy(Stage::Write);
+  double producer_busy = read + decode + augment;
+  double writer_busy = encode + write;
+  double all_busy = producer_busy + writer_busy;
+  for (size_t s = 0; s < kStageCount; ++s)
+    d.stage_share[s] = ratio(busy(static_cast<Stage>(s)), all_busy);
+
+  size_t producers = std::max<size_t>(1, shape.producers);
+  size_t writers = std::max<size_t>(1, shape.writers);
+  d.producer_utilisation = ratio(producer_busy, static_cast<double>(wall) * producers);
+  d.writer_utilisation = ratio(writer_busy, static_cast<double>(wall) * writers);
+  d.producers_starved = paths.popBlockedFraction(wall);
+  d.producers_blocked = imageq.pushBlockedFraction(wall);
+  d.writer_starved = imageq.popBlockedFraction(wall);
+
+  std::vector<size_t> order;
+  for (size_t i = 0; i < profile.ops().size(); ++i)
+    if (profile.ops()[i].total()) order.push_back(i);
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return profile.ops()[a].total() > profile.ops()[b].total();
+  });
+  if (order.size() > kTopOps) order.resize(kTopOps);
+
+  // Classify: the writer side first, since a full image queue hides
+  // everything upstream of it
+  bool writer_bound =
+      d.writer_utilisation >= d.producer_utilisation &&
+      (d.producers_blocked > kBlocked || d.writer_utilisation > kSaturated);
+  bool feeder_bound = !writer_bound && d.producers_starved > kBlocked &&
+                      d.producer_utilisation < kSaturated;
+  if (writer_bound) {
+    if (encode >= write) {
+      d.bottleneck = Bottleneck::Encode;
+      d.detail = "the writer was " + percent(d.writer_utilisation) +
+                 " busy, " + percent(ratio(encode, writer_busy)) +
+                 " of it encoding";
+    } else {
+      d.bottleneck = Bottleneck::Io;
+      d.detail = "the writer was " + percent(d.writer_utilisation) +
+                 " busy, " + percent(ratio(write, writer_busy)) +
+                 " of it writing files";
+    }
+    if (d.producers_blocked > 0)
+      d.detail += "; producers waited " + percent(d.producers_blocked) +
+                  " of their time on a full image queue";
+  } else if (feeder_bound) {
+    d.bottleneck = Bottleneck::Feeder;
+    d.detail = "producers waited " + percent(d.producers_starved) +
+               " of their time for paths to be queued";
+  } else {
+    double top = std::max({read, decode, augment});
+    std::string share = percent(ratio(top, producer_busy));
+    if (top == augment) {
+      d.bottleneck = Bottleneck::Augment;
+      d.top_ops = order;
+      d.detail = "producers were " + percent(d.producer_utilisation) +
+                 " busy, " + share + " of it in the pipeline";
+    } else if (top == decode) {
+      d.bottleneck = Bottleneck::Decode;
+      d.detail = "producers were " + percent(d.producer_utilisation) +
+                 " busy, " + share + " of it decoding";
+    } else {
+      d.bottleneck = Bottleneck::Io;
+      d.detail = "producers were " + percent(d.producer_utilisation) +
+                 " busy, " + share + " of it reading files";
+    }
+    if (d.writer_starved > 0)
+      d.detail += "; the writer waited " + percent(d.writer_starved) +
+                  " of its time for images";
+  }
+
+  // Per-image work of each side, used to balance thread counts
+  double producer_work = producer_busy / images;
+  double writer_work = writer_busy / images;
+  size_t cores = std::max<size_t>(2, shape.hardware_threads);
+  auto recommend = [&](std::string setting, size_t current, size_t suggested,
+                       std::string reason) {
+    if (suggested == current) return;
+    d.recommendations.push_back(Recommendation{std::move(setting),
+                                               std::to_string(current),
+                                               std::to_string(suggested),
+                                               std::move(reason)});
+  };
+
+  // Writers needed to keep pace with a given producer count, leaving the
+  // producers their cores
+  auto writersFor = [&](size_t target) {
+    size_t room = cores > target ? cores - target : 1;
+    return std::max(writers,
+                    std::min(threadsFor(writer_work * target, producer_work),
+                             std::max(room, cores / 2)));
+  };
+  auto recommendWriters = [&](size_t target, size_t suggested) {
+    if (suggested > writers)
+      recommend("num_writers", writers, suggested,
+                "one writer needs " + formatDuration(writer_work) +
+                    " per image, " + std::to_string(target) +
+                    " producers deliver one every " +
+                    formatDuration(producer_work / target));
+  };
+
+  size_t target_producers = producers;
+  switch (d.bottleneck) {
+    case Bottleneck::Encode:
+    case Bottleneck::Io:
+      if (writer_bound) {
+        size_t target_writers = writersFor(producers);
+        recommendWriters(producers, target_writers);
+        // Producers beyond what the writers can absorb only fill the queue
+        target_producers =
+            std::min(producers, threadsFor(producer_work * target_writers,
+                                           writer_work));
+        recommend("num_threads", producers, target_producers,
+                  "producers outpace " + std::to_string(target_writers) +
+                      " writer(s); the extra threads only wait on the image "
+                      "queue");
+        break;
+      }
+      // Reading files: more threads overlap I/O latency
+      target_producers =
+          std::max(producers, std::min(2 * cores, producers * 2));
+      recommend("num_threads", producers, target_producers,
+                "reads dominate producer time; more threads overlap file "
+                "I/O");
+      recommendWriters(target_producers, writersFor(target_producers));
+      break;
+    case Bottleneck::Decode:
+    case Bottleneck::Augment:
+      if (producers + writers < cores) {
+        target_producers = cores - writers;
+        recommend("num_threads", producers, target_producers,
+                  "producers are the bottleneck and " +
+                      std::to_string(cores - producers - writers) +
+                      " hardware threads were idle");
+        recommendWriters(target_producers, writersFor(target_producers));
+      }
+      break;
+    case Bottleneck::Feeder:
+      target_producers = std::max<size_t>(
+          1, static_cast<size_t>(std::ceil(
+                 producers * (1.0 - d.producers_starved))));
+      recommend("num_threads", producers, target_producers,
+                "producers were idle waiting for paths; fewer threads do the "
+                "same work");
+      break;
+    default:
+      break;
+  }
+
+  // Image queue: deep enough to absorb bursts, no deeper than useful
+  size_t capacity = shape.queue_capacity;
+  size_t floor_capacity = std::max<size_t>(8, 2 * target_producers);
+  if (writer_bound && imageq.series.fullFraction() > 0.5 &&
+      capacity > floor_capacity) {
+    recommend("queue_capacity", capacity, floor_capacity,
+              "the queue was full " + percent(imageq.series.fullFraction()) +
+                  " of the time; every slot only holds a decoded image in "
+                  "memory");
+  } else if (d.producers_blocked > 0.1 && d.writer_starved > 0.1) {
+    recommend("queue_capacity", capacity, 2 * capacity,
+              "producers and writer blocked on each other in turn; a deeper "
+              "queue absorbs bursts");
+  } else if (!writer_bound && imageq.stats.max_depth * 4 < capacity &&
+             capacity > floor_capacity) {
+    recommend("queue_capacity", capacity,
+              std::max(floor_capacity, 2 * imageq.stats.max_depth),
+              "the queue never held more than " +
+                  std::to_string(imageq.stats.max_depth) + " images");
+  }
+
+  // Output format: trade encode time against bytes written
+  std::string ext = lower(shape.output_ext);
+  bool compressed = ext == ".jpg" || ext == ".jpeg" || ext == ".webp";
+  std::string per_image =
+      std::to_string(profile.bytesOut() / images / 1024) + " KiB per image";
+  if (d.bottleneck == Bottleneck::Encode) {
+    if (ext == ".png" || ext == ".webp")
+      d.recommendations.push_back(Recommendation{
+          "output_format", ext, ".jpg",
+          "encoding dominates the writer; JPEG encodes several times faster"});
+    else if (compressed && write * 4 < encode)
+      d.recommendations.push_back(Recommendation{
+          "output_format", ext, ".bmp",
+          "encoding dominates and writes are cheap (" + per_image +
+              "); uncompressed output skips encoding at the cost of larger "
+              "files"});
+  } else if (d.bottleneck == Bottleneck::Io && writer_bound && !compressed) {
+    d.recommendations.push_back(Recommendation{
+        "output_format", ext, ".jpg",
+        "writing " + per_image + " dominates the writer; JPEG output is "
+        "several times smaller"});
+  }
+  return d;
+}
+
+/** ---------------- Reporting ---------------- **/
+void writeAdviceText(std::ostream& out, const Diagnosis& d,
+                     const std::vector<std::string>& opLabels) {
+  out << "[ADVICE] Run was " << bottleneckName(d.bottleneck) << ": "
+      << d.detail << "\n";
+  if (d.bottleneck == Bottleneck::Unknown) return;
+
+  out << "  producers " << percent(d.producer_utilisation) << " busy ("
+      << percent(d.producers_starved) << " waiting for paths, "
+      << percent(d.producers_blocked) << " on a full image queue); writer "
+      << percent(d.writer_utilisation) << " busy ("
+      << percent(d.writer_starved) << " waiting for images)\n";
+  out << "  busy time:";
+  for (size_t s = 0; s < kStageCount; ++s)
+    out << " " << stageName(static_cast<Stage>(s)) << " "
+        << percent(d.stage_share[s]);
+  out << "\n";
+  if (!d.top_ops.empty()) {
+    out << "  top operations:";
+    for (size_t i : d.top_ops)
+      out << " #" << i << " " << (i < opLabels.size() ? opLabels[i] : "?");
+    out << "\n";
+  }
+  if (d.recommendations.empty()) {
+    out << "  no configuration change recommended\n";
+    return;
+  }
+  for (const Recommendation& r : d.recommendations)
+    out << "  " << r.setting << ": " << r.current << " -> " << r.suggested
+        << " (" << r.reason << ")\n";
+}
+
+void writeAdviceJson(JsonWriter& json, const Diagnosis& d,
+                     const std::vector<std::string>& opLabels) {
+  json.beginObject()
+      .field("bottleneck", bottleneckName(d.bottleneck))
+      .field("detail", d.detail)
+      .field("producer_utilisation", d.producer_utilisation)
+      .field("writer_utilisation", d.writer_utilisation)
+      .field("producers_starved", d.producers_starved)
+      .field("producers_blocked", d.producers_blocked)
+      .field("writer_starved", d.writer_starved);
+
+  json.key("stage_share").beginObject();
+  for (size_t s = 0; s < kStageCount; ++s)
+    json.field(stageName(static_cast<Stage>(s)), d.stage_share[s]);
+  json.endObject();
+
+  json.key("top_operations").beginArray();
+  for (size_t i : d.top_ops)
+    json.beginObject()
+        .field("index", i)
+        .field("name", i < opLabels.size() ? opLabels[i] : std::string("?"))
+        .endObject();
+  json.endArray();
+
+  json.key("recommendations").beginArray();
+  for (const Recommendation& r : d.recommendations)
+    json.beginObject()
+        .field("setting", r.setting)
+        .field("current", r.current)
+        .field("suggested", r.suggested)
+        .field("reason", r.reason)
+        .endObject();
+  json.endArray();
+  json.endObject();
+}
@@ -0,0 +1,257 @@
+/**
+ * @file augmenter.cpp
+ * @brief Implementation of the Augmenter class defined in augmenter.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/augmenter.hpp"
+
+#include <algorithm>
+
+#include "../include/mem_tracker.hpp"
+
+/** Augmenter constructor **/
+Augmenter::Augmenter(Pipeline pipeline, size_t numWorkers,
+                     size_t queueCapacity)
+    : pipeline_(std::move(pipeline)), tasks_(queueCapacity) {
+  if (numWorkers == 0)
+    throw std::invalid_argument(
+        "Augmenter: number of workers must be at least 1.");
+  // Sized before any worker starts, so the references stay valid
+  profiles_.assign(numWorkers, ThreadProfile(pipeline_.size()));
+  for (size_t i = 0; i < numWorkers; ++i)
+    workers_.emplace_back([this, i] { work(profiles_[i]); });
+}
+
+/** Augmenter destructor **/
+Augmenter::~Augmenter() {
+  tasks_.setDone();
+  for (auto& t : workers_)
+    if (t.joinable()) t.join();
+}
+
+/** Future fulfilled by the callback it comes with **/
+static std::pair<std::future<AugmentedBatch>, Augmenter::Callback>
+promiseCallback() {
+  auto promise = std::make_shared<std::promise<AugmentedBatch>>();
+  std::future<AugmentedBatch> result = promise->get_future();
+  return {std::move(result), [promise](AugmentedBatch&& done) {
+            promise->set_value(std::move(done));
+          }};
+}
+
+/** Augmenter submit decoded batch (future) **/
+std::future<AugmentedBatch> Augmenter::submit(std::vector<cv::Mat> batch) {
+  auto [result, done] = promiseCallback();
+  enqueue(std::move(batch), {}, {}, std::move(done), {}, nullptr);
+  return std::move(result);
+}
+
+/** Augmenter submit decoded batch (callback) **/
+void Augmenter::submit(std::vector<cv::Mat> batch, Callback done) {
+  enqueue(std::move(batch), {}, {}, std::move(done), {}, nullptr);
+}
+
+/** Augmenter submit decoded batch (with options) **/
+void Augmenter::submit(std::vector<cv::Mat> batch, BatchOptions options,
+                       Callback done) {
+  enqueue(std::move(batch), {}, {}, std::move(done), std::move(options), nullptr);
+}
+
+/** Augmenter submit decoded batch (collated) **/
+std::future<AugmentedBatch> Augmenter::submit(std::vector<cv::Mat> batch,
+                                              BatchCollator& into) {
+  auto [result, done] = promiseCallback();
+  enqueue(std::move(batch), {}, {}, std::move(done), {}, &into);
+  return std::move(result);
+}
+
+/** Augmenter submit encoded batch (future) **/
+std::future<AugmentedBatch> Augmenter::submitEncoded(
+    std::vector<std::vector<uchar>> batch) {
+  auto [result, done] = promiseCallback();
+  enqueue({}, std::move(batch), {}, std::move(done), {}, nullptr);
+  return std::move(result);
+}
+
+/** Augmenter submit encoded batch (callback) **/
+void Augmenter::submitEncoded(std::vector<std::vector<uchar>> batch,
+                              Callback done) {
+  enqueue({}, std::move(batch), {}, std::move(done), {}, nullptr);
+}
+
+/** Augmenter submit encoded batch (with options) **/
+void Augmenter::submitEncoded(std::vector<std::vector<uchar>> batch,
+                              BatchOptions options, Callback done) {
+  enqueue({}, std::move(batch), {}, std::move(done), std::move(options), nullptr);
+}
+
+/** Augmenter submit encoded batch (collated) **/
+std::future<AugmentedBatch> Augmenter::submitEncoded(
+    std::vector<std::vector<uchar>> batch, BatchCollator& into) {
+  auto [result, done] = promiseCallback();
+  enqueue({}, std::move(batch), {}, std::move(done), {}, &into);
+  return std::move(result);
+}
+
+/** Augmenter submit image files (with options) **/
+void Augmenter::submitFiles(std::vector<std::string> paths,
+                            BatchOptions options, Callback done) {
+  enqueue({}, {}, std::move(paths), std::move(done), std::move(options),
+          nullptr);
+}
+
+/** Augmenter worker count accessor **/
+size_t Augmenter::workers() const { return workers_.size(); }
+
+/** Augmenter snapshot function **/
+ProgressSnapshot Augmenter::snapshot() const {
+  ProgressSnapshot snap;
+  for (const auto& p : profiles_) snap.add(p);
+  snap.image_depth = tasks_.size();
+  snap.image_capacity = tasks_.capacity();
+  return snap;
+}
+
+/** Augmenter enqueue function **/
+void Augmenter::enqueue(std::vector<cv::Mat> images,
+                        std::vector<std::vector<uchar>> encoded,
+                        std::vector<std::string> paths, Callback done,
+                        BatchOptions options, BatchCollator* collator) {
+  size_t size = std::max({images.size(), encoded.size(), paths.size()});
+  if (!options.seeds.empty() && options.seeds.size() != size)
+    throw std::invalid_argument("Augmenter: expected one seed per image.");
+  if (collator && size > collator->batchSize())
+    throw std::invalid_argument("Augmenter: batch of " + std::to_string(size) +
+                                " images exceeds the collator's " +
+                                std::to_string(collator->batchSize()) + ".");
+  if (size == 0) {
+    if (done) done(AugmentedBatch());
+    return;
+  }
+  auto state = std::make_shared<Batch>();
+  if (!options.encode.empty())
+    state->result.encoded.resize(size);
+  else if (!collator)
+    state->result.images.resize(size);
+  state->result.histories.resize(size);
+  state->remaining = size;
+  state->done = std::move(done);
+  state->options = std::move(options);
+  state->collator = collator;
+
+  uint64_t arrival = nowNs();
+  for (size_t i = 0; i < size; ++i) {
+    Task task;
+    task.batch = state;
+    task.index = i;
+    if (i < images.size()) task.image = std::move(images[i]);
+    if (i < encoded.size()) task.encoded = std::move(encoded[i]);
+    if (i < paths.size()) task.path = std::move(paths[i]);
+    task.arrival_ns = arrival;
+    tasks_.push(std::move(task));
+  }
+}
+
+/** Augmenter worker loop **/
+void Augmenter::work(ThreadProfile& profile) {
+  Task task;
+  while (tasks_.pop(task)) {
+    process(task, profile);
+    // The last image of a batch hands it over; release the rest promptly
+    std::shared_ptr<Batch> batch = std::move(task.batch);
+    task = Task();
+    if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+      continue;
+    batch->result.failures = batch->failures.load();
+    if (!batch->done) continue;
+    try {
+      batch->done(std::move(batch->result));
+    } catch (const std::exception& e) {
+      std::cerr << "[ERROR] Augmenter callback failed: " << e.what()
+                << std::endl;
+    } catch (...) {
+      // Anything escaping here would terminate the process
+      std::cerr << "[ERROR] Augmenter callback failed with a non-standard "
+                   "exception."
+                << std::endl;
+    }
+  }
+}
+
+/** Augmenter process one task **/
+void Augmenter::process(Task& task, ThreadProfile& profile) {
+  try {
+    uint64_t t0 = nowNs();
+    uint64_t read = t0;
+    Image img;
+    if (!task.path.empty()) {
+      if (Image::readFile(task.path, task.encoded) != 0)
+        throw std::runtime_error("could not read " + task.path);
+      read = nowNs();
+      profile.recordStage(Stage::Read, t0, read);
+    }
+    if (task.image.empty()) {
+      profile.recordBytesIn(task.encoded.size());
+      MemTracker::setStage(MemStage::Decode);
+      if (img.decode(task.encoded) != 0)
+        throw std::runtime_error("could not decode image");
+    } else {
+      img = Image(task.image);
+    }
+    uint64_t t1 = nowNs();
+    const BatchOptions& options = task.batch->options;
+    MemTracker::setStage(MemStage::Augment);
+    if (options.seeds.empty() && !options.pipeline) {
+      pipeline_.apply(img, profile);
+    } else {
+      const Pipeline& pipeline =
+          options.pipeline ? *options.pipeline : pipeline_;
+      uint64_t seed = options.seeds.empty() ? nowNs() ^ task.index
+                                            : options.seeds[task.index];
+      std::seed_seq seq{static_cast<uint32_t>(seed),
+                        static_cast<uint32_t>(seed >> 32)};
+      std::mt19937 rand(seq);
+      pipeline.apply(img, rand);
+    }
+    MemTracker::setStage(MemStage::Other);
+    uint64_t t2 = nowNs();
+
+    if (!task.encoded.empty()) profile.recordStage(Stage::Decode, read, t1);
+    profile.recordStage(Stage::Augment, t1, t2);
+    profile.recordSojourn(Sojourn::Admission, t0 - task.arrival_ns);
+    if (!options.encode.empty()) {
+      std::vector<uchar>& out = task.batch->result.encoded[task.index];
+      if (img.encode(out, options.encode) != 0)
+        throw std::runtime_error("could not encode image as " +
+                                 options.encode);
+      profile.recordStage(Stage::Encode, t2, nowNs());
+      profile.recordBytesOut(out.size());
+    } else if (task.batch->collator) {
+      task.batch->collator->put(task.index, img.getData());
+    } else {
+      task.batch->result.images[task.index] = std::move(img.getData());
+    }
+    profile.recordSojourn(Sojourn::EndToEnd, nowNs() - task.arrival_ns);
+    task.batch->result.histories[task.index] = img.getHistory();
+    profile.recordCompleted();
+  } catch (const std::exception& e) {
+    fail(task, profile, e.what());
+  } catch (...) {
+    // Anything escaping here would terminate the worker's process
+    fail(task, profile, "non-standard exception");
+  }
+}
+
+/** Augmenter record one failed task **/
+void Augmenter::fail(Task& task, ThreadProfile& profile, const char* reason) {
+  MemTracker::setStage(MemStage::Other);
+  if (task.batch->collator) task.batch->collator->clear(task.index);
+  if (!task.batch->options.encode.empty())
+    task.batch->result.encoded[task.index].clear();
+  profile.recordFailure();
+  task.batch->failures.fetch_add(1, std::memory_order_relaxed);
+  std::cerr << "[WARN] Failed to augment image " << task.index
+            << " of batch: " << reason << std::endl;
+}
@@ -0,0 +1,318 @@
+/**
+ * @file estimator.cpp
+ * @brief Implementation of the dry-run cost estimate defined in
+ * estimator.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/estimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include "../include/mem_tracker.hpp"
+#include "../include/metrics.hpp"
+
+namespace {
+
+/// Two-sided 95% normal quantile for the wall-time interval.
+constexpr double kZ95 = 1.96;
+
+/* Wall-clock length: short units below a minute, then "1h 02m 03s" */
+std::string formatWall(double ns) {
+  if (ns < 60e9) return formatDuration(ns);
+  uint64_t s = static_cast<uint64_t>(ns / 1e9 + 0.5);
+  std::ostringstream out;
+  if (s >= 3600) out << s / 3600 << "h ";
+  out << std::setfill('0') << std::setw(2) << s / 60 % 60 << "m "
+      << std::setw(2) << s % 60 << "s";
+  return out.str();
+}
+
+std::string formatBytes(double bytes) {
+  static const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+  size_t u = 0;
+  while (bytes >= 1024 && u + 1 < sizeof(units) / sizeof(units[0])) {
+    bytes /= 1024;
+    ++u;
+  }
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(u ? 1 : 0) << bytes << " " << units[u];
+  return out.str();
+}
+
+std::string percent(double fraction) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(0) << 100.0 * fraction << "%";
+  return out.str();
+}
+
+double mean(const std::vector<double>& v) {
+  double sum = 0;
+  for (double x : v) sum += x;
+  return v.empty() ? 0.0 : sum / v.size();
+}
+
+/* Standard error of the mean */
+double stderrOf(const std::vector<double>& v) {
+  if (v.size() < 2) return 0.0;
+  double m = mean(v), acc = 0;
+  for (double x : v) acc += (x - m) * (x - m);
+  return std::sqrt(acc / (v.size() - 1) / v.size());
+}
+
+/* Time per task of the slowest side: producers, writers, or all CPUs */
+double perTask(double producer_ns, double writer_ns, const RunShape& shape,
+               std::string* bound) {
+  double producers = producer_ns / std::max<size_t>(1, shape.producers);
+  double writers = writer_ns / std::max<size_t>(1, shape.writers);
+  double cpu = (producer_ns + writer_ns) /
+               std::max<size_t>(1, shape.hardware_threads);
+  double slowest = std::max({producers, writers, cpu});
+  if (bound)
+    *bound = slowest == cpu && cpu > std::max(producers, writers)
+                 ? "cpu"
+                 : (producers >= writers ? "producers" : "writers");
+  return slowest;
+}
+
+}  // namespace
+
+/** ---------------- Estimate ---------------- **/
+CostEstimate estimateRun(const std::vector<std::filesystem::path>& paths,
+                         Pipeline& pipeline, const EstimateSettings& settings) {
+  CostEstimate est;
+  est.inputs = paths.size();
+  est.tasks = paths.size() * static_cast<uint64_t>(
+                                 std::max(1, settings.iterations));
+  if (paths.empty()) return est;
+  for (const auto& path : paths)
+    ++est.formats[inputFormat(path.string())].inputs;
+
+  MemTracker& mem = MemTracker::instance();
+  mem.install();
+  est.baseline_rss = residentMemoryBytes();
+
+  std::mt19937 rng(settings.seed);
+  std::uniform_int_distribution<size_t> pick(0, paths.size() - 1);
+  ThreadProfile profile(pipeline.size()), warmup(pipeline.size());
+  std::vector<uchar> encoded, out;
+  std::vector<double> producer_ns, writer_ns;
+  double image_bytes = 0;
+
+  // Task 0 only warms up codecs, caches and the allocator
+  size_t samples = std::max<size_t>(1, settings.samples);
+  for (size_t i = 0; i <= samples; ++i) {
+    const std::filesystem::path& path = paths[pick(rng)];
+    try {
+      Image img;
+      mem.resetPeaks();
+      uint64_t live = mem.snapshot().live_bytes;
+      uint64_t t0 = nowNs();
+      if (Image::readFile(path.string(), encoded) != 0)
+        throw std::runtime_error("could not read file");
+      uint64_t t1 = nowNs();
+      if (img.decode(encoded) != 0)
+        throw std::runtime_error("could not decode image");
+      uint64_t t2 = nowNs();
+      int width = img.getData().cols, height = img.getData().rows;
+      pipeline.apply(img, i ? profile : warmup);
+      uint64_t t3 = nowNs();
+      if (img.encode(out, settings.shape.output_ext) != 0)
+        throw std::runtime_error("could not encode image");
+      uint64_t t4 = nowNs();
+      uint64_t peak = mem.snapshot().peak_bytes;
+      if (!i) continue;
+
+      profile.recordStage(Stage::Read, t0, t1);
+      profile.recordStage(Stage::Decode, t1, t2);
+      profile.recordStage(Stage::Augment, t2, t3);
+      profile.recordStage(Stage::Encode, t3, t4);
+      InputFormat format = inputFormatOf(path.string());
+      profile.recordFormatInput(format, encoded.size(),
+                                static_cast<uint64_t>(width) * height,
+                                t1 - t0, t2 - t1);
+      profile.recordFormatOutput(format, out.size(), t4 - t3, 0);
+      producer_ns.push_back(static_cast<double>(t3 - t0));
+      writer_ns.push_back(static_cast<double>(t4 - t3));
+      double working_set = static_cast<double>(peak > live ? peak - live : 0);
+      est.task_peak_bytes = std::max(est.task_peak_bytes, working_set);
+      image_bytes +=
+          static_cast<double>(img.getData().total() * img.getData().elemSize());
+    } catch (const std::exception& e) {
+      if (i) ++est.failures;
+      std::cerr << "[WARN] Dry run could not process " << path << ": "
+                << e.what() << std::endl;
+    }
+  }
+  est.samples = producer_ns.size();
+  if (!est.samples) return est;
+
+  // Time
+  for (size_t s = 0; s < kStageCount; ++s)
+    est.stage_ns[s] = profile.stage(static_cast<Stage>(s)).mean();
+  est.producer_ns = mean(producer_ns);
+  est.writer_ns = mean(writer_ns);
+  double tasks = static_cast<double>(est.tasks);
+  est.wall_ns = tasks * perTask(est.producer_ns, est.writer_ns,
+                                settings.shape, &est.bound);
+  double dp = kZ95 * stderrOf(producer_ns), dw = kZ95 * stderrOf(writer_ns);
+  est.wall_low_ns = tasks * perTask(std::max(0.0, est.producer_ns - dp),
+                                    std::max(0.0, est.writer_ns - dw),
+                                    settings.shape, nullptr);
+  est.wall_high_ns = tasks * perTask(est.producer_ns + dp, est.writer_ns + dw,
+                                     settings.shape, nullptr);
+
+  // Output, per input format; unsampled formats use the overall mean
+  double mean_out = 0;
+  for (const FormatTotals& totals : profile.formats())
+    mean_out += static_cast<double>(totals.bytes_out);
+  mean_out /= static_cast<double>(est.samples);
+  for (auto& [format, f] : est.formats) {
+    const FormatTotals* sampled = nullptr;
+    for (size_t i = 0; i < kInputFormatCount; ++i)
+      if (format == formatName(static_cast<InputFormat>(i)))
+        sampled = &profile.formats()[i];
+    if (sampled && sampled->saved) {
+      f.sampled = sampled->saved;
+      f.bytes_in = static_cast<double>(sampled->bytes_in) / f.sampled;
+      f.bytes_out = static_cast<double>(sampled->bytes_out) / f.sampled;
+    } else {
+      f.bytes_out = mean_out;
+    }
+    f.total_bytes_out = f.bytes_out * static_cast<double>(f.inputs) *
+                        std::max(1, settings.iterations);
+    est.total_bytes_out += f.total_bytes_out;
+  }
+
+  // Memory: every producer at its working-set peak, plus full queue and
+  // writer batches of augmented images
+  est.image_bytes = image_bytes / static_cast<double>(est.samples);
+  double held = static_cast<double>(settings.shape.queue_capacity +
+                                    settings.shape.writers *
+                                        settings.writer_batch);
+  est.peak_memory = static_cast<double>(est.baseline_rss) +
+                    settings.shape.producers * est.task_peak_bytes +
+                    held * est.image_bytes;
+
+  // Operations
+  std::vector<std::string> labels = pipeline.operationLabels();
+  double op_total = 0;
+  for (const LatencyHistogram& h : profile.ops())
+    op_total += static_cast<double>(h.total());
+  for (size_t i = 0; i < profile.ops().size(); ++i) {
+    const LatencyHistogram& h = profile.ops()[i];
+    OpEstimate op;
+    op.label = i < labels.size() ? labels[i] : "?";
+    op.fire_rate = static_cast<double>(h.count()) / est.samples;
+    op.mean_ns = h.mean();
+    op.share = op_total > 0 ? static_cast<double>(h.total()) / op_total : 0;
+    est.ops.push_back(op);
+  }
+  return est;
+}
+
+/** ---------------- Reporting ---------------- **/
+void writeEstimateText(std::ostream& out, const CostEstimate& est,
+                       const RunShape& shape) {
+  std::ios::fmtflags flags = out.flags();
+  out << "[ESTIMATE] Sampled " << est.samples << " of " << est.tasks
+      << " tasks (" << est.inputs << " inputs)";
+  if (est.failures) out << ", " << est.failures << " failed";
+  out << "\n";
+  if (!est.samples) {
+    out << "  nothing to extrapolate from\n";
+    return;
+  }
+  out << "  per task:";
+  for (size_t s = 0; s < kStageCount; ++s)
+    if (static_cast<Stage>(s) != Stage::Write)
+      out << " " << stageName(static_cast<Stage>(s)) << " "
+          << formatDuration(est.stage_ns[s]);
+  out << " (write not measured)\n";
+  out << "  wall time: " << formatWall(est.wall_ns) << " (95% "
+      << formatWall(est.wall_low_ns) << " .. " << formatWall(est.wall_high_ns)
+      << ") with " << shape.producers << " producer(s) and " << shape.writers
+      << " writer(s), " << est.bound << "-bound\n";
+  out << "  output: " << formatBytes(est.total_bytes_out) << " as "
+      << shape.output_ext << "\n";
+  out << "    " << std::left << std::setw(8) << "format" << std::right
+      << std::setw(9) << "inputs" << std::setw(9) << "sampled"
+      << std::setw(12) << "in/img" << std::setw(12) << "out/img"
+      << std::setw(12) << "total" << "\n";
+  for (const auto& [format, f] : est.formats)
+    out << "    " << std::left << std::setw(8) << format << std::right
+        << std::setw(9) << f.inputs << std::setw(9) << f.sampled
+        << std::setw(12) << (f.sampled ? formatBytes(f.bytes_in) : "-")
+        << std::setw(12) << formatBytes(f.bytes_out) << std::setw(12)
+        << formatBytes(f.total_bytes_out) << "\n";
+  out << "  peak memory: ~" << formatBytes(est.peak_memory) << " (RSS now "
+      << formatBytes(static_cast<double>(est.baseline_rss)) << ", "
+      << formatBytes(est.task_peak_bytes) << " per producer, "
+      << formatBytes(est.image_bytes) << " per queued image)\n";
+  if (!est.ops.empty()) {
+    out << "  operations (share of augment time):\n";
+    for (size_t i = 0; i < est.ops.size(); ++i) {
+      const OpEstimate& op = est.ops[i];
+      out << "    " << std::left << std::setw(24)
+          << "#" + std::to_string(i) + " " + op.label << std::right
+          << " fired " << std::setw(4) << percent(op.fire_rate) << ", "
+          << std::setw(9) << formatDuration(op.mean_ns) << " each, "
+          << std::setw(4) << percent(op.share) << "\n";
+    }
+  }
+  out.flags(flags);
+}
+
+void writeEstimateJson(JsonWriter& json, const CostEstimate& est) {
+  json.beginObject()
+      .field("inputs", est.inputs)
+      .field("tasks", est.tasks)
+      .field("samples", est.samples)
+      .field("failures", est.failures)
+      .field("wall_ns", est.wall_ns)
+      .field("wall_low_ns", est.wall_low_ns)
+      .field("wall_high_ns", est.wall_high_ns)
+      .field("bound", est.bound)
+      .field("producer_ns", est.producer_ns)
+      .field("writer_ns", est.writer_ns)
+      .field("total_bytes_out", est.total_bytes_out)
+      .field("task_peak_bytes", est.task_peak_bytes)
+      .field("image_bytes", est.image_bytes)
+      .field("baseline_rss", est.baseline_rss)
+      .field("peak_memory", est.peak_memory);
+
+  json.key("stage_ns").beginObject();
+  for (size_t s = 0; s < kStageCount; ++s)
+    if (static_cast<Stage>(s) != Stage::Write)
+      json.field(stageName(static_cast<Stage>(s)), est.stage_ns[s]);
+  json.endObject();
+
+  json.key("formats").beginArray();
+  for (const auto& [format, f] : est.formats)
+    json.beginObject()
+        .field("format", format)
+        .field("inputs", f.inputs)
+        .field("sampled", f.sampled)
+        .field("bytes_in", f.bytes_in)
+        .field("bytes_out", f.bytes_out)
+        .field("total_bytes_out", f.total_bytes_out)
+        .endObject();
+  json.endArray();
+
+  json.key("operations").beginArray();
+  for (size_t i = 0; i < est.ops.size(); ++i)
+    json.beginObject()
+        .field("index", i)
+        .field("name", est.ops[i].label)
+        .field("fire_rate", est.ops[i].fire_rate)
+        .field("mean_ns", est.ops[i].mean_ns)
+        .field("share", est.ops[i].share)
+        .endObject();
+  json.endArray();
+  json.endObject();
+}
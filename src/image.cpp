@@ -7,6 +7,11 @@
 
 #include "../include/image.hpp"
 
+#ifdef __unix__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace fs = std::filesystem;
 
 /* Initialize global ID counter */
@@ -21,8 +26,8 @@ Image::Image(const cv::Mat& in, const std::string& name)
 
 /* Constructor from file path */
 Image::Image(const std::string& path) : name_(path), id_(global_id_++) {
-  data_ = cv::imread(path);
-  if (data_.empty()) {
+  std::vector<uchar> buf;
+  if (readFile(path, buf) != 0 || decode(buf) != 0) {
     std::cerr << "Error: Failed to load image from " << path << std::endl;
   }
 }
@@ -54,6 +59,12 @@ const std::array<int, 2> Image::getDimensions() const {
   return {data_.cols, data_.rows};
 }
 
+/* Return timing record */
+TaskTiming& Image::getTiming() { return timing_; }
+
+/* Return timing record (const) */
+const TaskTiming& Image::getTiming() const { return timing_; }
+
 /* Log new opeartion to history */
 void Image::logOperation(const std::string& op) { history_.emplace_back(op); }
 
@@ -71,22 +82,44 @@ int Image::preview(const std::string& window_name, int wait_ms) const {
   return 0;
 }
 
-/* Save image to specified path and extension */
-int Image::save(const std::string& path, const std::string& ext) const {
-  // Decide on output directory
-  fs::path out_dir = path.empty() ? fs::current_path() : fs::path(path);
+/* Read raw encoded bytes from file */
+int Image::readFile(const std::string& path, std::vector<uchar>& buf) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) return -1;
+  std::streamsize size = in.tellg();
+  if (size <= 0) return -1;
+  in.seekg(0, std::ios::beg);
+  buf.resize(static_cast<size_t>(size));
+  if (!in.read(reinterpret_cast<char*>(buf.data()), size)) return -1;
+  return 0;
+}
 
-  // Create output directory if it doesn't exist
-  if (!fs::exists(out_dir)) {
-    if (!fs::create_directories(out_dir)) return -1;
-  }
+/* Drop cached pages of a file */
+int Image::dropCache(const std::string& path) {
+#if defined(__unix__) && defined(POSIX_FADV_DONTNEED)
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return -1;
+  // Dirty pages are not dropped, so flush them first
+  fdatasync(fd);
+  int rc = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+  return rc == 0 ? 0 : -1;
+#else
+  (void)path;
+  return -1;
+#endif
+}
 
-  // Determine filename base
-  std::string base = name_.empty() ? "image" : fs::path(name_).stem().string();
-  std::string filename = base + "_" + std::to_string(id_) + ext;
+/* Decode image data from encoded buffer */
+int Image::decode(const std::vector<uchar>& buf) {
+  if (buf.empty()) return -1;
+  data_ = cv::imdecode(buf, cv::IMREAD_COLOR);
+  return data_.empty() ? -1 : 0;
+}
 
-  // Final output path
-  fs::path outputPath = out_dir / filename;
+/* Encode image data into buffer */
+int Image::encode(std::vector<uchar>& buf, const std::string& ext) const {
+  if (data_.empty()) return -1;
 
   // Decide on compression parameters
   std::vector<int> params;
@@ -102,60 +135,58 @@ int Image::save(const std::string& path, const std::string& ext) const {
     params = {cv::IMWRITE_WEBP_QUALITY, 80};
   }
 
-  // Save image (with or without params
-  bool success = params.empty()
-                     ? cv::imwrite(outputPath.string(), data_)
-                     : cv::imwrite(outputPath.string(), data_, params);
-
-  return success ? 0 : -1;
+  return cv::imencode(ext, data_, buf, params) ? 0 : -1;
 }
 
-/* Save image to specified path and extension, together with operation history
- */
-int Image::saveWithHistory(const std::string& path,
-                           const std::string& ext) const {
+/* Write encoded bytes (and optionally history) to disk */
+int Image::write(const std::vector<uchar>& buf, const std::string& path,
+                 const std::string& ext, bool with_history) const {
   // Decide on output directory
   fs::path out_dir = path.empty() ? fs::current_path() : fs::path(path);
 
-  // Create output directory if it doesn't exist
+  // Create output directory if it doesn't exist (another writer thread may
+  // create it concurrently)
   if (!fs::exists(out_dir)) {
-    if (!fs::create_directories(out_dir)) return -1;
+    std::error_code ec;
+    fs::create_directories(out_dir, ec);
+    if (!fs::is_directory(out_dir)) return -1;
   }
 
   // Determine filename base
   std::string base = name_.empty() ? "image" : fs::path(name_).stem().string();
-  std::string filename = base + "_" + std::to_string(id_) + ext;
+  std::string stem = base + "_" + std::to_string(id_);
 
-  // Final output path
-  fs::path outputPath = out_dir / filename;
-
-  // Decide on compression parameters
-  std::vector<int> params;
-  std::string lower_ext = ext;
-  std::transform(lower_ext.begin(), lower_ext.end(), lower_ext.begin(),
-                 ::tolower);
-
-  if (lower_ext == ".jpg" || lower_ext == ".jpeg")
-    params = {cv::IMWRITE_JPEG_QUALITY, 75};
-  else if (lower_ext == ".png")
-    params = {cv::IMWRITE_PNG_COMPRESSION, 1};
-  else if (lower_ext == ".webp") {
-    params = {cv::IMWRITE_WEBP_QUALITY, 80};
-  }
-
-  // Save image (with or without params
-  bool success = params.empty()
-                     ? cv::imwrite(outputPath.string(), data_)
-                     : cv::imwrite(outputPath.string(), data_, params);
+  // Write encoded image
+  std::ofstream out(out_dir / (stem + ext), std::ios::binary);
+  out.write(reinterpret_cast<const char*>(buf.data()),
+            static_cast<std::streamsize>(buf.size()));
+  // Close first: errors of the final flush (e.g. ENOSPC) only show up here
+  out.close();
+  bool success = static_cast<bool>(out);
 
   // Save operation history
-  std::string history_filename = base + "_" + std::to_string(id_) + ".txt";
-  fs::path history_path = out_dir / history_filename;
-  std::ofstream history_file(history_path);
-  for (const std::string& op : history_) {
-    history_file << op << "\n";
+  if (with_history) {
+    std::ofstream history_file(out_dir / (stem + ".txt"));
+    for (const std::string& op : history_) {
+      history_file << op << "\n";
+    }
   }
-  history_file.close();
 
   return success ? 0 : -1;
 }
+
+/* Save image to specified path and extension */
+int Image::save(const std::string& path, const std::string& ext) const {
+  std::vector<uchar> buf;
+  if (encode(buf, ext) != 0) return -1;
+  return write(buf, path, ext);
+}
+
+/* Save image to specified path and extension, together with operation history
+ */
+int Image::saveWithHistory(const std::string& path,
+                           const std::string& ext) const {
+  std::vector<uchar> buf;
+  if (encode(buf, ext) != 0) return -1;
+  return write(buf, path, ext, true);
+}
@@ -72,6 +72,11 @@ ConfigSpec parseConfigFile(const std::string& json_path) {
           config.num_threads = 1;
       }
 
+      if (key == "num_writers") {
+        config.num_writers = static_cast<size_t>(uint64_t(field.value()));
+        if (!config.num_writers) config.num_writers = 1;
+      }
+
       if (key == "queue_capacity") {
         config.queue_capacity = static_cast<size_t>(uint64_t(field.value()));
         if (!config.queue_capacity || config.queue_capacity < 1)
@@ -86,6 +91,20 @@ ConfigSpec parseConfigFile(const std::string& json_path) {
         config.save_specs = bool(field.value());
       }
 
+      if (key == "progress_interval_ms") {
+        config.progress_interval_ms =
+            static_cast<size_t>(uint64_t(field.value()));
+      }
+
+      if (key == "output_format") {
+        config.output_format =
+            std::string(field.value().get_string().value());
+        if (config.output_format.empty())
+          throw std::runtime_error("[ERROR] output_format is empty.");
+        if (config.output_format[0] != '.')
+          config.output_format.insert(0, 1, '.');
+      }
+
       if (key == "seed") {
         config.seed = static_cast<size_t>(uint64_t(field.value()));
       }
@@ -0,0 +1,154 @@
+/**
+ * @file json_writer.cpp
+ * @brief Implementation of the JsonWriter class defined in json_writer.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/json_writer.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+/* Constructor */
+JsonWriter::JsonWriter(std::ostream& out, bool pretty)
+    : out_(out), pretty_(pretty) {}
+
+/* Begin object */
+JsonWriter& JsonWriter::beginObject() {
+  separator();
+  out_ << '{';
+  first_.push_back(true);
+  return *this;
+}
+
+/* End object */
+JsonWriter& JsonWriter::endObject() {
+  bool empty = first_.back();
+  first_.pop_back();
+  if (!empty) newline();
+  out_ << '}';
+  if (first_.empty() && pretty_) out_ << '\n';
+  return *this;
+}
+
+/* Begin array */
+JsonWriter& JsonWriter::beginArray() {
+  separator();
+  out_ << '[';
+  first_.push_back(true);
+  return *this;
+}
+
+/* End array */
+JsonWriter& JsonWriter::endArray() {
+  bool empty = first_.back();
+  first_.pop_back();
+  if (!empty) newline();
+  out_ << ']';
+  if (first_.empty() && pretty_) out_ << '\n';
+  return *this;
+}
+
+/* Write key */
+JsonWriter& JsonWriter::key(std::string_view k) {
+  separator();
+  out_ << '"' << escape(k) << (pretty_ ? "\": " : "\":");
+  after_key_ = true;
+  return *this;
+}
+
+/* String values */
+JsonWriter& JsonWriter::value(std::string_view v) {
+  separator();
+  out_ << '"' << escape(v) << '"';
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(const char* v) {
+  return value(std::string_view(v));
+}
+
+JsonWriter& JsonWriter::value(const std::string& v) {
+  return value(std::string_view(v));
+}
+
+/* Floating-point value */
+JsonWriter& JsonWriter::value(double v) {
+  separator();
+  if (!std::isfinite(v)) {
+    out_ << "null";
+    return *this;
+  }
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.12g", v);
+  out_ << buf;
+  return *this;
+}
+
+/* Boolean value */
+JsonWriter& JsonWriter::value(bool v) {
+  separator();
+  out_ << (v ? "true" : "false");
+  return *this;
+}
+
+/* Null value */
+JsonWriter& JsonWriter::null() {
+  separator();
+  out_ << "null";
+  return *this;
+}
+
+/* Escape special characters */
+std::string JsonWriter::escape(std::string_view s) {
+  std::string res;
+  res.reserve(s.size());
+  for (char c : s) {
+    switch (c) {
+      case '"':
+        res += "\\\"";
+        break;
+      case '\\':
+        res += "\\\\";
+        break;
+      case '\n':
+        res += "\\n";
+        break;
+      case '\r':
+        res += "\\r";
+        break;
+      case '\t':
+        res += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+          res += buf;
+        } else {
+          res += c;
+        }
+    }
+  }
+  return res;
+}
+
+/* Separator before each element */
+void JsonWriter::separator() {
+  if (after_key_) {
+    after_key_ = false;
+    return;
+  }
+  if (first_.empty()) return;
+  if (!first_.back()) out_ << ',';
+  first_.back() = false;
+  newline();
+}
+
+/* Newline and indentation */
+void JsonWriter::newline() {
+  if (!pretty_) return;
+  out_ << '\n';
+  for (size_t i = 0; i < first_.size(); ++i) out_ << "  ";
+}
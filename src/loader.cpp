@@ -0,0 +1,205 @@
+/**
+ * @file loader.cpp
+ * @brief Implementation of the DataLoader defined in loader.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/loader.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+
+#include "../include/splitmix.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/* Key of one epoch; both its order and its samples derive from it */
+uint64_t epochKey(uint64_t seed, uint64_t epoch) {
+  return splitmix64(splitmix64(seed) ^ epoch);
+}
+
+/*
+ * Shuffle RNG defined here rather than std::shuffle, whose draws differ
+ * between standard libraries; orders must match wherever a run resumes.
+ */
+class OrderRng {
+ public:
+  explicit OrderRng(uint64_t key) : state_(key) {}
+
+  /* Uniform in [0, bound) */
+  size_t below(size_t bound) {
+    state_ += 0x9e3779b97f4a7c15ULL;
+    return static_cast<size_t>(splitmix64(state_) % bound);
+  }
+
+ private:
+  uint64_t state_;
+};
+
+}  // namespace
+
+/** ---------------- DataLoader ---------------- **/
+DataLoader::DataLoader(std::vector<std::string> manifest, Augmenter& augmenter,
+                       LoaderSettings settings)
+    : manifest_(std::move(manifest)),
+      augmenter_(augmenter),
+      settings_(settings) {
+  if (settings_.batch == 0)
+    throw std::invalid_argument("DataLoader: batch must be at least 1.");
+  if (manifest_.empty())
+    throw std::invalid_argument("DataLoader: manifest is empty.");
+  if (settings_.drop_last && manifest_.size() < settings_.batch)
+    throw std::invalid_argument(
+        "DataLoader: drop_last with fewer samples than one batch.");
+}
+
+/** DataLoader next batch **/
+bool DataLoader::next(LoaderBatch& out) {
+  topUp(std::max<size_t>(settings_.prefetch, 1));
+  if (in_flight_.empty()) return false;
+  InFlight& oldest = in_flight_.front();
+  out.epoch = oldest.epoch;
+  out.position = oldest.position;
+  out.indices = std::move(oldest.indices);
+  out.data = oldest.result.get();
+  in_flight_.pop_front();
+  // Keep the pool busy while the caller trains on this batch
+  topUp(settings_.prefetch);
+
+  next_epoch_ = out.epoch;
+  next_position_ = out.position + out.indices.size();
+  if (next_position_ >= epochSize()) {
+    ++next_epoch_;
+    next_position_ = 0;
+  }
+  return true;
+}
+
+/** DataLoader seek function **/
+void DataLoader::seek(uint64_t epoch, uint64_t position) {
+  in_flight_.clear();
+  if (position >= epochSize()) {
+    ++epoch;
+    position = 0;
+  }
+  submit_epoch_ = next_epoch_ = epoch;
+  submit_position_ = next_position_ = position;
+}
+
+/** DataLoader cursor accessors **/
+uint64_t DataLoader::epoch() const { return next_epoch_; }
+
+uint64_t DataLoader::position() const { return next_position_; }
+
+size_t DataLoader::batchesPerEpoch() const {
+  return (epochSize() + settings_.batch - 1) / settings_.batch;
+}
+
+/** DataLoader epoch order **/
+std::vector<size_t> DataLoader::epochOrder(uint64_t epoch) const {
+  size_t n = manifest_.size();
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  if (!settings_.shuffle) return order;
+  OrderRng rng(epochKey(settings_.seed, epoch));
+  size_t window = settings_.shuffle_buffer;
+  if (window == 0 || window >= n) {
+    // Fisher-Yates over the whole manifest
+    for (size_t i = n - 1; i > 0; --i)
+      std::swap(order[i], order[rng.below(i + 1)]);
+    return order;
+  }
+  // Streaming: emit a random buffered sample, refill with the next one
+  std::vector<size_t> buffer(order.begin(), order.begin() + window);
+  size_t out = 0;
+  for (size_t incoming = window; incoming < n; ++incoming) {
+    size_t j = rng.below(window);
+    order[out++] = buffer[j];
+    buffer[j] = incoming;
+  }
+  for (size_t left = window; left > 0; --left) {
+    size_t j = rng.below(left);
+    order[out++] = buffer[j];
+    buffer[j] = buffer[left - 1];
+  }
+  return order;
+}
+
+/** DataLoader sample seed **/
+uint64_t DataLoader::sampleSeed(uint64_t seed, uint64_t epoch, size_t index) {
+  return splitmix64(epochKey(seed, epoch) ^ splitmix64(static_cast<uint64_t>(index)));
+}
+
+/** DataLoader manifest reader **/
+std::vector<std::string> DataLoader::readManifest(const std::string& path) {
+  std::ifstream in(path);
+  if (!in)
+    throw std::runtime_error("[ERROR] Could not open manifest " + path + ".");
+  fs::path base = fs::path(path).parent_path();
+  std::vector<std::string> paths;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.empty() || line[0] == '#') continue;
+    fs::path entry(line);
+    paths.push_back(entry.is_absolute() ? line : (base / entry).string());
+  }
+  return paths;
+}
+
+/** DataLoader prefetch function **/
+void DataLoader::topUp(size_t depth) {
+  while (in_flight_.size() < depth && submitNext()) {
+  }
+}
+
+/** DataLoader submit one batch **/
+bool DataLoader::submitNext() {
+  if (settings_.epochs && submit_epoch_ >= settings_.epochs) return false;
+  if (order_epoch_ != submit_epoch_) {
+    order_ = epochOrder(submit_epoch_);
+    order_epoch_ = submit_epoch_;
+  }
+  uint64_t end = std::min<uint64_t>(epochSize(),
+                                    submit_position_ + settings_.batch);
+  InFlight batch;
+  batch.epoch = submit_epoch_;
+  batch.position = submit_position_;
+  std::vector<std::string> paths;
+  BatchOptions options;
+  for (uint64_t p = submit_position_; p < end; ++p) {
+    size_t index = order_[p];
+    batch.indices.push_back(index);
+    paths.push_back(manifest_[index]);
+    options.seeds.push_back(sampleSeed(settings_.seed, submit_epoch_, index));
+  }
+  auto promise = std::make_shared<std::promise<AugmentedBatch>>();
+  batch.result = promise->get_future();
+  // The workers read the files, so next() only waits on finished batches
+  augmenter_.submitFiles(std::move(paths), std::move(options),
+                         [promise](AugmentedBatch&& done) {
+                           promise->set_value(std::move(done));
+                         });
+  in_flight_.push_back(std::move(batch));
+
+  submit_position_ = end;
+  if (submit_position_ >= epochSize()) {
+    ++submit_epoch_;
+    submit_position_ = 0;
+  }
+  return true;
+}
+
+/** DataLoader epoch size **/
+uint64_t DataLoader::epochSize() const {
+  uint64_t n = manifest_.size();
+  if (settings_.drop_last) n -= n % settings_.batch;
+  return n;
+}
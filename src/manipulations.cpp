@@ -152,6 +152,13 @@ cv::Mat cropImage(const cv::Mat &im, int x, int y, int width, int height) {
 
 /** randomCrop **/
 cv::Mat randomCrop(const cv::Mat &im, int width, int height) {
+  std::random_device rand;
+  std::mt19937 gen(rand());
+  return randomCrop(im, width, height, gen);
+}
+
+cv::Mat randomCrop(const cv::Mat &im, int width, int height,
+                   std::mt19937 &gen) {
   if (im.empty()) return cv::Mat();
 
   // Crop size exceeds image size
@@ -163,8 +170,6 @@ cv::Mat randomCrop(const cv::Mat &im, int width, int height) {
   }
 
   // Randomly set starting point (x,y)
-  std::random_device rand;
-  std::mt19937 gen(rand());
   std::uniform_int_distribution<int> xdist(0, im.rows);
   std::uniform_int_distribution<int> ydist(0, im.cols);
   int x = xdist(gen);
@@ -196,10 +201,14 @@ cv::Mat affineTransform(const cv::Mat &im, const cv::Mat &matrix) {
 /** colorJitter **/
 int colorJitter(cv::Mat &im, double brightness, double contrast,
                 double saturation, int hue) {
-  if (im.empty() || im.channels() != 3) return -1;
-
   std::random_device rand;
   std::mt19937 gen(rand());
+  return colorJitter(im, brightness, contrast, saturation, hue, gen);
+}
+
+int colorJitter(cv::Mat &im, double brightness, double contrast,
+                double saturation, int hue, std::mt19937 &gen) {
+  if (im.empty() || im.channels() != 3) return -1;
 
   // Random distributions
   std::uniform_real_distribution<double> dist_b(-brightness, brightness);
@@ -344,11 +353,21 @@ int adjustHue(cv::Mat &im, int val) {
 
 /** injectNoise **/
 int injectNoise(cv::Mat &im, double mean, double stdev) {
+  std::mt19937 gen(static_cast<uint32_t>(cv::getTickCount()));
+  return injectNoise(im, mean, stdev, gen);
+}
+
+int injectNoise(cv::Mat &im, double mean, double stdev, std::mt19937 &gen) {
   if (im.empty() || im.channels() != 3) return -1;
 
   // Generate noise image
   cv::Mat noise(im.size(), im.type());
-  cv::RNG rand(cv::getTickCount());
+  // Separate statements: the order of two calls in one expression is
+  // unspecified, and the seed must not depend on the compiler
+  uint64_t hi = gen();
+  uint64_t lo = gen();
+  uint64_t state = (hi << 32) | lo;
+  cv::RNG rand(state ? state : 1);
   rand.fill(noise, cv::RNG::NORMAL, mean, stdev);
 
   // Add and clamp to image
@@ -383,10 +402,14 @@ int sharpenImage(cv::Mat &im) {
 
 /** randomErase **/
 int randomErase(cv::Mat &im, int min_h, int max_h, int min_w, int max_w) {
-  if (im.empty() || min_h > max_h || min_w > max_w) return -1;
-
   std::random_device rand;
   std::mt19937 gen(rand());
+  return randomErase(im, min_h, max_h, min_w, max_w, gen);
+}
+
+int randomErase(cv::Mat &im, int min_h, int max_h, int min_w, int max_w,
+                std::mt19937 &gen) {
+  if (im.empty() || min_h > max_h || min_w > max_w) return -1;
   std::uniform_int_distribution<int> h_dist(min_h, max_h);
   std::uniform_int_distribution<int> w_dist(min_w, max_w);
 
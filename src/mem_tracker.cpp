@@ -0,0 +1,242 @@
+/**
+ * @file mem_tracker.cpp
+ * @brief Implementation of the cv::Mat memory accounting defined in
+ * mem_tracker.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/mem_tracker.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <string>
+
+namespace {
+
+/* Stage charged for the calling thread's allocations */
+thread_local MemStage t_stage = MemStage::Other;
+
+/* Stages are stored in UMatData::userdata, offset by one so null means
+ * "not counted" */
+void* encodeStage(MemStage stage) {
+  return reinterpret_cast<void*>(static_cast<uintptr_t>(stage) + 1);
+}
+
+MemStage decodeStage(const void* userdata) {
+  uintptr_t v = reinterpret_cast<uintptr_t>(userdata);
+  if (v == 0 || v > kMemStageCount) return MemStage::Other;
+  return static_cast<MemStage>(v - 1);
+}
+
+/* Raise a high-water mark */
+void raise(std::atomic<uint64_t>& peak, uint64_t value) {
+  uint64_t cur = peak.load(std::memory_order_relaxed);
+  while (value > cur &&
+         !peak.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+/** ---------------- MemStage ---------------- **/
+const char* memStageName(MemStage stage) {
+  switch (stage) {
+    case MemStage::Other:
+      return "other";
+    case MemStage::Decode:
+      return "decoded";
+    case MemStage::Augment:
+      return "augment";
+    case MemStage::Queued:
+      return "queued";
+    case MemStage::Batched:
+      return "batched";
+    case MemStage::Encode:
+      return "encode";
+    default:
+      return "unknown";
+  }
+}
+
+/** ---------------- CountingAllocator ---------------- **/
+MemTracker::CountingAllocator::CountingAllocator(MemTracker& tracker)
+    : tracker_(tracker), base_(cv::Mat::getStdAllocator()) {}
+
+cv::UMatData* MemTracker::CountingAllocator::allocate(
+    int dims, const int* sizes, int type, void* data, size_t* step,
+    cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const {
+  cv::UMatData* u =
+      base_->allocate(dims, sizes, type, data, step, flags, usageFlags);
+  if (!u) return u;
+  // Route the release through this allocator
+  u->currAllocator = this;
+  if (!data) {
+    MemStage stage = t_stage;
+    u->userdata = encodeStage(stage);
+    tracker_.charge(stage, u->size);
+  }
+  return u;
+}
+
+bool MemTracker::CountingAllocator::allocate(
+    cv::UMatData* data, cv::AccessFlag accessflags,
+    cv::UMatUsageFlags usageFlags) const {
+  return base_->allocate(data, accessflags, usageFlags);
+}
+
+void MemTracker::CountingAllocator::deallocate(cv::UMatData* u) const {
+  if (!u) return;
+  if (u->userdata) {
+    tracker_.release(decodeStage(u->userdata), u->size);
+    u->userdata = nullptr;
+  }
+  base_->deallocate(u);
+}
+
+/** ---------------- MemTracker ---------------- **/
+MemTracker::MemTracker() : allocator_(*this) {}
+
+MemTracker& MemTracker::instance() {
+  // Never destroyed: buffers may outlive static destruction order
+  static MemTracker* tracker = new MemTracker();
+  return *tracker;
+}
+
+void MemTracker::install() {
+  if (installed_.exchange(true)) return;
+  cv::Mat::setDefaultAllocator(&allocator_);
+}
+
+MemStage MemTracker::setStage(MemStage stage) {
+  MemStage prev = t_stage;
+  t_stage = stage;
+  return prev;
+}
+
+void MemTracker::retag(const cv::Mat& mat, MemStage stage) {
+  cv::UMatData* u = mat.u;
+  if (!u || u->currAllocator != &allocator_ || !u->userdata) return;
+  MemStage from = decodeStage(u->userdata);
+  if (from == stage) return;
+  size_t s = static_cast<size_t>(stage);
+  stages_[static_cast<size_t>(from)].live.fetch_sub(
+      u->size, std::memory_order_relaxed);
+  uint64_t live =
+      stages_[s].live.fetch_add(u->size, std::memory_order_relaxed) + u->size;
+  raise(stages_[s].peak, live);
+  u->userdata = encodeStage(stage);
+}
+
+void MemTracker::charge(MemStage stage, uint64_t bytes) {
+  StageCounters& c = stages_[static_cast<size_t>(stage)];
+  c.allocations.fetch_add(1, std::memory_order_relaxed);
+  c.allocated.fetch_add(bytes, std::memory_order_relaxed);
+  raise(c.peak, c.live.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+  raise(peak_, live_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+}
+
+void MemTracker::release(MemStage stage, uint64_t bytes) {
+  stages_[static_cast<size_t>(stage)].live.fetch_sub(
+      bytes, std::memory_order_relaxed);
+  live_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void MemTracker::resetPeaks() {
+  for (StageCounters& c : stages_) {
+    c.peak.store(c.live.load(std::memory_order_relaxed),
+                 std::memory_order_relaxed);
+    c.allocations.store(0, std::memory_order_relaxed);
+    c.allocated.store(0, std::memory_order_relaxed);
+  }
+  peak_.store(live_.load(std::memory_order_relaxed),
+              std::memory_order_relaxed);
+}
+
+MemSnapshot MemTracker::snapshot() const {
+  MemSnapshot snap;
+  for (size_t s = 0; s < kMemStageCount; ++s) {
+    const StageCounters& c = stages_[s];
+    snap.stages[s].live_bytes = c.live.load(std::memory_order_relaxed);
+    snap.stages[s].peak_bytes = c.peak.load(std::memory_order_relaxed);
+    snap.stages[s].allocations = c.allocations.load(std::memory_order_relaxed);
+    snap.stages[s].allocated_bytes =
+        c.allocated.load(std::memory_order_relaxed);
+  }
+  snap.live_bytes = live_.load(std::memory_order_relaxed);
+  snap.peak_bytes = peak_.load(std::memory_order_relaxed);
+  return snap;
+}
+
+/** ---------------- Reporting ---------------- **/
+uint64_t peakResidentMemoryBytes() {
+  std::ifstream status("/proc/self/status");
+  std::string key;
+  while (status >> key) {
+    if (key == "VmHWM:") {
+      uint64_t kb = 0;
+      status >> kb;
+      return kb * 1024;
+    }
+    status.ignore(256, '\n');
+  }
+  return 0;
+}
+
+void writeMemoryText(std::ostream& out, const MemoryReport& report) {
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  auto mb = [](uint64_t bytes) { return static_cast<double>(bytes) / 1e6; };
+  double images = report.images ? static_cast<double>(report.images) : 1.0;
+
+  out << std::fixed << std::setprecision(1);
+  out << "[MEMORY] cv::Mat peak " << mb(report.mats.peak_bytes)
+      << " MB, process RSS peak " << mb(report.peak_rss) << " MB";
+  if (report.rss.sampleCount())
+    out << " (sampled mean " << report.rss.meanDepth() / 1e6 << " MB)";
+  out << "\n";
+  out << "  " << std::left << std::setw(10) << "stage" << std::right
+      << std::setw(12) << "peak MB" << std::setw(12) << "live MB"
+      << std::setw(12) << "allocs" << std::setw(14) << "allocs/img"
+      << std::setw(12) << "MB/img" << "\n";
+  for (size_t s = 0; s < kMemStageCount; ++s) {
+    const MemStageStats& st = report.mats.stages[s];
+    out << "  " << std::left << std::setw(10)
+        << memStageName(static_cast<MemStage>(s)) << std::right
+        << std::setw(12) << mb(st.peak_bytes) << std::setw(12)
+        << mb(st.live_bytes) << std::setw(12) << st.allocations
+        << std::setprecision(2) << std::setw(14) << st.allocations / images
+        << std::setw(12) << mb(st.allocated_bytes) / images
+        << std::setprecision(1) << "\n";
+  }
+
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void writeMemoryJson(JsonWriter& json, const MemoryReport& report) {
+  json.beginObject()
+      .field("images", report.images)
+      .field("mat_peak_bytes", report.mats.peak_bytes)
+      .field("mat_live_bytes", report.mats.live_bytes)
+      .field("rss_peak_bytes", report.peak_rss);
+
+  json.key("stages").beginArray();
+  for (size_t s = 0; s < kMemStageCount; ++s) {
+    const MemStageStats& st = report.mats.stages[s];
+    json.beginObject()
+        .field("name", memStageName(static_cast<MemStage>(s)))
+        .field("peak_bytes", st.peak_bytes)
+        .field("live_bytes", st.live_bytes)
+        .field("allocations", st.allocations)
+        .field("allocated_bytes", st.allocated_bytes)
+        .endObject();
+  }
+  json.endArray();
+
+  json.key("rss").beginArray();
+  for (const QueueSample& s : report.rss.samples())
+    json.beginArray().value(s.t_ns).value(s.depth).endArray();
+  json.endArray();
+  json.endObject();
+}
@@ -0,0 +1,272 @@
+/**
+ * @file metrics.cpp
+ * @brief Implementation of the metrics exposition defined in metrics.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/metrics.hpp"
+
+#include "../include/mem_tracker.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/* Escape a label value */
+std::string labelValue(const std::string& v) {
+  std::string res;
+  res.reserve(v.size());
+  for (char c : v) {
+    if (c == '\\' || c == '"') res += '\\';
+    if (c == '\n') {
+      res += "\\n";
+      continue;
+    }
+    res += c;
+  }
+  return res;
+}
+
+/* HELP and TYPE header of a metric family */
+void family(std::ostream& out, const char* name, const char* type,
+            const char* help) {
+  out << "# HELP " << name << ' ' << help << '\n'
+      << "# TYPE " << name << ' ' << type << '\n';
+}
+
+/* Format a floating-point sample value */
+std::string number(double v) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.9g", v);
+  return buf;
+}
+
+}  // namespace
+
+/** ---------------- Process ---------------- **/
+uint64_t residentMemoryBytes() {
+  std::ifstream statm("/proc/self/statm");
+  uint64_t pages = 0, resident = 0;
+  if (!(statm >> pages >> resident)) return 0;
+  return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+/** ---------------- Exposition ---------------- **/
+void writePrometheus(std::ostream& out, const ProgressSnapshot& snap,
+                     const std::vector<std::string>& opLabels,
+                     uint64_t totalTasks) {
+  family(out, "augmento_tasks_planned", "gauge",
+         "Images the current run will produce.");
+  out << "augmento_tasks_planned " << totalTasks << '\n';
+
+  family(out, "augmento_images_completed_total", "counter",
+         "Images augmented and written.");
+  out << "augmento_images_completed_total " << snap.completed << '\n';
+
+  family(out, "augmento_images_failed_total", "counter",
+         "Tasks that failed with an error.");
+  out << "augmento_images_failed_total " << snap.failed << '\n';
+
+  family(out, "augmento_read_bytes_total", "counter",
+         "Encoded bytes read from input files.");
+  out << "augmento_read_bytes_total " << snap.bytes_in << '\n';
+
+  family(out, "augmento_written_bytes_total", "counter",
+         "Encoded bytes written to output files.");
+  out << "augmento_written_bytes_total " << snap.bytes_out << '\n';
+
+  family(out, "augmento_elapsed_seconds", "gauge",
+         "Time since the start of the current run.");
+  out << "augmento_elapsed_seconds " << number(snap.t_ns / 1e9) << '\n';
+
+  family(out, "augmento_stage_busy_seconds_total", "counter",
+         "Worker time spent in each pipeline stage, summed over threads.");
+  for (size_t s = 0; s < kStageCount; ++s) {
+    out << "augmento_stage_busy_seconds_total{stage=\""
+        << stageName(static_cast<Stage>(s)) << "\"} "
+        << number(snap.busy_ns[s] / 1e9) << '\n';
+  }
+
+  family(out, "augmento_op_applied_total", "counter",
+         "Times each pipeline operation was applied.");
+  for (size_t i = 0; i < snap.op_fired.size(); ++i) {
+    std::string op = i < opLabels.size() ? labelValue(opLabels[i]) : "";
+    out << "augmento_op_applied_total{index=\"" << i << "\",op=\"" << op
+        << "\"} " << snap.op_fired[i] << '\n';
+  }
+
+  family(out, "augmento_op_seconds_total", "counter",
+         "Time spent in each pipeline operation, summed over threads.");
+  for (size_t i = 0; i < snap.op_busy_ns.size(); ++i) {
+    std::string op = i < opLabels.size() ? labelValue(opLabels[i]) : "";
+    out << "augmento_op_seconds_total{index=\"" << i << "\",op=\"" << op
+        << "\"} " << number(snap.op_busy_ns[i] / 1e9) << '\n';
+  }
+
+  family(out, "augmento_queue_depth", "gauge", "Items waiting in each queue.");
+  out << "augmento_queue_depth{queue=\"paths\"} " << snap.path_depth << '\n'
+      << "augmento_queue_depth{queue=\"images\"} " << snap.image_depth << '\n';
+
+  family(out, "augmento_queue_capacity", "gauge", "Capacity of each queue.");
+  out << "augmento_queue_capacity{queue=\"paths\"} " << snap.path_capacity
+      << '\n'
+      << "augmento_queue_capacity{queue=\"images\"} " << snap.image_capacity
+      << '\n';
+
+  MemTracker& mem = MemTracker::instance();
+  if (mem.installed()) {
+    MemSnapshot m = mem.snapshot();
+    family(out, "augmento_mat_live_bytes", "gauge",
+           "Bytes of live cv::Mat buffers per pipeline stage.");
+    for (size_t s = 0; s < kMemStageCount; ++s)
+      out << "augmento_mat_live_bytes{stage=\""
+          << memStageName(static_cast<MemStage>(s)) << "\"} "
+          << m.stages[s].live_bytes << '\n';
+    family(out, "augmento_mat_peak_bytes", "gauge",
+           "High-water mark of live cv::Mat bytes in the current run.");
+    out << "augmento_mat_peak_bytes " << m.peak_bytes << '\n';
+    family(out, "augmento_mat_allocations_total", "counter",
+           "cv::Mat buffers allocated per pipeline stage.");
+    for (size_t s = 0; s < kMemStageCount; ++s)
+      out << "augmento_mat_allocations_total{stage=\""
+          << memStageName(static_cast<MemStage>(s)) << "\"} "
+          << m.stages[s].allocations << '\n';
+  }
+
+  family(out, "process_resident_memory_bytes", "gauge",
+         "Resident memory size in bytes.");
+  out << "process_resident_memory_bytes " << residentMemoryBytes() << '\n';
+}
+
+/** ---------------- MetricsServer ---------------- **/
+MetricsServer::MetricsServer(uint16_t port, Render render)
+    : port_(port), render_(std::move(render)) {
+  listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ < 0)
+    throw std::runtime_error("[ERROR] Could not create metrics socket: " +
+                             std::string(std::strerror(errno)));
+
+  int reuse = 1;
+  setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      listen(listen_fd_, 8) < 0) {
+    std::string reason = std::strerror(errno);
+    close(listen_fd_);
+    throw std::runtime_error("[ERROR] Could not listen on 127.0.0.1:" +
+                             std::to_string(port) + ": " + reason);
+  }
+
+  thread_ = std::thread(&MetricsServer::serve, this);
+}
+
+MetricsServer::~MetricsServer() {
+  stop_.store(true);
+  if (thread_.joinable()) thread_.join();
+  if (listen_fd_ >= 0) close(listen_fd_);
+}
+
+void MetricsServer::serve() {
+  pollfd pfd{listen_fd_, POLLIN, 0};
+  while (!stop_.load()) {
+    // Wake up periodically to notice stop requests
+    if (poll(&pfd, 1, 200) <= 0) continue;
+    int fd = accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) continue;
+    handle(fd);
+    close(fd);
+  }
+}
+
+void MetricsServer::handle(int fd) {
+  timeval timeout{1, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  // Only the request line matters; the rest of the request is ignored
+  char buf[1024];
+  ssize_t n = recv(fd, buf, sizeof(buf) - 1, 0);
+  if (n <= 0) return;
+  buf[n] = '\0';
+  std::string request(buf);
+  std::string line = request.substr(0, request.find('\r'));
+
+  std::string status, type, body;
+  if (line.rfind("GET /metrics ", 0) == 0 || line.rfind("GET / ", 0) == 0) {
+    status = "200 OK";
+    type = "text/plain; version=0.0.4; charset=utf-8";
+    body = render_();
+  } else {
+    status = "404 Not Found";
+    type = "text/plain; charset=utf-8";
+    body = "Not found. Metrics are served at /metrics.\n";
+  }
+
+  std::ostringstream response;
+  response << "HTTP/1.1 " << status << "\r\n"
+           << "Content-Type: " << type << "\r\n"
+           << "Content-Length: " << body.size() << "\r\n"
+           << "Connection: close\r\n\r\n"
+           << body;
+  std::string data = response.str();
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t w = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (w <= 0) return;
+    sent += static_cast<size_t>(w);
+  }
+}
+
+/** ---------------- MetricsTextfile ---------------- **/
+MetricsTextfile::MetricsTextfile(std::string path,
+                                 std::chrono::milliseconds interval)
+    : path_(std::move(path)),
+      interval_ns_(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(interval)
+              .count())) {}
+
+void MetricsTextfile::update(uint64_t t_ns,
+                             const std::function<std::string()>& render) {
+  if (written_ && t_ns < last_ns_ + interval_ns_) return;
+  last_ns_ = t_ns;
+  written_ = true;
+  write(render());
+}
+
+bool MetricsTextfile::write(const std::string& text) {
+  std::string tmp = path_ + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::trunc);
+    out << text;
+    if (!out) {
+      if (!warned_)
+        std::cerr << "[WARN] Could not write metrics file " << tmp << "\n";
+      warned_ = true;
+      return false;
+    }
+  }
+  if (std::rename(tmp.c_str(), path_.c_str()) != 0) {
+    if (!warned_)
+      std::cerr << "[WARN] Could not replace metrics file " << path_ << ": "
+                << std::strerror(errno) << "\n";
+    warned_ = true;
+    return false;
+  }
+  return true;
+}
@@ -14,60 +14,161 @@
 
 #include "../include/multithread.hpp"
 
+#include "../include/mem_tracker.hpp"
+
 /** Producer pool **/
-void producerPool(SafeQueue<fs::path>& pathQueue, SafeQueue<Image>& outputQueue,
-                  Pipeline& pipeline) {
-  fs::path path;
-  while (pathQueue.pop(path)) {
+void producerPool(SafeQueue<PathTask>& pathQueue,
+                  SafeQueue<Image>& outputQueue, Pipeline& pipeline,
+                  ThreadProfile& profile) {
+  PathTask task;
+  const fs::path& path = task.path;
+  std::vector<uchar> encoded;
+  uint64_t wait_start = nowNs();
+  while (pathQueue.pop(task)) {
+    if (profile.tracing())
+      profile.recordWait(TraceSpan::WaitPopPaths, wait_start, nowNs());
+    AUGMENTO_PROBE1(task__start, path.c_str());
     try {
-      Image img(path);
-      pipeline.apply(img);
+      // Untimed, so every iteration reads from storage
+      if (task.drop_cache) Image::dropCache(path.string());
+      uint64_t t0 = nowNs();
+      if (Image::readFile(path.string(), encoded) != 0)
+        throw std::runtime_error("could not read file");
+      uint64_t t1 = nowNs();
+      profile.recordBytesIn(encoded.size());
+      Image img;
+      img.setName(path.string());
+      MemTracker::setStage(MemStage::Decode);
+      if (img.decode(encoded) != 0)
+        throw std::runtime_error("could not decode image");
+      uint64_t t2 = nowNs();
+      img.getTiming().width = img.getData().cols;
+      img.getTiming().height = img.getData().rows;
+      img.getTiming().channels = img.getData().channels();
+      MemTracker::setStage(MemStage::Augment);
+      pipeline.apply(img, profile);
+      MemTracker::setStage(MemStage::Other);
+      uint64_t t3 = nowNs();
+
+      profile.recordStage(Stage::Read, t0, t1);
+      profile.recordStage(Stage::Decode, t1, t2);
+      profile.recordStage(Stage::Augment, t2, t3);
+      profile.recordFormatInput(
+          inputFormatOf(path.string()), encoded.size(),
+          static_cast<uint64_t>(img.getTiming().width) *
+              img.getTiming().height,
+          t1 - t0, t2 - t1);
+      profile.recordSojourn(Sojourn::Admission, t0 - task.arrival_ns);
+      TaskTiming& timing = img.getTiming();
+      timing.arrival_ns = task.arrival_ns;
+      timing.start_ns = t0;
+      timing.read_ns = t1 - t0;
+      timing.decode_ns = t2 - t1;
+      timing.augment_ns = t3 - t2;
+      timing.enqueued_ns = t3;
+      timing.bytes_in = encoded.size();
+      MemTracker::instance().retag(img.getData(), MemStage::Queued);
       outputQueue.push(std::move(img));
+      if (profile.tracing())
+        profile.recordWait(TraceSpan::WaitPushImages, t3, nowNs());
+      AUGMENTO_PROBE2(task__end, path.c_str(), 1);
     } catch (const std::exception& e) {
+      MemTracker::setStage(MemStage::Other);
+      AUGMENTO_PROBE2(task__end, path.c_str(), 0);
+      profile.recordFailure();
       std::cerr << "[WARN] Failed to process " << path << ": " << e.what()
                 << std::endl;
     }
+    wait_start = nowNs();
+  }
+}
+
+/** Save a single image, timing encode and write separately */
+static void saveImage(const Image& image, const std::string& outputDir,
+                      const std::string& ext, bool save_specs,
+                      std::vector<uchar>& encoded, ThreadProfile& profile,
+                      SinkMode sink) {
+  AUGMENTO_PROBE2(save__start, image.getName().c_str(), image.getId());
+  ScopedMemStage stage(MemStage::Encode);
+  uint64_t t0 = nowNs();
+  if (sink == SinkMode::SkipEncode)
+    encoded.clear();
+  else if (image.encode(encoded, ext) != 0)
+    throw std::runtime_error("could not encode " + image.getName());
+  uint64_t t1 = nowNs();
+  if (sink == SinkMode::Full &&
+      image.write(encoded, outputDir, ext, save_specs) != 0)
+    throw std::runtime_error("could not write " + image.getName());
+  uint64_t t2 = nowNs();
+
+  // Skipped stages stay empty rather than counting zero-length samples
+  if (sink != SinkMode::SkipEncode) profile.recordStage(Stage::Encode, t0, t1);
+  if (sink == SinkMode::Full) profile.recordStage(Stage::Write, t1, t2);
+  profile.recordFormatOutput(inputFormatOf(image.getName()), encoded.size(),
+                             t1 - t0, t2 - t1);
+  if (sink == SinkMode::Full) profile.recordBytesOut(encoded.size());
+  profile.recordSojourn(Sojourn::Handoff, t0 - image.getTiming().enqueued_ns);
+  profile.recordSojourn(Sojourn::EndToEnd, t2 - image.getTiming().arrival_ns);
+  profile.recordCompleted();
+  if (SlowTaskLog* slow = profile.slowTasks()) {
+    const TaskTiming& timing = image.getTiming();
+    uint64_t service = timing.read_ns + timing.decode_ns + timing.augment_ns +
+                       (t2 - t0);
+    if (slow->consider(service)) {
+      SlowTask task;
+      task.path = image.getName();
+      task.timing = timing;
+      task.queued_ns = t0 - timing.enqueued_ns;
+      task.encode_ns = t1 - t0;
+      task.write_ns = t2 - t1;
+      task.bytes_out = encoded.size();
+      task.out_width = image.getData().cols;
+      task.out_height = image.getData().rows;
+      slow->offer(std::move(task));
+    }
   }
+  AUGMENTO_PROBE3(save__end, image.getName().c_str(), image.getId(),
+                  encoded.size());
 }
 
 /** Consumer pool */
 void consumerThread(SafeQueue<Image>& queue, const std::string& outputDir,
-                    bool save_specs) {
+                    bool save_specs, ThreadProfile& profile, SinkMode sink,
+                    size_t batch_size, const std::string& output_ext) {
   Image img;
-  size_t batchSize = 12;
-  size_t localSaveCount = 0;
   std::vector<Image> image_batch;
+  std::vector<uchar> encoded;
 
+  uint64_t wait_start = nowNs();
   while (queue.pop(img)) {
-    try {
-      image_batch.push_back(std::move(img));
-      if (image_batch.size() >= batchSize) {
-        for (auto& image : image_batch) {
-          if (save_specs)
-            image.saveWithHistory(outputDir);
-          else
-            image.save(outputDir);
-          ++localSaveCount;
+    if (profile.tracing())
+      profile.recordWait(TraceSpan::WaitPopImages, wait_start, nowNs());
+    MemTracker::instance().retag(img.getData(), MemStage::Batched);
+    image_batch.push_back(std::move(img));
+    if (image_batch.size() >= std::max<size_t>(1, batch_size)) {
+      for (auto& image : image_batch) {
+        try {
+          saveImage(image, outputDir, output_ext, save_specs, encoded, profile,
+                    sink);
+        } catch (const std::exception& e) {
+          profile.recordFailure();
+          std::cerr << "[ERROR] Failed to save image: " << e.what()
+                    << std::endl;
         }
-        image_batch.clear();
       }
-
-      if (localSaveCount % 7 == 0 && localSaveCount != 0) {
-        std::cout << "[INFO] Saved " << localSaveCount << " images..."
-                  << std::endl;
-      }
-    } catch (const std::exception& e) {
-      std::cerr << "[ERROR] Failed to save image: " << e.what() << std::endl;
+      image_batch.clear();
     }
+    wait_start = nowNs();
   }
 
-  if (!image_batch.empty()) {
-    for (auto& image : image_batch) {
-      if (save_specs)
-        image.saveWithHistory(outputDir);
-      else
-        image.save(outputDir);
+  for (auto& image : image_batch) {
+    try {
+      saveImage(image, outputDir, output_ext, save_specs, encoded, profile,
+                    sink);
+    } catch (const std::exception& e) {
+      profile.recordFailure();
+      std::cerr << "[ERROR] Failed to save image: " << e.what() << std::endl;
     }
-    image_batch.clear();
   }
+  image_batch.clear();
 }
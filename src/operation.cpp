@@ -10,6 +10,28 @@
 
 #include "../include/operation.hpp"
 
+#include <algorithm>
+
+namespace {
+
+/* Size of an image buffer in bytes (one byte per element for 8-bit data) */
+double bytesOf(const cv::Mat& m) {
+  return static_cast<double>(m.total() * m.elemSize());
+}
+
+/* Bilinear warp producing out_bytes from in_bytes: ~8 ops per element */
+OpCost warpCost(double in_bytes, double out_bytes) {
+  return OpCost{in_bytes, out_bytes, 8.0 * out_bytes};
+}
+
+}  // namespace
+
+/** ---------------- Operation ---------------- **/
+OpCost Operation::cost(const cv::Mat& input) const {
+  double e = bytesOf(input);
+  return OpCost{e, e, 0.0};
+}
+
 /** ---------------- RotateImage ---------------- **/
 RotateImage::RotateImage(double min_angle, double max_angle, size_t rot_type)
     : min_angle_(min_angle), max_angle_(max_angle), rot_type_(rot_type) {
@@ -48,6 +70,23 @@ std::string RotateImage::name() const {
   return "RotateImage: Rotates image with crop, no crop, or fill-in";
 }
 
+OpCost RotateImage::cost(const cv::Mat& input) const {
+  double e = bytesOf(input);
+  if (rot_type_ != 0) return warpCost(e, e);
+  // No crop: the output grows to the bounding box of the rotated input
+  // Model the expected |angle| over the uniform range, which straddles 0
+  // for ranges such as [-30, 30]
+  double lo = std::min(min_angle_, max_angle_),
+         hi = std::max(min_angle_, max_angle_);
+  double mean_abs = std::abs(lo + hi) / 2.0;
+  if (lo < 0 && hi > 0) mean_abs = (lo * lo + hi * hi) / (2.0 * (hi - lo));
+  double rad = mean_abs * PI / 180.0;
+  double c = std::abs(std::cos(rad)), s = std::abs(std::sin(rad));
+  double w = input.cols, h = input.rows;
+  double grow = (w * h > 0) ? (w * c + h * s) * (w * s + h * c) / (w * h) : 1;
+  return warpCost(e, e * grow);
+}
+
 /** ---------------- ReflectImage ---------------- **/
 ReflectImage::ReflectImage() = default;
 
@@ -78,6 +117,11 @@ std::string ReflectImage::name() const {
   return "ReflectImage: Reflects image along horizontal or vertical axis";
 }
 
+OpCost ReflectImage::cost(const cv::Mat& input) const {
+  double e = bytesOf(input);
+  return OpCost{e, e, 0.0};
+}
+
 /** ---------------- ResizeImage ---------------- **/
 ResizeImage::ResizeImage(double min_scale, double max_scale)
     : min_scale_(min_scale),
@@ -140,6 +184,20 @@ std::string ResizeImage::name() const {
   return "ResizeImage: Resizes input image by scale or absolute dimensions";
 }
 
+OpCost ResizeImage::cost(const cv::Mat& input) const {
+  double e = bytesOf(input);
+  double out = e;
+  if (min_w_ == -1) {
+    double scale = (min_scale_ + max_scale_) / 2.0;
+    out = e * scale * scale;
+  } else if (input.total() > 0) {
+    double w = (min_w_ + max_w_) / 2.0, h = (min_h_ + max_h_) / 2.0;
+    out = e * w * h / static_cast<double>(input.total());
+  }
+  // Bilinear interpolation: ~6 ops per output element
+  return OpCost{std::min(e, out * 4.0), out, 6.0 * out};
+}
+
 /** ---------------- CropImage ---------------- **/
 CropImage::CropImage(int width, int height)
     : w_(width), h_(height), x_(-1), y_(-1) {
@@ -167,7 +225,7 @@ void CropImage::apply(Image& img, std::mt19937& rng) const {
     throw std::invalid_argument(
         "CropImage: Cannot initiate crop outside bounds");
   if (x_ == -1) {
-    img.setData(randomCrop(img.getData(), w_, h_));
+    img.setData(randomCrop(img.getData(), w_, h_, rng));
     img.logOperation("CropImage (random): " + std::to_string(w_) + "x" +
                      std::to_string(h_));
   } else {
@@ -182,6 +240,11 @@ std::string CropImage::name() const {
   return "CropImage: Crops image either randomly or deterministically";
 }
 
+OpCost CropImage::cost(const cv::Mat& input) const {
+  double e = static_cast<double>(w_) * h_ * input.elemSize();
+  return OpCost{e, e, 0.0};
+}
+
 /** ---------------- AffineTransform ---------------- **/
 AffineTransform::AffineTransform(std::mt19937& rng) {
   std::uniform_real_distribution<double> dist(-2, 2);
@@ -218,6 +281,11 @@ std::string AffineTransform::name() const {
   return "AffineTransform: Applies affine transform to image";
 }
 
+OpCost AffineTransform::cost(const cv::Mat& input) const {
+  double e = bytesOf(input);
+  return warpCost(e, e);
+}
+
 /** ---------------- ColorJitter ---------------- **/
 ColorJitter::ColorJitter(double brightness_range, double contrast_range,
                          double saturation_range, int hue_range)
@@ -237,9 +305,9 @@ ColorJitter::ColorJitter(double brightness_range, double contrast_range,
   }
 }
 
-void ColorJitter::apply(Image& img, std::mt19937& /*rng*/) const {
+void ColorJitter::apply(Image& img, std::mt19937& rng) const {
   colorJitter(img.getData(), brightness_range_, contrast_range_,
-              saturation_range_, hue_range_);
+              saturation_range_, hue_range_, rng);
   img.logOperation("ColorJitter: " + std::to_string(brightness_range_) + " " +
                    std::to_string(contrast_range_) + " " +
                    std::to_string(saturation_range_) + " " +
@@ -250,6 +318,15 @@ std::string ColorJitter::name() const {
   return "ColorJitter: Applies brightness/contrast/saturation/hue jitter";
 }
 
+OpCost ColorJitter::cost(const cv::Mat& input) const {
+  // Two convertTo passes, BGR->HSV, split, saturation scale and clamp on one
+  // channel, hue loop on one channel, merge, HSV->BGR
+  double e = bytesOf(input);
+  double c = e / 3.0;
+  double moved = 2 * e + e + e + c + c + c + e + e;
+  return OpCost{moved, moved, 2 * 2 * e + 4 * e + c + c + 3 * c + 4 * e};
+}
+
 /** ---------------- HistogramEqualization ---------------- **/
 HistogramEqualization::HistogramEqualization() = default;
 
@@ -262,6 +339,13 @@ std::string HistogramEqualization::name() const {
   return "HistogramEqualization: Applies histogram equalization";
 }
 
+OpCost HistogramEqualization::cost(const cv::Mat& input) const {
+  // BGR->YCrCb, split, histogram + LUT on luma, merge, YCrCb->BGR
+  double e = bytesOf(input);
+  double y = e / 3.0;
+  return OpCost{4 * e + 2 * y, 4 * e + y, 10 * e + 2 * y};
+}
+
 /** ---------------- WhiteBalance ---------------- **/
 WhiteBalance::WhiteBalance() = default;
 
@@ -274,6 +358,12 @@ std::string WhiteBalance::name() const {
   return "WhiteBalance: Applies white balance correction";
 }
 
+OpCost WhiteBalance::cost(const cv::Mat& input) const {
+  // Split, three channel means, three channel scales, merge
+  double e = bytesOf(input);
+  return OpCost{4 * e, 3 * e, 2 * e};
+}
+
 /** ---------------- ToGrayscale ---------------- **/
 ToGrayscale::ToGrayscale() = default;
 
@@ -286,6 +376,12 @@ std::string ToGrayscale::name() const {
   return "ToGrayscale: Converts image to grayscale";
 }
 
+OpCost ToGrayscale::cost(const cv::Mat& input) const {
+  // Weighted sum of three channels per pixel
+  double px = static_cast<double>(input.total());
+  return OpCost{bytesOf(input), px, 5 * px};
+}
+
 /** ---------------- AdjustBrightness ---------------- **/
 AdjustBrightness::AdjustBrightness(double min_val, double max_val)
     : min_val_(min_val), max_val_(max_val) {
@@ -308,6 +404,11 @@ std::string AdjustBrightness::name() const {
   return "AdjustBrightness: Randomly adjusts brightness";
 }
 
+OpCost AdjustBrightness::cost(const cv::Mat& input) const {
+  double e = bytesOf(input);
+  return OpCost{e, e, e};
+}
+
 /** ---------------- AdjustContrast ---------------- **/
 AdjustContrast::AdjustContrast(double min_val, double max_val)
     : min_val_(min_val), max_val_(max_val) {
@@ -330,6 +431,11 @@ std::string AdjustContrast::name() const {
   return "AdjustContrast: Randomly adjusts contrast";
 }
 
+OpCost AdjustContrast::cost(const cv::Mat& input) const {
+  double e = bytesOf(input);
+  return OpCost{e, e, e};
+}
+
 /** ---------------- AdjustSaturation ---------------- **/
 AdjustSaturation::AdjustSaturation(double min_val, double max_val)
     : min_val_(min_val), max_val_(max_val) {
@@ -352,6 +458,14 @@ std::string AdjustSaturation::name() const {
   return "AdjustSaturation: Randomly adjusts saturation";
 }
 
+OpCost AdjustSaturation::cost(const cv::Mat& input) const {
+  // BGR->HSV, split, scale and clamp one channel, merge, HSV->BGR
+  double e = bytesOf(input);
+  double c = e / 3.0;
+  double moved = 4 * e + 2 * c;
+  return OpCost{moved, moved, 8 * e + 2 * c};
+}
+
 /** ---------------- AdjustHue ---------------- **/
 AdjustHue::AdjustHue(int min_val, int max_val)
     : min_val_(min_val), max_val_(max_val) {
@@ -371,7 +485,15 @@ void AdjustHue::apply(Image& img, std::mt19937& rng) const {
 }
 
 std::string AdjustHue::name() const {
-  return "AdjustHuue: Randomly adjusts image hue";
+  return "AdjustHue: Randomly adjusts image hue";
+}
+
+OpCost AdjustHue::cost(const cv::Mat& input) const {
+  // BGR->HSV, split, add and wrap one channel, merge, HSV->BGR
+  double e = bytesOf(input);
+  double c = e / 3.0;
+  double moved = 4 * e + c;
+  return OpCost{moved, moved, 8 * e + 3 * c};
 }
 
 /** ---------------- InjectNoise ---------------- **/
@@ -390,7 +512,7 @@ void InjectNoise::apply(Image& img, std::mt19937& rng) const {
   std::uniform_real_distribution<double> sDist(stdev_min_, stdev_max_);
   double mean = mDist(rng);
   double stdev = sDist(rng);
-  injectNoise(img.getData(), mean, stdev);
+  injectNoise(img.getData(), mean, stdev, rng);
   img.logOperation("InjectNoise: μ=" + std::to_string(mean) +
                    ", σ=" + std::to_string(stdev));
 }
@@ -399,6 +521,12 @@ std::string InjectNoise::name() const {
   return "InjectNoise: Adds Gaussian noise to image";
 }
 
+OpCost InjectNoise::cost(const cv::Mat& input) const {
+  // Gaussian fill, saturating add, two thresholds, copy back
+  double e = bytesOf(input);
+  return OpCost{5 * e, 5 * e, 13 * e};
+}
+
 /** ---------------- BlurImage ---------------- **/
 BlurImage::BlurImage() : min_k_(3), max_k_(9) {}
 BlurImage::BlurImage(int min_k, int max_k) : min_k_(min_k), max_k_(max_k) {}
@@ -415,6 +543,12 @@ std::string BlurImage::name() const {
   return "BlurImage: Applies blur using square averaging kernel";
 }
 
+OpCost BlurImage::cost(const cv::Mat& input) const {
+  // Separable running-sum box filter: cost independent of kernel size
+  double e = bytesOf(input);
+  return OpCost{e, e, 4 * e};
+}
+
 /** ---------------- SharpenImage ---------------- **/
 SharpenImage::SharpenImage() = default;
 
@@ -427,6 +561,12 @@ std::string SharpenImage::name() const {
   return "SharpenImage: Sharpens image using Laplacian enhancement";
 }
 
+OpCost SharpenImage::cost(const cv::Mat& input) const {
+  // Generic 3x3 filter2D (9 multiply-adds per element), then copy back
+  double e = bytesOf(input);
+  return OpCost{2 * e, 2 * e, 17 * e};
+}
+
 /** ---------------- RandomErase ---------------- **/
 RandomErase::RandomErase() : min_h_(1), max_h_(10), min_w_(1), max_w_(10) {}
 
@@ -453,8 +593,8 @@ RandomErase::RandomErase(int min_h, int max_h, int min_w, int max_w)
   }
 }
 
-void RandomErase::apply(Image& img, std::mt19937& /*rng*/) const {
-  randomErase(img.getData(), min_h_, max_h_, min_w_, max_w_);
+void RandomErase::apply(Image& img, std::mt19937& rng) const {
+  randomErase(img.getData(), min_h_, max_h_, min_w_, max_w_, rng);
   img.logOperation("RandomErase: h=[" + std::to_string(min_h_) + "," +
                    std::to_string(max_h_) + "], w=[" + std::to_string(min_w_) +
                    "," + std::to_string(max_w_) + "]");
@@ -463,3 +603,8 @@ void RandomErase::apply(Image& img, std::mt19937& /*rng*/) const {
 std::string RandomErase::name() const {
   return "RandomErase: Randomly erases rectangular region within image";
 }
+
+OpCost RandomErase::cost(const cv::Mat& input) const {
+  double area = (min_h_ + max_h_) / 2.0 * (min_w_ + max_w_) / 2.0;
+  return OpCost{0.0, area * input.elemSize(), 0.0};
+}
@@ -0,0 +1,146 @@
+/**
+ * @file perf_counters.cpp
+ * @brief Implementation of the hardware counter helpers defined in
+ * perf_counters.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/perf_counters.hpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace {
+
+/* Thin wrapper, glibc has no perf_event_open() */
+int perfEventOpen(perf_event_attr* attr, int group_fd) {
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, attr, 0, -1, group_fd, 0));
+}
+
+/* Generic hardware event configuration for each PerfEvent */
+uint64_t eventConfig(PerfEvent event) {
+  switch (event) {
+    case PerfEvent::Cycles:
+      return PERF_COUNT_HW_CPU_CYCLES;
+    case PerfEvent::Instructions:
+      return PERF_COUNT_HW_INSTRUCTIONS;
+    case PerfEvent::LlcMisses:
+      return PERF_COUNT_HW_CACHE_MISSES;
+    case PerfEvent::BranchMisses:
+      return PERF_COUNT_HW_BRANCH_MISSES;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+/** ---------------- PerfEvent ---------------- **/
+const char* perfEventName(PerfEvent event) {
+  switch (event) {
+    case PerfEvent::Cycles:
+      return "cycles";
+    case PerfEvent::Instructions:
+      return "instructions";
+    case PerfEvent::LlcMisses:
+      return "llc_misses";
+    case PerfEvent::BranchMisses:
+      return "branch_misses";
+    default:
+      return "unknown";
+  }
+}
+
+/** ---------------- PerfSample ---------------- **/
+PerfSample PerfSample::since(const PerfSample& before) const {
+  PerfSample delta;
+  delta.time_enabled = time_enabled - before.time_enabled;
+  delta.time_running = time_running - before.time_running;
+  // Scale for multiplexing: the group only counted while it was running
+  double scale = 1.0;
+  if (delta.time_running > 0 && delta.time_running < delta.time_enabled)
+    scale = static_cast<double>(delta.time_enabled) / delta.time_running;
+  for (size_t e = 0; e < kPerfEventCount; ++e) {
+    uint64_t raw = values[e] - before.values[e];
+    delta.values[e] = static_cast<uint64_t>(raw * scale);
+  }
+  return delta;
+}
+
+/** ---------------- PerfCounterGroup ---------------- **/
+PerfCounterGroup::PerfCounterGroup() {
+  fds_.fill(-1);
+  for (size_t e = 0; e < kPerfEventCount; ++e) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = eventConfig(static_cast<PerfEvent>(e));
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                       PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.disabled = e == 0;  // the leader starts the whole group
+
+    fds_[e] = perfEventOpen(&attr, e == 0 ? -1 : fds_[0]);
+    if (fds_[e] < 0 && e == 0) {
+      reason_ = std::string("perf_event_open failed: ") + std::strerror(errno);
+      if (errno == EACCES || errno == EPERM)
+        reason_ += " (check /proc/sys/kernel/perf_event_paranoid)";
+      return;
+    }
+  }
+  ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounterGroup::~PerfCounterGroup() {
+  for (int fd : fds_)
+    if (fd >= 0) close(fd);
+}
+
+PerfSample PerfCounterGroup::read() const {
+  PerfSample sample;
+  if (!available()) return sample;
+
+  // Layout with PERF_FORMAT_GROUP | ID | TOTAL_TIME_*:
+  // nr, time_enabled, time_running, then {value, id} per open event
+  uint64_t buf[3 + 2 * kPerfEventCount];
+  ssize_t n = ::read(fds_[0], buf, sizeof(buf));
+  if (n < static_cast<ssize_t>(3 * sizeof(uint64_t))) return sample;
+
+  sample.time_enabled = buf[1];
+  sample.time_running = buf[2];
+  size_t slot = 0;
+  for (size_t e = 0; e < kPerfEventCount && slot < buf[0]; ++e) {
+    if (fds_[e] < 0) continue;
+    sample.values[e] = buf[3 + 2 * slot];
+    ++slot;
+  }
+  return sample;
+}
+
+/** ---------------- PerfTotals ---------------- **/
+void PerfTotals::add(const PerfSample& delta) {
+  ++calls;
+  for (size_t e = 0; e < kPerfEventCount; ++e) values[e] += delta.values[e];
+}
+
+void PerfTotals::merge(const PerfTotals& other) {
+  calls += other.calls;
+  for (size_t e = 0; e < kPerfEventCount; ++e) values[e] += other.values[e];
+}
+
+double PerfTotals::ipc() const {
+  uint64_t cycles = (*this)[PerfEvent::Cycles];
+  return cycles ? static_cast<double>((*this)[PerfEvent::Instructions]) / cycles
+                : 0.0;
+}
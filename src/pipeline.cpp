@@ -13,35 +13,85 @@ Pipeline::Pipeline(unsigned int seed) : base_seed_(seed) {}
 /* add an operation to the pipeline using an OperationEntry object */
 void Pipeline::addOperation(const OperationEntry& op) {
   operations_.push_back(op);
+  std::string name = op.op->name();
+  labels_.push_back(name.substr(0, name.find(':')));
 }
 
 /* Apply the pipeline to an image using internal seeding based on image ID */
 void Pipeline::apply(Image& img) {
+  std::mt19937 rand = makeEngine(img);
+  applyOperations(img, rand, nullptr);
+}
+
+/* Apply the pipeline to an image using an externally provided seed */
+void Pipeline::apply(Image& img, unsigned int seed) {
+  uint32_t tid_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  std::mt19937 rand(seed ^ tid_hash);
+  applyOperations(img, rand, nullptr);
+}
+
+/* Apply the pipeline with a caller-owned engine (fully reproducible) */
+void Pipeline::apply(Image& img, std::mt19937& rand) const {
+  applyOperations(img, rand, nullptr);
+}
+
+/* Apply the pipeline to an image, recording per-operation latencies */
+void Pipeline::apply(Image& img, ThreadProfile& profile) {
+  std::mt19937 rand = makeEngine(img);
+  applyOperations(img, rand, &profile);
+}
+
+/* Number of operations */
+size_t Pipeline::size() const { return operations_.size(); }
+
+/* Short operation names, taken from the part of name() before the colon */
+std::vector<std::string> Pipeline::operationLabels() const {
+  return labels_;
+}
+
+/* Seed a random engine from base seed, image name, thread and time */
+std::mt19937 Pipeline::makeEngine(const Image& img) const {
   uint32_t name_hash =
       static_cast<uint32_t>(std::hash<std::string>{}(img.getName()));
   uint32_t tid_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
   uint32_t now = static_cast<uint32_t>(
       std::chrono::steady_clock::now().time_since_epoch().count());
-  std::mt19937 rand(base_seed_ ^ name_hash ^ tid_hash ^ now);
-  std::uniform_real_distribution<double> dist(0.0, 1.0);
-
-  // Iterate over operations, applying operation
-  for (const OperationEntry& op : operations_) {
-    double probs = dist(rand);
-    if (probs <= op.prob) op.op->apply(img, rand);
-  }
+  return std::mt19937(base_seed_ ^ name_hash ^ tid_hash ^ now);
 }
 
-/* Apply the pipeline to an image using an externally provided seed */
-void Pipeline::apply(Image& img, unsigned int seed) {
-  uint32_t tid_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
-  std::mt19937 rand(seed ^ tid_hash);
+/* Iterate over operations, applying each with its probability */
+void Pipeline::applyOperations(Image& img, std::mt19937& rand,
+                               ThreadProfile* profile) const {
   std::uniform_real_distribution<double> dist(0.0, 1.0);
 
-  // Iterate over operations, applying operation
-  for (const OperationEntry& op : operations_) {
+  for (size_t i = 0; i < operations_.size(); ++i) {
+    const OperationEntry& op = operations_[i];
     double probs = dist(rand);
-    if (probs <= op.prob) op.op->apply(img, rand);
+    if (probs > op.prob) continue;
+    AUGMENTO_PROBE4(op__start, labels_[i].c_str(), i, img.getData().cols,
+                    img.getData().rows);
+    if (!profile) {
+      op.op->apply(img, rand);
+    } else {
+      OpCost cost;
+      if (profile->costModel()) cost = op.op->cost(img.getData());
+      const PerfCounterGroup* perf = profile->perf();
+      PerfSample before;
+      if (perf) before = perf->read();
+      uint64_t start = nowNs();
+      op.op->apply(img, rand);
+      uint64_t end = nowNs();
+      if (perf) profile->recordOpPerf(i, perf->read().since(before));
+      profile->recordOp(i, start, end);
+      if (profile->costModel()) profile->recordOpCost(i, cost);
+      if (profile->taskOpTiming()) {
+        auto& ops = img.getTiming().ops;
+        if (ops.empty()) ops.reserve(operations_.size());
+        ops.push_back({static_cast<uint32_t>(i), end - start});
+      }
+    }
+    AUGMENTO_PROBE4(op__end, labels_[i].c_str(), i, img.getData().cols,
+                    img.getData().rows);
   }
 }
 
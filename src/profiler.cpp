@@ -0,0 +1,428 @@
+/**
+ * @file profiler.cpp
+ * @brief Implementation of the latency histograms and profiles defined in
+ * profiler.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/profiler.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+
+/* Human-readable duration */
+std::string formatDuration(double ns) {
+  char buf[32];
+  if (ns < 1e3)
+    std::snprintf(buf, sizeof(buf), "%.0fns", ns);
+  else if (ns < 1e6)
+    std::snprintf(buf, sizeof(buf), "%.1fus", ns / 1e3);
+  else if (ns < 1e9)
+    std::snprintf(buf, sizeof(buf), "%.2fms", ns / 1e6);
+  else
+    std::snprintf(buf, sizeof(buf), "%.2fs", ns / 1e9);
+  return buf;
+}
+
+/** ---------------- LatencyHistogram ---------------- **/
+LatencyHistogram::LatencyHistogram() : buckets_(kBucketCount, 0) {}
+
+size_t LatencyHistogram::bucketIndex(uint64_t ns) {
+  if (ns < kSubCount) return static_cast<size_t>(ns);
+  int msb = 63 - __builtin_clzll(ns);
+  if (msb >= kMaxBits) return kBucketCount - 1;
+  int exp = msb - kSubBits;
+  return static_cast<size_t>((exp + 1) * kSubCount + ((ns >> exp) - kSubCount));
+}
+
+uint64_t LatencyHistogram::bucketValue(size_t index) {
+  if (index < kSubCount) return index;
+  int exp = static_cast<int>(index / kSubCount) - 1;
+  uint64_t mantissa = kSubCount + index % kSubCount;
+  return (mantissa << exp) + ((1ull << exp) >> 1);
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+  ++buckets_[bucketIndex(ns)];
+  ++count_;
+  total_ += ns;
+  if (ns < min_) min_ = ns;
+  if (ns > max_) max_ = ns;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i < kBucketCount; ++i) buckets_[i] += other.buckets_[i];
+  count_ += other.count_;
+  total_ += other.total_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+  if (count_ == 0) return 0;
+  q = std::clamp(q, 0.0, 1.0);
+  uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_))));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank) return std::clamp(bucketValue(i), min_, max_);
+  }
+  return max_;
+}
+
+/** ---------------- Stage names ---------------- **/
+const char* stageName(Stage stage) {
+  switch (stage) {
+    case Stage::Read:
+      return "read";
+    case Stage::Decode:
+      return "decode";
+    case Stage::Augment:
+      return "augment";
+    case Stage::Encode:
+      return "encode";
+    case Stage::Write:
+      return "write";
+    default:
+      return "unknown";
+  }
+}
+
+/** ---------------- Sojourn names ---------------- **/
+const char* sojournName(Sojourn span) {
+  switch (span) {
+    case Sojourn::Admission:
+      return "admission";
+    case Sojourn::Handoff:
+      return "handoff";
+    case Sojourn::EndToEnd:
+      return "end-to-end";
+    default:
+      return "unknown";
+  }
+}
+
+/** ---------------- LiveCounters ---------------- **/
+LiveCounters& LiveCounters::operator=(const LiveCounters& other) {
+  completed.store(other.completed.load());
+  failed.store(other.failed.load());
+  bytes_in.store(other.bytes_in.load());
+  bytes_out.store(other.bytes_out.load());
+  for (size_t s = 0; s < kStageCount; ++s)
+    busy_ns[s].store(other.busy_ns[s].load());
+  return *this;
+}
+
+LiveOpCounters& LiveOpCounters::operator=(const LiveOpCounters& other) {
+  fired.store(other.fired.load());
+  busy_ns.store(other.busy_ns.load());
+  return *this;
+}
+
+/** ---------------- FormatTotals ---------------- **/
+void FormatTotals::merge(const FormatTotals& other) {
+  images += other.images;
+  bytes_in += other.bytes_in;
+  pixels += other.pixels;
+  read_ns += other.read_ns;
+  decode_ns += other.decode_ns;
+  saved += other.saved;
+  bytes_out += other.bytes_out;
+  encode_ns += other.encode_ns;
+  write_ns += other.write_ns;
+}
+
+/* Input format of a path, matching its extension without copying it */
+InputFormat inputFormatOf(const std::string& path) {
+  size_t slash = path.find_last_of("/\\");
+  size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash) ||
+      dot + 1 == path.size())
+    return InputFormat::None;
+  size_t len = path.size() - dot - 1;
+  if (len > 4) return InputFormat::Other;
+  char ext[5] = {};
+  for (size_t i = 0; i < len; ++i)
+    ext[i] = static_cast<char>(
+        std::tolower(static_cast<unsigned char>(path[dot + 1 + i])));
+  auto is = [&](const char* name) { return std::strcmp(ext, name) == 0; };
+  if (is("jpg") || is("jpeg") || is("jpe")) return InputFormat::Jpg;
+  if (is("png")) return InputFormat::Png;
+  if (is("webp")) return InputFormat::Webp;
+  if (is("bmp") || is("dib")) return InputFormat::Bmp;
+  if (is("tif") || is("tiff")) return InputFormat::Tif;
+  if (is("pbm") || is("pgm") || is("ppm") || is("pnm")) return InputFormat::Pnm;
+  if (is("jp2")) return InputFormat::Jp2;
+  if (is("exr")) return InputFormat::Exr;
+  if (is("hdr") || is("pic")) return InputFormat::Hdr;
+  return InputFormat::Other;
+}
+
+const char* formatName(InputFormat format) {
+  switch (format) {
+    case InputFormat::None:
+      return "none";
+    case InputFormat::Jpg:
+      return "jpg";
+    case InputFormat::Png:
+      return "png";
+    case InputFormat::Webp:
+      return "webp";
+    case InputFormat::Bmp:
+      return "bmp";
+    case InputFormat::Tif:
+      return "tif";
+    case InputFormat::Pnm:
+      return "pnm";
+    case InputFormat::Jp2:
+      return "jp2";
+    case InputFormat::Exr:
+      return "exr";
+    case InputFormat::Hdr:
+      return "hdr";
+    default:
+      return "other";
+  }
+}
+
+std::string inputFormat(const std::string& path) {
+  return formatName(inputFormatOf(path));
+}
+
+/** ---------------- ThreadProfile ---------------- **/
+ThreadProfile::ThreadProfile(size_t numOps)
+    : ops_(numOps), live_ops_(numOps), op_cost_(numOps) {}
+
+/** ---------------- RunProfile ---------------- **/
+RunProfile::RunProfile(std::vector<std::string> opLabels)
+    : op_labels_(std::move(opLabels)),
+      ops_(op_labels_.size()),
+      op_perf_(op_labels_.size()),
+      op_cost_(op_labels_.size()) {}
+
+void RunProfile::merge(const ThreadProfile& profile) {
+  for (size_t s = 0; s < kStageCount; ++s)
+    stages_[s].merge(profile.stage(static_cast<Stage>(s)));
+  for (size_t s = 0; s < kSojournCount; ++s)
+    sojourns_[s].merge(profile.sojourn(static_cast<Sojourn>(s)));
+  for (size_t i = 0; i < ops_.size() && i < profile.ops().size(); ++i)
+    ops_[i].merge(profile.ops()[i]);
+  for (size_t i = 0; i < op_perf_.size() && i < profile.opPerf().size(); ++i)
+    op_perf_[i].merge(profile.opPerf()[i]);
+  for (size_t i = 0; i < op_cost_.size() && i < profile.opCosts().size(); ++i)
+    op_cost_[i] += profile.opCosts()[i];
+  for (size_t f = 0; f < kInputFormatCount; ++f) {
+    const FormatTotals& totals = profile.formats()[f];
+    if (totals.images || totals.saved)
+      formats_[formatName(static_cast<InputFormat>(f))].merge(totals);
+  }
+  failures_ += profile.failures();
+  completed_ += profile.live().completed.load();
+  bytes_in_ += profile.live().bytes_in.load();
+  bytes_out_ += profile.live().bytes_out.load();
+}
+
+bool RunProfile::hasPerf() const {
+  for (const PerfTotals& p : op_perf_)
+    if (p.calls) return true;
+  return false;
+}
+
+void RunProfile::writeText(std::ostream& out) const {
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  uint64_t stage_total = 0;
+  for (const auto& h : stages_) stage_total += h.total();
+  uint64_t op_total = 0;
+  for (const auto& h : ops_) op_total += h.total();
+
+  auto share = [](uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * static_cast<double>(part) / whole : 0.0;
+  };
+  auto row = [&](const std::string& name, const LatencyHistogram& h,
+                 double pct) {
+    out << "  " << std::left << std::setw(24) << name << std::right
+        << std::setw(9) << h.count() << std::setw(11)
+        << formatDuration(h.percentile(0.50)) << std::setw(11)
+        << formatDuration(h.percentile(0.95)) << std::setw(11)
+        << formatDuration(h.percentile(0.99)) << std::setw(11)
+        << formatDuration(static_cast<double>(h.total())) << std::setw(8)
+        << std::fixed << std::setprecision(1) << pct << "%\n";
+  };
+  auto header = [&](const char* first) {
+    out << "  " << std::left << std::setw(24) << first << std::right
+        << std::setw(9) << "count" << std::setw(11) << "p50" << std::setw(11)
+        << "p95" << std::setw(11) << "p99" << std::setw(11) << "total"
+        << std::setw(9) << "share" << "\n";
+  };
+
+  out << "[PROFILE] Stage latencies (wall "
+      << formatDuration(static_cast<double>(wall_ns_)) << ", "
+      << failures_ << " failed tasks)\n";
+  header("stage");
+  for (size_t s = 0; s < kStageCount; ++s)
+    row(stageName(static_cast<Stage>(s)), stages_[s],
+        share(stages_[s].total(), stage_total));
+
+  const LatencyHistogram& end_to_end = sojourn(Sojourn::EndToEnd);
+  if (end_to_end.count()) {
+    out << "[PROFILE] Task latencies from arrival (share of end-to-end "
+           "time)\n";
+    header("span");
+    for (size_t s = 0; s < kSojournCount; ++s)
+      row(sojournName(static_cast<Sojourn>(s)), sojourns_[s],
+          share(sojourns_[s].total(), end_to_end.total()));
+  }
+
+  if (!ops_.empty()) {
+    out << "[PROFILE] Operation latencies (share of operation time)\n";
+    header("operation");
+    for (size_t i = 0; i < ops_.size(); ++i)
+      row("#" + std::to_string(i) + " " + op_labels_[i], ops_[i],
+          share(ops_[i].total(), op_total));
+  }
+
+  if (hasPerf()) {
+    // Every LLC miss is assumed to fetch one 64-byte line from memory
+    out << "[PROFILE] Hardware counters per operation (user space, per "
+           "call)\n";
+    out << "  " << std::left << std::setw(24) << "operation" << std::right
+        << std::setw(9) << "calls" << std::setw(8) << "IPC" << std::setw(13)
+        << "cycles" << std::setw(11) << "LLC miss" << std::setw(11)
+        << "br miss" << std::setw(12) << "est. MB/s" << "\n";
+    for (size_t i = 0; i < op_perf_.size(); ++i) {
+      const PerfTotals& p = op_perf_[i];
+      if (!p.calls) continue;
+      auto perCall = [&](PerfEvent e) {
+        return static_cast<double>(p[e]) / p.calls;
+      };
+      double ns = static_cast<double>(ops_[i].total());
+      double mbps = ns > 0 ? p[PerfEvent::LlcMisses] * 64.0 / ns * 1e3 : 0.0;
+      out << "  " << std::left << std::setw(24)
+          << "#" + std::to_string(i) + " " + op_labels_[i] << std::right
+          << std::setw(9) << p.calls << std::fixed << std::setprecision(2)
+          << std::setw(8) << p.ipc() << std::setprecision(0) << std::setw(13)
+          << perCall(PerfEvent::Cycles) << std::setw(11)
+          << perCall(PerfEvent::LlcMisses) << std::setw(11)
+          << perCall(PerfEvent::BranchMisses) << std::setprecision(1)
+          << std::setw(12) << mbps << "\n";
+    }
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void RunProfile::writeJson(JsonWriter& json) const {
+  uint64_t stage_total = 0;
+  for (const auto& h : stages_) stage_total += h.total();
+  uint64_t op_total = 0;
+  for (const auto& h : ops_) op_total += h.total();
+
+  auto histogram = [](JsonWriter& json, const LatencyHistogram& h,
+                      uint64_t whole) {
+    json.field("count", h.count())
+        .field("total_ns", h.total())
+        .field("mean_ns", h.mean())
+        .field("min_ns", h.min())
+        .field("p50_ns", h.percentile(0.50))
+        .field("p95_ns", h.percentile(0.95))
+        .field("p99_ns", h.percentile(0.99))
+        .field("max_ns", h.max())
+        .field("share", whole ? static_cast<double>(h.total()) / whole : 0.0);
+  };
+
+  json.beginObject();
+  json.field("wall_ns", wall_ns_).field("failed_tasks", failures_);
+
+  json.key("stages").beginArray();
+  for (size_t s = 0; s < kStageCount; ++s) {
+    json.beginObject().field("name", stageName(static_cast<Stage>(s)));
+    histogram(json, stages_[s], stage_total);
+    json.endObject();
+  }
+  json.endArray();
+
+  uint64_t end_to_end = sojourn(Sojourn::EndToEnd).total();
+  json.key("latencies").beginArray();
+  for (size_t s = 0; s < kSojournCount; ++s) {
+    json.beginObject().field("name", sojournName(static_cast<Sojourn>(s)));
+    histogram(json, sojourns_[s], end_to_end);
+    json.field("p999_ns", sojourns_[s].percentile(0.999));
+    json.endObject();
+  }
+  json.endArray();
+
+  json.key("operations").beginArray();
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    json.beginObject().field("index", i).field("name", op_labels_[i]);
+    histogram(json, ops_[i], op_total);
+    const PerfTotals& p = op_perf_[i];
+    if (p.calls) {
+      json.key("hardware").beginObject().field("calls", p.calls);
+      for (size_t e = 0; e < kPerfEventCount; ++e)
+        json.field(perfEventName(static_cast<PerfEvent>(e)), p.values[e]);
+      json.field("ipc", p.ipc())
+          .field("est_memory_bytes", p[PerfEvent::LlcMisses] * 64)
+          .endObject();
+    }
+    json.endObject();
+  }
+  json.endArray();
+  json.endObject();
+}
+
+void RunProfile::writeFormatsText(std::ostream& out) const {
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  auto rate = [](double amount, uint64_t ns) {
+    return ns ? amount / (static_cast<double>(ns) / 1e9) : 0.0;
+  };
+
+  double wall_s = static_cast<double>(wall_ns_) / 1e9;
+  out << "[IO] Codec and I/O throughput per input format (run "
+      << std::fixed << std::setprecision(1)
+      << (wall_s > 0 ? completed_ / wall_s : 0.0) << " img/s, "
+      << (wall_s > 0 ? bytes_in_ / wall_s / 1e6 : 0.0)
+      << " MB/s read; rates below are per thread)\n";
+  out << "  " << std::left << std::setw(8) << "format" << std::right
+      << std::setw(9) << "images" << std::setw(10) << "MB in"
+      << std::setw(11) << "read MB/s" << std::setw(10) << "dec MP/s"
+      << std::setw(11) << "dec img/s" << std::setw(11) << "enc img/s"
+      << std::setw(12) << "write MB/s" << "\n";
+  for (const auto& [format, f] : formats_) {
+    out << "  " << std::left << std::setw(8) << format << std::right
+        << std::setw(9) << f.images << std::setprecision(1) << std::setw(10)
+        << f.bytes_in / 1e6 << std::setw(11)
+        << rate(f.bytes_in / 1e6, f.read_ns) << std::setw(10)
+        << rate(f.pixels / 1e6, f.decode_ns) << std::setw(11)
+        << rate(static_cast<double>(f.images), f.decode_ns) << std::setw(11)
+        << rate(static_cast<double>(f.saved), f.encode_ns) << std::setw(12)
+        << rate(f.bytes_out / 1e6, f.write_ns) << "\n";
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void RunProfile::writeFormatsJson(JsonWriter& json) const {
+  json.beginArray();
+  for (const auto& [format, f] : formats_)
+    json.beginObject()
+        .field("format", format)
+        .field("images", f.images)
+        .field("bytes_in", f.bytes_in)
+        .field("pixels", f.pixels)
+        .field("read_ns", f.read_ns)
+        .field("decode_ns", f.decode_ns)
+        .field("saved", f.saved)
+        .field("bytes_out", f.bytes_out)
+        .field("encode_ns", f.encode_ns)
+        .field("write_ns", f.write_ns)
+        .endObject();
+  json.endArray();
+}
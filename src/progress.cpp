@@ -0,0 +1,122 @@
+/**
+ * @file progress.cpp
+ * @brief Implementation of the ProgressReporter class defined in progress.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/progress.hpp"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <iostream>
+
+/* Accumulate one thread's counters */
+void ProgressSnapshot::add(const ThreadProfile& profile) {
+  const LiveCounters& live = profile.live();
+  completed += live.completed.load(std::memory_order_relaxed);
+  failed += live.failed.load(std::memory_order_relaxed);
+  bytes_in += live.bytes_in.load(std::memory_order_relaxed);
+  bytes_out += live.bytes_out.load(std::memory_order_relaxed);
+  for (size_t s = 0; s < kStageCount; ++s)
+    busy_ns[s] += live.busy_ns[s].load(std::memory_order_relaxed);
+
+  const std::vector<LiveOpCounters>& ops = profile.liveOps();
+  if (op_fired.size() < ops.size()) {
+    op_fired.resize(ops.size(), 0);
+    op_busy_ns.resize(ops.size(), 0);
+  }
+  for (size_t i = 0; i < ops.size(); ++i) {
+    op_fired[i] += ops[i].fired.load(std::memory_order_relaxed);
+    op_busy_ns[i] += ops[i].busy_ns.load(std::memory_order_relaxed);
+  }
+}
+
+/* Constructor */
+ProgressReporter::ProgressReporter(std::ostream& out, uint64_t totalTasks,
+                                   size_t producers, size_t consumers,
+                                   std::chrono::milliseconds interval,
+                                   bool inPlace)
+    : out_(out),
+      total_(totalTasks),
+      producers_(producers ? producers : 1),
+      consumers_(consumers ? consumers : 1),
+      interval_ns_(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(interval)
+              .count())),
+      in_place_(inPlace) {}
+
+/* Terminal detection */
+bool ProgressReporter::isTerminal(const std::ostream& out) {
+  if (&out == &std::cout) return isatty(STDOUT_FILENO);
+  if (&out == &std::cerr) return isatty(STDERR_FILENO);
+  return false;
+}
+
+/* Print if interval elapsed */
+void ProgressReporter::update(const ProgressSnapshot& snap) {
+  if (snap.t_ns < last_.t_ns + interval_ns_) return;
+  std::string line = format(last_, snap);
+  if (in_place_) {
+    size_t width = line.size();
+    if (width < last_width_) line.append(last_width_ - width, ' ');
+    last_width_ = width;
+    out_ << '\r' << line << std::flush;
+  } else {
+    out_ << line << '\n' << std::flush;
+  }
+  last_ = snap;
+}
+
+/* Final line over the whole run */
+void ProgressReporter::finish(const ProgressSnapshot& snap) {
+  std::string line = format(ProgressSnapshot{}, snap);
+  if (in_place_) {
+    if (line.size() < last_width_) line.append(last_width_ - line.size(), ' ');
+    out_ << '\r';
+  }
+  out_ << line << '\n' << std::flush;
+  last_width_ = 0;
+}
+
+/* Build status line */
+std::string ProgressReporter::format(const ProgressSnapshot& prev,
+                                     const ProgressSnapshot& cur) const {
+  double window_s = static_cast<double>(cur.t_ns - prev.t_ns) / 1e9;
+  double elapsed_s = static_cast<double>(cur.t_ns) / 1e9;
+  if (window_s <= 0) window_s = 1e-9;
+
+  double rate = (cur.completed - prev.completed) / window_s;
+  double mb_in = (cur.bytes_in - prev.bytes_in) / window_s / 1e6;
+  double mb_out = (cur.bytes_out - prev.bytes_out) / window_s / 1e6;
+
+  uint64_t finished = cur.completed + cur.failed;
+  double pct = total_ ? 100.0 * finished / total_ : 0.0;
+  double avg_rate = elapsed_s > 0 ? cur.completed / elapsed_s : 0.0;
+  std::string eta = "--";
+  if (avg_rate > 0 && total_ >= finished) {
+    eta = formatDuration((total_ - finished) / avg_rate * 1e9);
+  }
+
+  auto busy = [&](Stage stage, size_t threads) {
+    size_t s = static_cast<size_t>(stage);
+    return 100.0 * (cur.busy_ns[s] - prev.busy_ns[s]) /
+           (window_s * 1e9 * threads);
+  };
+
+  char buf[384];
+  std::snprintf(
+      buf, sizeof(buf),
+      "[PROGRESS] %llu/%llu (%.1f%%) %llu failed | %.1f img/s | in %.1f MB/s "
+      "out %.1f MB/s | ETA %s | busy read %.0f%% decode %.0f%% augment %.0f%% "
+      "encode %.0f%% write %.0f%% | queues paths %zu/%zu images %zu/%zu",
+      static_cast<unsigned long long>(cur.completed),
+      static_cast<unsigned long long>(total_), pct,
+      static_cast<unsigned long long>(cur.failed), rate, mb_in, mb_out,
+      eta.c_str(), busy(Stage::Read, producers_),
+      busy(Stage::Decode, producers_), busy(Stage::Augment, producers_),
+      busy(Stage::Encode, consumers_), busy(Stage::Write, consumers_),
+      cur.path_depth, cur.path_capacity, cur.image_depth, cur.image_capacity);
+  return buf;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file queue_monitor.cpp
+ * @brief Implementation of queue occupancy sampling and reporting defined in
+ * queue_monitor.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/queue_monitor.hpp"
+
+#include <iomanip>
+
+/** ---------------- OccupancySeries ---------------- **/
+OccupancySeries::OccupancySeries(size_t capacity, size_t maxSamples)
+    : capacity_(capacity), max_samples_(maxSamples < 2 ? 2 : maxSamples) {}
+
+void OccupancySeries::add(uint64_t t_ns, size_t depth) {
+  ++seen_;
+  depth_sum_ += static_cast<double>(depth);
+  if (depth == 0) ++empty_;
+  if (capacity_ && depth >= capacity_) ++full_;
+
+  if ((seen_ - 1) % stride_ != 0) return;
+  if (samples_.size() >= max_samples_) {
+    // Decimate: keep every other sample and halve the sampling rate
+    size_t kept = 0;
+    for (size_t i = 0; i < samples_.size(); i += 2) samples_[kept++] = samples_[i];
+    samples_.resize(kept);
+    stride_ *= 2;
+    if ((seen_ - 1) % stride_ != 0) return;
+  }
+  samples_.push_back(QueueSample{t_ns, depth});
+}
+
+double OccupancySeries::meanDepth() const {
+  return seen_ ? depth_sum_ / static_cast<double>(seen_) : 0.0;
+}
+
+double OccupancySeries::fullFraction() const {
+  return seen_ ? static_cast<double>(full_) / seen_ : 0.0;
+}
+
+double OccupancySeries::emptyFraction() const {
+  return seen_ ? static_cast<double>(empty_) / seen_ : 0.0;
+}
+
+/** ---------------- QueueReport ---------------- **/
+double QueueReport::pushBlockedFraction(uint64_t wall_ns) const {
+  double budget = static_cast<double>(wall_ns) * push_threads;
+  return budget > 0 ? stats.push_wait_ns / budget : 0.0;
+}
+
+double QueueReport::popBlockedFraction(uint64_t wall_ns) const {
+  double budget = static_cast<double>(wall_ns) * pop_threads;
+  return budget > 0 ? stats.pop_wait_ns / budget : 0.0;
+}
+
+/** ---------------- Reporting ---------------- **/
+void writeQueueText(std::ostream& out, const std::vector<QueueReport>& queues,
+                    uint64_t wall_ns) {
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  out << std::fixed << std::setprecision(1);
+
+  for (const QueueReport& q : queues) {
+    const QueueStats& st = q.stats;
+    out << "[QUEUES] " << q.name << " (capacity " << q.capacity
+        << "): depth mean " << q.series.meanDepth() << ", max "
+        << st.max_depth << "; full " << 100.0 * q.series.fullFraction()
+        << "%, empty " << 100.0 * q.series.emptyFraction()
+        << "% of samples\n";
+    out << "  push (" << q.pushers << "): " << st.pushes << " items, blocked "
+        << st.push_waits << "x for "
+        << formatDuration(static_cast<double>(st.push_wait_ns)) << " ("
+        << 100.0 * q.pushBlockedFraction(wall_ns) << "% of " << q.pushers
+        << " time)\n";
+    out << "  pop  (" << q.poppers << "): " << st.pops << " items, blocked "
+        << st.pop_waits << "x for "
+        << formatDuration(static_cast<double>(st.pop_wait_ns)) << " ("
+        << 100.0 * q.popBlockedFraction(wall_ns) << "% of " << q.poppers
+        << " time)\n";
+    out << "  mutex: " << st.lock_contended << " contended acquisitions, "
+        << formatDuration(static_cast<double>(st.lock_wait_ns))
+        << " waiting\n";
+  }
+
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void writeQueueJson(JsonWriter& json, const std::vector<QueueReport>& queues,
+                    uint64_t wall_ns) {
+  json.beginArray();
+  for (const QueueReport& q : queues) {
+    const QueueStats& st = q.stats;
+    json.beginObject()
+        .field("name", q.name)
+        .field("capacity", q.capacity)
+        .field("pushes", st.pushes)
+        .field("pops", st.pops)
+        .field("max_depth", st.max_depth)
+        .field("mean_depth", q.series.meanDepth())
+        .field("full_fraction", q.series.fullFraction())
+        .field("empty_fraction", q.series.emptyFraction());
+
+    json.key("push").beginObject()
+        .field("side", q.pushers)
+        .field("threads", q.push_threads)
+        .field("blocked_count", st.push_waits)
+        .field("blocked_ns", st.push_wait_ns)
+        .field("blocked_fraction", q.pushBlockedFraction(wall_ns))
+        .endObject();
+    json.key("pop").beginObject()
+        .field("side", q.poppers)
+        .field("threads", q.pop_threads)
+        .field("blocked_count", st.pop_waits)
+        .field("blocked_ns", st.pop_wait_ns)
+        .field("blocked_fraction", q.popBlockedFraction(wall_ns))
+        .endObject();
+    json.key("mutex").beginObject()
+        .field("contended", st.lock_contended)
+        .field("wait_ns", st.lock_wait_ns)
+        .endObject();
+
+    json.key("occupancy").beginArray();
+    for (const QueueSample& s : q.series.samples()) {
+      json.beginArray().value(s.t_ns).value(s.depth).endArray();
+    }
+    json.endArray();
+    json.endObject();
+  }
+  json.endArray();
+}
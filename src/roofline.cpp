@@ -0,0 +1,202 @@
+/**
+ * @file roofline.cpp
+ * @brief Implementation of peak measurement and roofline reporting defined in
+ * roofline.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/roofline.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+
+constexpr size_t kTriadElements = 1 << 22;  // 16 MiB per array, beyond LLC
+constexpr size_t kTriadRepeats = 5;
+constexpr size_t kFmaIterations = 1 << 20;
+constexpr size_t kFmaRepeats = 3;
+
+/* Keeps results observable so kernels are not optimised away */
+volatile float g_sink = 0.0f;
+
+/* Best triad bandwidth: a[i] = b[i] + s * c[i] */
+double measureBandwidth() {
+  std::vector<float> a(kTriadElements), b(kTriadElements, 1.0f),
+      c(kTriadElements, 2.0f);
+  const float s = 3.0f;
+  double best = 0.0;
+  for (size_t r = 0; r < kTriadRepeats; ++r) {
+    uint64_t t0 = nowNs();
+    for (size_t i = 0; i < kTriadElements; ++i) a[i] = b[i] + s * c[i];
+    uint64_t t1 = nowNs();
+    g_sink = g_sink + a[r];
+    double bytes = 3.0 * sizeof(float) * kTriadElements;
+    if (t1 > t0) best = std::max(best, bytes / static_cast<double>(t1 - t0));
+  }
+  return best;  // bytes per ns == GB/s
+}
+
+/* OpenCV dispatches its kernels to the widest SIMD the CPU supports, so the
+ * compute roof is measured with the widest vectors available as well */
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__)
+#define AUGMENTO_WIDEST_SIMD \
+  __attribute__((target_clones("arch=skylake-avx512", "arch=haswell", \
+                               "default")))
+#else
+#define AUGMENTO_WIDEST_SIMD
+#endif
+
+#if defined(__GNUC__)
+typedef float Lanes __attribute__((vector_size(64)));  // 16 floats
+#else
+struct Lanes {
+  float v[16];
+  Lanes operator*(float s) const {
+    Lanes r;
+    for (int i = 0; i < 16; ++i) r.v[i] = v[i] * s;
+    return r;
+  }
+  Lanes operator+(float s) const {
+    Lanes r;
+    for (int i = 0; i < 16; ++i) r.v[i] = v[i] + s;
+    return r;
+  }
+};
+#endif
+
+/* Best multiply-add throughput over independent accumulator chains, enough
+ * of them to cover the latency of the multiply-add units */
+AUGMENTO_WIDEST_SIMD double measureCompute() {
+  constexpr size_t kChains = 12;
+  constexpr size_t kLanes = sizeof(Lanes) / sizeof(float);
+  Lanes acc[kChains];
+  for (size_t c = 0; c < kChains; ++c)
+    for (size_t j = 0; j < kLanes; ++j)
+      reinterpret_cast<float*>(&acc[c])[j] = static_cast<float>(c + j);
+  const float m = 0.999999f, a = 1e-6f;
+  double best = 0.0;
+  for (size_t r = 0; r < kFmaRepeats; ++r) {
+    uint64_t t0 = nowNs();
+    for (size_t it = 0; it < kFmaIterations; ++it) {
+      // Fully unrolled so every chain stays in a register
+      acc[0] = acc[0] * m + a;
+      acc[1] = acc[1] * m + a;
+      acc[2] = acc[2] * m + a;
+      acc[3] = acc[3] * m + a;
+      acc[4] = acc[4] * m + a;
+      acc[5] = acc[5] * m + a;
+      acc[6] = acc[6] * m + a;
+      acc[7] = acc[7] * m + a;
+      acc[8] = acc[8] * m + a;
+      acc[9] = acc[9] * m + a;
+      acc[10] = acc[10] * m + a;
+      acc[11] = acc[11] * m + a;
+    }
+    uint64_t t1 = nowNs();
+    float sum = 0.0f;
+    for (size_t c = 0; c < kChains; ++c)
+      sum += reinterpret_cast<const float*>(&acc[c])[r];
+    g_sink = g_sink + sum;
+    double ops = 2.0 * kChains * kLanes * kFmaIterations;
+    if (t1 > t0) best = std::max(best, ops / static_cast<double>(t1 - t0));
+  }
+  return best;  // ops per ns == Gop/s
+}
+
+}  // namespace
+
+/** ---------------- MachinePeaks ---------------- **/
+MachinePeaks MachinePeaks::measure() {
+  MachinePeaks peaks;
+  peaks.bandwidth_gbs = measureBandwidth();
+  peaks.gops = measureCompute();
+  return peaks;
+}
+
+double MachinePeaks::attainable(double intensity) const {
+  return std::min(gops, intensity * bandwidth_gbs);
+}
+
+/** ---------------- Roofline ---------------- **/
+std::vector<RooflinePoint> rooflinePoints(const RunProfile& profile,
+                                          const MachinePeaks& peaks) {
+  std::vector<RooflinePoint> points;
+  const auto& ops = profile.ops();
+  const auto& costs = profile.opCosts();
+  for (size_t i = 0; i < ops.size() && i < costs.size(); ++i) {
+    double ns = static_cast<double>(ops[i].total());
+    if (ops[i].count() == 0 || ns <= 0) continue;
+    RooflinePoint p;
+    p.index = i;
+    p.label = profile.opLabels()[i];
+    p.calls = ops[i].count();
+    p.intensity = costs[i].intensity();
+    p.achieved_gbs = costs[i].bytes() / ns;
+    p.achieved_gops = costs[i].ops / ns;
+    p.attainable_gops = peaks.attainable(p.intensity);
+    p.memory_bound = p.intensity < peaks.ridge();
+    points.push_back(p);
+  }
+  return points;
+}
+
+void writeRooflineText(std::ostream& out, const RunProfile& profile,
+                       const MachinePeaks& peaks) {
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  out << std::fixed << std::setprecision(2);
+
+  out << "[ROOFLINE] Single-core peaks: " << peaks.bandwidth_gbs << " GB/s, "
+      << peaks.gops << " Gop/s (ridge " << peaks.ridge() << " op/B)\n";
+  out << "  " << std::left << std::setw(24) << "operation" << std::right
+      << std::setw(9) << "op/B" << std::setw(10) << "GB/s" << std::setw(10)
+      << "Gop/s" << std::setw(10) << "roof" << std::setw(8) << "eff"
+      << "  bound\n";
+  for (const RooflinePoint& p : rooflinePoints(profile, peaks)) {
+    out << "  " << std::left << std::setw(24)
+        << "#" + std::to_string(p.index) + " " + p.label << std::right
+        << std::setw(9) << p.intensity << std::setw(10) << p.achieved_gbs
+        << std::setw(10) << p.achieved_gops << std::setw(10)
+        << p.attainable_gops << std::setprecision(0) << std::setw(7)
+        << 100.0 * p.efficiency() << "%" << std::setprecision(2) << "  "
+        << (p.memory_bound ? "memory (fuse)" : "compute (SIMD)") << "\n";
+  }
+
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void writeRooflineJson(JsonWriter& json, const RunProfile& profile,
+                       const MachinePeaks& peaks) {
+  json.beginObject();
+  json.key("peaks")
+      .beginObject()
+      .field("bandwidth_gbs", peaks.bandwidth_gbs)
+      .field("gops", peaks.gops)
+      .field("ridge_ops_per_byte", peaks.ridge())
+      .endObject();
+
+  json.key("operations").beginArray();
+  const auto& costs = profile.opCosts();
+  for (const RooflinePoint& p : rooflinePoints(profile, peaks)) {
+    const OpCost& c = costs[p.index];
+    json.beginObject()
+        .field("index", p.index)
+        .field("name", p.label)
+        .field("calls", p.calls)
+        .field("bytes_read", c.bytes_read)
+        .field("bytes_written", c.bytes_written)
+        .field("ops", c.ops)
+        .field("intensity", p.intensity)
+        .field("achieved_gbs", p.achieved_gbs)
+        .field("achieved_gops", p.achieved_gops)
+        .field("attainable_gops", p.attainable_gops)
+        .field("efficiency", p.efficiency())
+        .field("bound", p.memory_bound ? "memory" : "compute")
+        .endObject();
+  }
+  json.endArray();
+  json.endObject();
+}
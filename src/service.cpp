@@ -0,0 +1,419 @@
+/**
+ * @file service.cpp
+ * @brief Implementation of the Unix domain socket service defined in
+ * service.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/service.hpp"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include "../include/splitmix.hpp"
+#include "../include/stop_signal.hpp"
+
+namespace {
+
+/// Longest pipeline id and format accepted in a request.
+constexpr uint32_t kMaxNameLen = 256;
+
+/// Time between two checks of the stop flag by blocking loops.
+constexpr int kPollMs = 200;
+
+/* Read exactly n bytes; false on end of stream or error */
+bool readFull(int fd, void* buf, size_t n) {
+  auto* p = static_cast<char*>(buf);
+  while (n > 0) {
+    ssize_t got = ::read(fd, p, n);
+    if (got < 0 && errno == EINTR) continue;
+    if (got <= 0) return false;
+    p += got;
+    n -= static_cast<size_t>(got);
+  }
+  return true;
+}
+
+/* Write exactly n bytes without raising SIGPIPE; false on error */
+bool writeFull(int fd, const void* buf, size_t n) {
+  auto* p = static_cast<const char*>(buf);
+  while (n > 0) {
+    ssize_t put = ::send(fd, p, n, MSG_NOSIGNAL);
+    if (put < 0 && errno == EINTR) continue;
+    if (put <= 0) return false;
+    p += put;
+    n -= static_cast<size_t>(put);
+  }
+  return true;
+}
+
+/* Well-mixed seed of variant j of a request */
+uint64_t variantSeed(uint64_t seed, uint64_t variant) {
+  return splitmix64(seed + variant * 0x9e3779b97f4a7c15ULL);
+}
+
+const Pipeline& defaultPipeline(const std::map<std::string, Pipeline>& all) {
+  auto it = all.find("default");
+  if (it == all.end())
+    throw std::invalid_argument(
+        "AugmentService: a pipeline with id \"default\" is required.");
+  return it->second;
+}
+
+}  // namespace
+
+/** ---------------- AugmentService ---------------- **/
+AugmentService::AugmentService(std::map<std::string, Pipeline> pipelines,
+                               ServiceSettings settings)
+    : pipelines_(std::move(pipelines)),
+      settings_(std::move(settings)),
+      augmenter_(defaultPipeline(pipelines_), settings_.workers,
+                 settings_.queue_capacity) {
+  // A request larger than either limit could never be admitted; refuse it
+  // as malformed rather than answering Busy forever
+  settings_.max_count = static_cast<uint32_t>(std::min<size_t>(
+      settings_.max_count,
+      std::min(settings_.max_pending, settings_.max_client_pending)));
+  if (settings_.max_count == 0)
+    throw std::invalid_argument(
+        "AugmentService: pending-image limits must be at least 1.");
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  if (settings_.socket_path.empty() ||
+      settings_.socket_path.size() >= sizeof(addr.sun_path))
+    throw std::invalid_argument("[ERROR] Invalid socket path " +
+                                settings_.socket_path + ".");
+  std::strncpy(addr.sun_path, settings_.socket_path.c_str(),
+               sizeof(addr.sun_path) - 1);
+
+  listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (listen_fd_ < 0)
+    throw std::runtime_error("[ERROR] Could not create service socket: " +
+                             std::string(std::strerror(errno)));
+  // Replace a stale socket left by an earlier server, but nothing else
+  struct stat st;
+  if (stat(addr.sun_path, &st) == 0 && S_ISSOCK(st.st_mode))
+    unlink(addr.sun_path);
+  if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      listen(listen_fd_, 64) < 0) {
+    std::string reason = std::strerror(errno);
+    close(listen_fd_);
+    throw std::runtime_error("[ERROR] Could not listen on " +
+                             settings_.socket_path + ": " + reason);
+  }
+
+  dispatch_thread_ = std::thread(&AugmentService::dispatchLoop, this);
+  accept_thread_ = std::thread(&AugmentService::acceptLoop, this);
+}
+
+AugmentService::~AugmentService() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  if (accept_thread_.joinable()) accept_thread_.join();
+  // Answers every queued request with ShuttingDown
+  if (dispatch_thread_.joinable()) dispatch_thread_.join();
+  // Stop reading; replies to requests already in the pool still go out
+  for (auto& conn : connections_) shutdown(conn.fd, SHUT_RD);
+  for (auto& conn : connections_)
+    if (conn.thread.joinable()) conn.thread.join();
+  connections_.clear();
+  close(listen_fd_);
+  unlink(settings_.socket_path.c_str());
+}
+
+/** AugmentService snapshot function **/
+ProgressSnapshot AugmentService::snapshot() const {
+  return augmenter_.snapshot();
+}
+
+/** AugmentService rejected accessor **/
+uint64_t AugmentService::rejected() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return rejected_;
+}
+
+/** AugmentService accept loop **/
+void AugmentService::acceptLoop() {
+  while (!stop_) {
+    for (auto it = connections_.begin(); it != connections_.end();) {
+      if (!it->finished) {
+        ++it;
+        continue;
+      }
+      it->thread.join();
+      it = connections_.erase(it);
+    }
+    pollfd pfd{listen_fd_, POLLIN, 0};
+    if (poll(&pfd, 1, kPollMs) <= 0) continue;
+    int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) continue;
+    connections_.emplace_back();
+    Connection& conn = connections_.back();
+    conn.fd = fd;
+    conn.thread = std::thread([this, &conn] { serveConnection(conn); });
+  }
+}
+
+/** AugmentService serve one connection **/
+void AugmentService::serveConnection(Connection& conn) {
+  // Fairness is per peer process, however many connections it opens
+  ucred cred{};
+  socklen_t len = sizeof(cred);
+  uint64_t client =
+      getsockopt(conn.fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0
+          ? static_cast<uint64_t>(cred.pid)
+          : (1ull << 32) | static_cast<uint64_t>(conn.fd);
+
+  ServiceRequestHeader head;
+  while (readFull(conn.fd, &head, sizeof(head))) {
+    bool valid = head.magic == kServiceRequestMagic &&
+                 head.version == kServiceVersion &&
+                 head.pipeline_len <= kMaxNameLen &&
+                 head.format_len <= kMaxNameLen &&
+                 head.payload_len <= settings_.max_payload;
+    std::string pipeline_id(valid ? head.pipeline_len : 0, '\0');
+    std::string format(valid ? head.format_len : 0, '\0');
+    std::vector<uchar> payload(valid ? head.payload_len : 0);
+    if (valid && !(readFull(conn.fd, &pipeline_id[0], pipeline_id.size()) &&
+                   readFull(conn.fd, &format[0], format.size()) &&
+                   readFull(conn.fd, payload.data(), payload.size())))
+      break;
+
+    Reply reply;
+    if (valid) {
+      reply = admit(client, head, pipeline_id, std::move(format),
+                    std::move(payload))
+                  .get();
+    } else {
+      reply.status = ServiceStatus::BadRequest;
+      reply.message = "malformed request header";
+    }
+    ServiceResponseHeader out;
+    out.status = static_cast<int32_t>(reply.status);
+    out.count = static_cast<uint32_t>(reply.images.size());
+    out.message_len = static_cast<uint32_t>(reply.message.size());
+    bool sent = writeFull(conn.fd, &out, sizeof(out)) &&
+                writeFull(conn.fd, reply.message.data(), reply.message.size());
+    for (const auto& image : reply.images) {
+      uint64_t length = image.size();
+      sent = sent && writeFull(conn.fd, &length, sizeof(length)) &&
+             writeFull(conn.fd, image.data(), image.size());
+    }
+    // The stream cannot be resynchronised after a bad header
+    if (!sent || !valid) break;
+  }
+  close(conn.fd);
+  conn.finished = true;
+}
+
+/** AugmentService admit one request **/
+std::future<AugmentService::Reply> AugmentService::admit(
+    uint64_t client, const ServiceRequestHeader& head,
+    const std::string& pipeline_id, std::string format,
+    std::vector<uchar> payload) {
+  auto request = std::make_shared<Pending>();
+  std::future<Reply> future = request->reply.get_future();
+  auto answer = [&](ServiceStatus status, std::string message) {
+    Reply reply;
+    reply.status = status;
+    reply.message = std::move(message);
+    request->reply.set_value(std::move(reply));
+    return std::move(future);
+  };
+
+  if (head.count == 0 || head.count > settings_.max_count)
+    return answer(ServiceStatus::BadRequest,
+                  "count must be between 1 and " +
+                      std::to_string(settings_.max_count));
+  std::string id = pipeline_id.empty() ? "default" : pipeline_id;
+  auto it = pipelines_.find(id);
+  if (it == pipelines_.end())
+    return answer(ServiceStatus::UnknownPipeline, "no pipeline '" + id + "'");
+  if (format.empty()) format = ".jpg";
+  if (format[0] != '.') format = "." + format;
+  request->client = client;
+  request->pipeline = &it->second;
+  request->key = id + '\n' + format;
+  request->format = format;
+  request->count = head.count;
+  request->seed = head.seed;
+
+  // Reserve before decoding, so an overloaded server does no work
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (stop_)
+      return answer(ServiceStatus::ShuttingDown, "server is shutting down");
+    size_t& mine = client_images_[client];
+    if (pending_images_ + head.count > settings_.max_pending ||
+        mine + head.count > settings_.max_client_pending) {
+      ++rejected_;
+      if (!mine) client_images_.erase(client);
+      return answer(ServiceStatus::Busy,
+                    std::to_string(pending_images_) + " images pending");
+    }
+    pending_images_ += head.count;
+    mine += head.count;
+  }
+
+  std::vector<uchar> bytes;
+  std::string error;
+  if (head.source == 1) {
+    std::string path(payload.begin(), payload.end());
+    if (Image::readFile(path, bytes) != 0) error = "could not read " + path;
+  } else {
+    bytes = std::move(payload);
+  }
+  Image img;
+  if (error.empty() && img.decode(bytes) != 0)
+    error = "could not decode image";
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!error.empty() || stop_) {
+    releaseImages(*request);
+    return error.empty()
+               ? answer(ServiceStatus::ShuttingDown, "server is shutting down")
+               : answer(ServiceStatus::BadRequest, error);
+  }
+  request->image = std::move(img.getData());
+  queues_[client].push_back(request);
+  cv_.notify_all();
+  return future;
+}
+
+/** AugmentService dispatcher loop **/
+void AugmentService::dispatchLoop() {
+  // Enough to keep every worker busy; beyond it, requests wait and coalesce
+  size_t limit = 2 * augmenter_.workers();
+  std::unique_lock<std::mutex> lock(mtx_);
+  for (;;) {
+    cv_.wait(lock, [&] {
+      return stop_ || (!queues_.empty() && in_flight_images_ < limit);
+    });
+    if (stop_) break;
+    std::vector<std::shared_ptr<Pending>> batch = takeBatch();
+    for (const auto& request : batch) in_flight_images_ += request->count;
+    lock.unlock();
+    submit(std::move(batch));
+    lock.lock();
+  }
+
+  for (auto& [client, queue] : queues_) {
+    for (auto& request : queue) {
+      releaseImages(*request);
+      Reply reply;
+      reply.status = ServiceStatus::ShuttingDown;
+      reply.message = "server is shutting down";
+      request->reply.set_value(std::move(reply));
+    }
+  }
+  queues_.clear();
+}
+
+/** AugmentService take one batch **/
+std::vector<std::shared_ptr<AugmentService::Pending>>
+AugmentService::takeBatch() {
+  // Start with the client after the one served last, wrapping around
+  auto first = queues_.upper_bound(next_client_);
+  if (first == queues_.end()) first = queues_.begin();
+  next_client_ = first->first;
+  std::vector<std::shared_ptr<Pending>> batch{first->second.front()};
+  first->second.pop_front();
+  size_t images = batch.front()->count;
+  const std::string& key = batch.front()->key;
+
+  // At most one request per client, so no client can fill a batch alone
+  auto it = first;
+  for (size_t visited = 1;
+       visited < queues_.size() && images < settings_.max_batch; ++visited) {
+    if (++it == queues_.end()) it = queues_.begin();
+    auto& queue = it->second;
+    if (queue.empty() || queue.front()->key != key ||
+        images + queue.front()->count > settings_.max_batch)
+      continue;
+    images += queue.front()->count;
+    batch.push_back(queue.front());
+    queue.pop_front();
+  }
+  for (auto q = queues_.begin(); q != queues_.end();)
+    q = q->second.empty() ? queues_.erase(q) : std::next(q);
+  return batch;
+}
+
+/** AugmentService submit one batch **/
+void AugmentService::submit(std::vector<std::shared_ptr<Pending>> batch) {
+  std::vector<cv::Mat> images;
+  BatchOptions options;
+  options.pipeline = batch.front()->pipeline;
+  options.encode = batch.front()->format;
+  for (const auto& request : batch) {
+    for (uint32_t j = 0; j < request->count; ++j) {
+      images.push_back(request->image);
+      options.seeds.push_back(variantSeed(request->seed, j));
+    }
+  }
+  augmenter_.submit(
+      std::move(images), std::move(options),
+      [this, batch](AugmentedBatch&& done) {
+        std::vector<Reply> replies(batch.size());
+        size_t offset = 0;
+        for (size_t r = 0; r < batch.size(); ++r) {
+          auto begin = done.encoded.begin() + offset;
+          offset += batch[r]->count;
+          replies[r].images.assign(
+              std::make_move_iterator(begin),
+              std::make_move_iterator(done.encoded.begin() + offset));
+        }
+        // Free the budget first, so a client's next request is admitted
+        {
+          std::lock_guard<std::mutex> lock(mtx_);
+          for (const auto& request : batch) {
+            releaseImages(*request);
+            in_flight_images_ -= request->count;
+          }
+        }
+        cv_.notify_all();
+        for (size_t r = 0; r < batch.size(); ++r)
+          batch[r]->reply.set_value(std::move(replies[r]));
+      });
+}
+
+/** AugmentService release admitted images **/
+void AugmentService::releaseImages(const Pending& request) {
+  pending_images_ -= request.count;
+  auto it = client_images_.find(request.client);
+  if (it == client_images_.end()) return;
+  it->second -= request.count;
+  if (!it->second) client_images_.erase(it);
+}
+
+/** ---------------- Serve ---------------- **/
+void serveSocket(std::map<std::string, Pipeline> pipelines,
+                 const ServiceSettings& settings, std::ostream& log) {
+  StopSignalGuard stop;
+  {
+    size_t count = pipelines.size();
+    AugmentService service(std::move(pipelines), settings);
+    log << "[INFO] Serving " << count << " pipeline(s) with "
+        << settings.workers << " workers on " << settings.socket_path
+        << std::endl;
+    while (!stop.stopped())
+      std::this_thread::sleep_for(std::chrono::milliseconds(kPollMs));
+    ProgressSnapshot snap = service.snapshot();
+    log << "[INFO] Stopping: " << snap.completed << " images augmented, "
+        << snap.failed << " failed, " << service.rejected()
+        << " requests rejected as busy." << std::endl;
+  }
+}
@@ -8,6 +8,19 @@
 
 #include "../include/session_manager.hpp"
 
+/* Parse a flag's integer value, rejecting anything below `min` */
+static long parseCount(const std::string& flag, const std::string& value,
+                       long min) {
+  long count = min - 1;
+  try {
+    count = std::stol(value);
+  } catch (const std::exception&) {
+  }
+  if (count < min)
+    throw std::invalid_argument("[ERROR] Invalid " + flag + " " + value + ".");
+  return count;
+}
+
 /* Class constructor for SessionManager */
 SessionManager::SessionManager(int argc, char* argv[])
     : argc_(argc), argv_(argv) {}
@@ -45,6 +58,111 @@ void SessionManager::parseArguments() {
     } else if (arg == "--dry-run") {
       dry_run_ = true;
       std::cout << "[INFO] Dry-run mode enabled.\n";
+    } else if (arg == "--dry-run-samples" && i + 1 < argc_) {
+      std::string value = argv_[++i];
+      int count = 0;
+      try {
+        count = std::stoi(value);
+      } catch (const std::exception&) {
+        count = -1;
+      }
+      if (count < 1)
+        throw std::invalid_argument("[ERROR] Invalid --dry-run-samples " +
+                                    value + ".");
+      dry_run_samples_ = static_cast<size_t>(count);
+    } else if (arg == "--profile" && i + 1 < argc_) {
+      profile_path_ = argv_[++i];
+    } else if (arg == "--trace" && i + 1 < argc_) {
+      trace_path_ = argv_[++i];
+    } else if (arg == "--metrics-port" && i + 1 < argc_) {
+      std::string value = argv_[++i];
+      int port = 0;
+      try {
+        port = std::stoi(value);
+      } catch (const std::exception&) {
+        port = -1;
+      }
+      if (port < 1 || port > 65535)
+        throw std::invalid_argument("[ERROR] Invalid --metrics-port " +
+                                    value + ".");
+      metrics_port_ = static_cast<uint16_t>(port);
+    } else if (arg == "--metrics-file" && i + 1 < argc_) {
+      metrics_path_ = argv_[++i];
+    } else if (arg == "--perf-counters") {
+      perf_counters_ = true;
+    } else if (arg == "--roofline") {
+      roofline_ = true;
+    } else if (arg == "--mem-profile") {
+      mem_profile_ = true;
+    } else if (arg == "--slowest" && i + 1 < argc_) {
+      std::string value = argv_[++i];
+      int count = 0;
+      try {
+        count = std::stoi(value);
+      } catch (const std::exception&) {
+        count = -1;
+      }
+      if (count < 1)
+        throw std::invalid_argument("[ERROR] Invalid --slowest " + value +
+                                    ".");
+      slowest_ = static_cast<size_t>(count);
+    } else if (arg == "--advise") {
+      advise_ = true;
+    } else if (arg == "--io-only") {
+      io_only_ = true;
+    } else if (arg == "--skip-write") {
+      if (sink_ == SinkMode::Full) sink_ = SinkMode::SkipWrite;
+    } else if (arg == "--skip-encode") {
+      sink_ = SinkMode::SkipEncode;
+    } else if (arg == "--cold-cache") {
+      cold_cache_ = true;
+    } else if (arg == "--serve-shm" && i + 1 < argc_) {
+      shm_.name = argv_[++i];
+      if (shm_.name.empty() || shm_.name[0] != '/') shm_.name = "/" + shm_.name;
+      serve_shm_ = true;
+    } else if (arg == "--shm-batch" && i + 1 < argc_) {
+      shm_.batch = static_cast<size_t>(parseCount(arg, argv_[++i], 1));
+    } else if (arg == "--shm-slots" && i + 1 < argc_) {
+      shm_.slots = static_cast<uint32_t>(parseCount(arg, argv_[++i], 1));
+    } else if (arg == "--shm-epochs" && i + 1 < argc_) {
+      shm_.epochs = static_cast<uint64_t>(parseCount(arg, argv_[++i], 0));
+    } else if (arg == "--shm-shape" && i + 1 < argc_) {
+      std::string value = argv_[++i];
+      char x1 = 0, x2 = 0;
+      std::istringstream in(value);
+      in >> shm_.height >> x1 >> shm_.width >> x2 >> shm_.channels;
+      // Images decode as BGR and are converted to grey or BGRA only
+      if (!in || x1 != 'x' || x2 != 'x' || shm_.height < 1 ||
+          shm_.width < 1 ||
+          (shm_.channels != 1 && shm_.channels != 3 && shm_.channels != 4))
+        throw std::invalid_argument("[ERROR] Invalid --shm-shape " + value +
+                                    ", expected HxWxC with C 1, 3 or 4.");
+    } else if (arg == "--shm-layout" && i + 1 < argc_) {
+      std::string value = argv_[++i];
+      if (value == "nhwc")
+        shm_.layout = TensorLayout::NHWC;
+      else if (value == "nchw")
+        shm_.layout = TensorLayout::NCHW;
+      else
+        throw std::invalid_argument("[ERROR] Invalid --shm-layout " + value +
+                                    ".");
+    } else if (arg == "--serve-socket" && i + 1 < argc_) {
+      socket_.socket_path = argv_[++i];
+      serve_socket_ = true;
+    } else if (arg == "--socket-pipeline" && i + 1 < argc_) {
+      std::string value = argv_[++i];
+      size_t eq = value.find('=');
+      if (eq == 0 || eq == std::string::npos || eq + 1 == value.size())
+        throw std::invalid_argument("[ERROR] Invalid --socket-pipeline " +
+                                    value + ", expected <id>=<config.json>.");
+      socket_pipelines_[value.substr(0, eq)] = value.substr(eq + 1);
+    } else if (arg == "--socket-max-pending" && i + 1 < argc_) {
+      socket_.max_pending = static_cast<size_t>(parseCount(arg, argv_[++i], 1));
+    } else if (arg == "--socket-client-pending" && i + 1 < argc_) {
+      socket_.max_client_pending =
+          static_cast<size_t>(parseCount(arg, argv_[++i], 1));
+    } else if (arg == "--socket-batch" && i + 1 < argc_) {
+      socket_.max_batch = static_cast<size_t>(parseCount(arg, argv_[++i], 1));
     } else if ((arg == "--help") || (arg == "-h")) {
       std::cout << R"(
 Usage: augmento [OPTIONS]
@@ -54,7 +172,40 @@ Required:
 
 Optional:
   --tui                 Launch TUI mode (not yet implemented)
-  --dry-run             Perform a dry run without writing any files
+  --dry-run             Estimate time, output size and memory from a sample,
+                        without writing any files
+  --dry-run-samples <n> Tasks sampled by --dry-run (default 16)
+  --profile <path>      Write the run summary (latencies, queues) as JSON
+  --trace <path>        Write a Chrome/Perfetto trace of every thread's timeline
+  --metrics-port <port> Serve Prometheus metrics on 127.0.0.1:<port>/metrics
+  --metrics-file <path> Periodically write Prometheus metrics to <path>
+  --perf-counters       Sample hardware counters around every operation
+  --roofline            Place every operation on a roofline of measured peaks
+  --mem-profile         Account cv::Mat memory per stage and sample RSS
+  --slowest <n>         Report the n slowest tasks with per-stage timings
+  --advise              Diagnose the run's bottleneck and recommend settings
+  --io-only             Skip augmentation: measure read, decode, encode, write
+  --skip-write          Encode images but do not write them
+  --skip-encode         Discard decoded images (no encode, no write)
+  --cold-cache          Drop input files from the page cache before the run
+  --serve-shm <name>    Serve augmented batches into shared memory /<name>
+                        for a trainer (see include/augmento_ring.h)
+  --shm-batch <n>       Images per served batch (default 32)
+  --shm-shape <HxWxC>   Shape of served images, C 1, 3 or 4
+                        (default 224x224x3)
+  --shm-layout <l>      Served tensor layout, nhwc or nchw (default nhwc)
+  --shm-slots <n>       Batches the ring holds (default 4)
+  --shm-epochs <n>      Passes over the inputs (default 0: until stopped)
+  --serve-socket <path> Serve augmentation requests on a Unix socket
+                        (see include/service.hpp)
+  --socket-pipeline <id>=<config>
+                        Also serve the pipeline of another config as <id>
+                        (the --config pipeline is "default"; repeatable)
+  --socket-batch <n>    Images coalesced into one pool batch (default 64)
+  --socket-max-pending <n>
+                        Admitted images before replying Busy (default 1024)
+  --socket-client-pending <n>
+                        The same limit per client process (default 256)
   --help, -h            Show this help message and exit
 )";
       std::exit(0);
@@ -90,18 +241,190 @@ void SessionManager::loadConfiguration() {
 
 /* Prepare pipeline based on config */
 void SessionManager::preparePipeline() {
+  if (io_only_) {
+    // Keep the full read/decode/encode/write plumbing around an empty pipeline
+    pipeline_ = Pipeline();
+    std::cout << "[INFO] I/O-only mode: augmentation pipeline disabled.\n";
+    return;
+  }
   pipeline_ = configurePipeline(config_.pipeline_specs, config_.seed);
 }
 
 /* Executes augmentation over specified number of threads */
 void SessionManager::launchThreads() {
   if (dry_run_) {
+    dryRun();
     std::cout << "[INFO] Successfully completed dry run.\n";
     std::exit(0);
   }
+  if (serve_shm_) {
+    serveShm();
+    return;
+  }
+  if (serve_socket_) {
+    serveService();
+    return;
+  }
+  if (roofline_) {
+    peaks_ = MachinePeaks::measure();
+    std::cout << "[INFO] Measured single-core peaks: " << peaks_.bandwidth_gbs
+              << " GB/s, " << peaks_.gops << " Gop/s\n";
+  }
+  if (cold_cache_) {
+    size_t dropped = 0;
+    for (const auto& path : image_paths_)
+      if (Image::dropCache(path.string()) == 0) ++dropped;
+    std::cout << "[INFO] Dropped " << dropped << " of " << image_paths_.size()
+              << " input files from the page cache.\n";
+    if (dropped < image_paths_.size())
+      std::cerr << "[WARN] Some inputs may still be cached; the cold-cache "
+                   "read timings are optimistic.\n";
+  }
   ThreadController thread_controller(config_.num_threads,
                                      config_.queue_capacity);
+  thread_controller.setWriterCount(config_.num_writers);
+  thread_controller.setOutputFormat(config_.output_format);
+  thread_controller.setSinkMode(sink_);
+  thread_controller.setProgressInterval(
+      std::chrono::milliseconds(config_.progress_interval_ms));
+  if (!trace_path_.empty()) thread_controller.enableTracing();
+  thread_controller.enablePerfCounters(perf_counters_);
+  if (mem_profile_) thread_controller.enableMemoryTracking();
+  if (slowest_) thread_controller.enableSlowTasks(slowest_);
+  thread_controller.enableCostModel(roofline_);
+  thread_controller.enableColdCache(cold_cache_);
+  if (metrics_port_ || !metrics_path_.empty())
+    thread_controller.enableMetrics(metrics_port_, metrics_path_);
   thread_controller.run(image_paths_, config_.iterations, pipeline_,
                         config_.output_dir, config_.verbose,
                         config_.save_specs);
+  reportRun(thread_controller);
+  if (thread_controller.tracer()) writeTrace(*thread_controller.tracer());
+}
+
+/* Estimate the job from a sample of in-memory tasks */
+void SessionManager::dryRun() {
+  EstimateSettings settings;
+  settings.samples = dry_run_samples_;
+  settings.seed = config_.seed;
+  settings.iterations = config_.iterations;
+  settings.shape.producers = config_.num_threads;
+  settings.shape.writers = config_.num_writers;
+  settings.shape.output_ext = config_.output_format;
+  settings.shape.queue_capacity = config_.queue_capacity;
+  settings.shape.hardware_threads = std::thread::hardware_concurrency();
+  std::cout << "[INFO] Sampling " << settings.samples << " of "
+            << image_paths_.size() << " inputs in memory...\n";
+  CostEstimate estimate = estimateRun(image_paths_, pipeline_, settings);
+  writeEstimateText(std::cout, estimate, settings.shape);
+  if (profile_path_.empty()) return;
+
+  std::ofstream out(profile_path_);
+  if (!out) {
+    std::cerr << "[WARN] Could not open profile output " << profile_path_
+              << std::endl;
+    return;
+  }
+  JsonWriter json(out);
+  json.beginObject();
+  json.key("estimate");
+  writeEstimateJson(json, estimate);
+  json.endObject();
+  std::cout << "[INFO] Wrote estimate to " << profile_path_ << "\n";
+}
+
+/* Serve augmented batches into a shared-memory ring until stopped */
+void SessionManager::serveShm() {
+  shm_.seed = config_.seed;
+  shm_.workers = config_.num_threads;
+  shm_.queue_capacity = config_.queue_capacity;
+  serveShmRing(image_paths_, pipeline_, shm_, std::cout);
+}
+
+/* Serve augmentation requests on a Unix socket until stopped */
+void SessionManager::serveService() {
+  std::map<std::string, Pipeline> pipelines;
+  pipelines["default"] = pipeline_;
+  for (const auto& [id, path] : socket_pipelines_) {
+    ConfigSpec spec = parseConfigFile(path);
+    pipelines[id] = configurePipeline(spec.pipeline_specs, spec.seed);
+  }
+  socket_.workers = config_.num_threads;
+  socket_.queue_capacity = config_.queue_capacity;
+  serveSocket(std::move(pipelines), socket_, std::cout);
+}
+
+/* Print run summary and optionally save it as JSON */
+void SessionManager::reportRun(const ThreadController& controller) const {
+  const RunProfile& profile = controller.profile();
+  if (config_.verbose) {
+    profile.writeText(std::cout);
+    writeQueueText(std::cout, controller.queueReports(), profile.wallTime());
+  }
+  if (io_only_ || sink_ != SinkMode::Full) profile.writeFormatsText(std::cout);
+  if (roofline_) writeRooflineText(std::cout, profile, peaks_);
+  if (mem_profile_) writeMemoryText(std::cout, controller.memoryReport());
+  if (controller.slowTasks())
+    writeSlowTasksText(std::cout, *controller.slowTasks(), profile.opLabels());
+  Diagnosis diagnosis;
+  if (advise_) {
+    RunShape shape;
+    shape.producers = config_.num_threads;
+    shape.writers = config_.num_writers;
+    shape.output_ext = config_.output_format;
+    shape.queue_capacity = config_.queue_capacity;
+    shape.hardware_threads = std::thread::hardware_concurrency();
+    diagnosis = diagnoseRun(profile, controller.queueReports(), shape);
+    writeAdviceText(std::cout, diagnosis, profile.opLabels());
+  }
+  if (profile_path_.empty()) return;
+
+  std::ofstream out(profile_path_);
+  if (!out) {
+    std::cerr << "[WARN] Could not open profile output " << profile_path_
+              << std::endl;
+    return;
+  }
+  JsonWriter json(out);
+  json.beginObject();
+  json.key("profile");
+  profile.writeJson(json);
+  json.key("queues");
+  writeQueueJson(json, controller.queueReports(), profile.wallTime());
+  json.key("formats");
+  profile.writeFormatsJson(json);
+  if (roofline_) {
+    json.key("roofline");
+    writeRooflineJson(json, profile, peaks_);
+  }
+  if (mem_profile_) {
+    json.key("memory");
+    writeMemoryJson(json, controller.memoryReport());
+  }
+  if (controller.slowTasks()) {
+    json.key("slowest");
+    writeSlowTasksJson(json, *controller.slowTasks(), profile.opLabels());
+  }
+  if (advise_) {
+    json.key("advice");
+    writeAdviceJson(json, diagnosis, profile.opLabels());
+  }
+  json.endObject();
+  std::cout << "[INFO] Wrote run summary to " << profile_path_ << "\n";
+}
+
+/* Save Chrome trace-event timeline */
+void SessionManager::writeTrace(const Tracer& tracer) const {
+  std::ofstream out(trace_path_);
+  if (!out) {
+    std::cerr << "[WARN] Could not open trace output " << trace_path_
+              << std::endl;
+    return;
+  }
+  tracer.writeChromeJson(out);
+  std::cout << "[INFO] Wrote trace to " << trace_path_;
+  if (tracer.dropped())
+    std::cout << " (" << tracer.dropped()
+              << " oldest events dropped, ring buffers were full)";
+  std::cout << "\n";
 }
@@ -0,0 +1,254 @@
+/**
+ * @file shm_ring.cpp
+ * @brief Implementation of the shared-memory ring producer and the
+ * `--serve-shm` loop defined in shm_ring.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/shm_ring.hpp"
+
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "../include/augmenter.hpp"
+#include "../include/stop_signal.hpp"
+
+namespace {
+
+uint64_t roundUp(uint64_t n, uint64_t to) { return (n + to - 1) / to * to; }
+
+/* True if the ring `name` belongs to a running producer */
+bool ringInUse(const std::string& name) {
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) return false;
+  struct stat st;
+  void* base = MAP_FAILED;
+  if (fstat(fd, &st) == 0 &&
+      static_cast<size_t>(st.st_size) >= sizeof(augmento_ring_header))
+    base = mmap(nullptr, sizeof(augmento_ring_header), PROT_READ, MAP_SHARED,
+                fd, 0);
+  ::close(fd);
+  // Too small or unmapped: a producer died while creating it
+  if (base == MAP_FAILED) return false;
+  const auto* header = static_cast<const augmento_ring_header*>(base);
+  bool live = __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) ==
+                  AUGMENTO_RING_MAGIC &&
+              !__atomic_load_n(&header->closed, __ATOMIC_ACQUIRE);
+  pid_t producer = static_cast<pid_t>(header->producer);
+  munmap(base, sizeof(augmento_ring_header));
+  // kill() with signal 0 only checks that the process exists
+  return live && producer > 0 && (kill(producer, 0) == 0 || errno == EPERM);
+}
+
+}  // namespace
+
+/** ---------------- ShmRingWriter ---------------- **/
+ShmRingWriter::ShmRingWriter(const std::string& name, uint32_t slots,
+                             size_t batch, int height, int width,
+                             int channels, int depth, TensorLayout layout)
+    : name_(name) {
+  if (slots == 0)
+    throw std::invalid_argument("ShmRingWriter: ring needs at least 1 slot.");
+  DLDataType type = dlpackType(depth);
+  uint64_t batch_bytes = static_cast<uint64_t>(batch) * height * width *
+                         channels * (type.bits / 8);
+  uint64_t stride = AUGMENTO_RING_SLOT_HEADER + roundUp(batch_bytes, 64);
+  uint64_t data_offset = roundUp(sizeof(augmento_ring_header), 4096);
+  size_ = data_offset + slots * stride;
+
+  // A crashed or finished earlier server may have left its object behind,
+  // but a live one keeps its ring
+  if (ringInUse(name_))
+    throw std::runtime_error("[ERROR] Shared memory " + name_ +
+                             " is served by another running process: " +
+                             std::strerror(EEXIST));
+  shm_unlink(name_.c_str());
+  int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+    throw std::runtime_error("[ERROR] Could not create shared memory " +
+                             name_ + ": " + std::strerror(errno));
+  if (ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+    std::string reason = std::strerror(errno);
+    ::close(fd);
+    shm_unlink(name_.c_str());
+    throw std::runtime_error("[ERROR] Could not size shared memory " + name_ +
+                             ": " + reason);
+  }
+  void* base = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  std::string reason = std::strerror(errno);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    shm_unlink(name_.c_str());
+    throw std::runtime_error("[ERROR] Could not map shared memory " + name_ +
+                             ": " + reason);
+  }
+
+  // ftruncate() zero-fills, so only the non-zero fields need setting
+  header_ = static_cast<augmento_ring_header*>(base);
+  header_->version = AUGMENTO_RING_VERSION;
+  header_->slot_count = slots;
+  header_->data_offset = data_offset;
+  header_->slot_stride = stride;
+  header_->batch_bytes = batch_bytes;
+  header_->batch = static_cast<uint32_t>(batch);
+  header_->height = static_cast<uint32_t>(height);
+  header_->width = static_cast<uint32_t>(width);
+  header_->channels = static_cast<uint32_t>(channels);
+  header_->dtype_code = type.code;
+  header_->dtype_bits = type.bits;
+  header_->layout = layout == TensorLayout::NHWC ? AUGMENTO_RING_NHWC
+                                                 : AUGMENTO_RING_NCHW;
+  header_->producer = static_cast<uint32_t>(getpid());
+  // Readers treat the ring as ready once the magic is visible
+  __atomic_store_n(&header_->magic, AUGMENTO_RING_MAGIC, __ATOMIC_RELEASE);
+}
+
+ShmRingWriter::~ShmRingWriter() {
+  if (!header_) return;
+  close();
+  munmap(header_, size_);
+  shm_unlink(name_.c_str());
+}
+
+/** ShmRingWriter wait for a free slot **/
+bool ShmRingWriter::waitWritable(uint32_t sequence,
+                                 const std::atomic<bool>& stop) {
+  uint64_t start = 0;
+  for (;;) {
+    uint32_t tail = __atomic_load_n(&header_->tail, __ATOMIC_ACQUIRE);
+    if (sequence - tail < header_->slot_count) break;
+    if (!start) start = nowNs();
+    if (stop.load()) {
+      wait_ns_ += nowNs() - start;
+      return false;
+    }
+    augmento_ring_futex_wait(&header_->tail, tail, AUGMENTO_RING_POLL_MS);
+  }
+  if (start) wait_ns_ += nowNs() - start;
+  return true;
+}
+
+/** ShmRingWriter slot tensor accessor **/
+uchar* ShmRingWriter::tensor(uint32_t sequence) const {
+  return reinterpret_cast<uchar*>(augmento_ring_slot(header_, sequence)) +
+         AUGMENTO_RING_SLOT_HEADER;
+}
+
+/** ShmRingWriter publish function **/
+void ShmRingWriter::publish(uint32_t sequence, uint32_t images,
+                            uint32_t failures, uint64_t epoch) {
+  if (sequence != __atomic_load_n(&header_->head, __ATOMIC_RELAXED))
+    throw std::logic_error("ShmRingWriter: batches must be published in order.");
+  augmento_slot_header* slot = augmento_ring_slot(header_, sequence);
+  slot->sequence = sequence;
+  slot->epoch = epoch;
+  slot->images = images;
+  slot->failures = failures;
+  __atomic_store_n(&header_->head, sequence + 1, __ATOMIC_RELEASE);
+  augmento_ring_futex_wake(&header_->head);
+}
+
+/** ShmRingWriter close function **/
+void ShmRingWriter::close() {
+  __atomic_store_n(&header_->closed, 1u, __ATOMIC_RELEASE);
+  augmento_ring_futex_wake(&header_->head);
+}
+
+/** ShmRingWriter accessors **/
+uint32_t ShmRingWriter::slots() const { return header_->slot_count; }
+
+uint64_t ShmRingWriter::waitNs() const { return wait_ns_; }
+
+/** ---------------- Serve ---------------- **/
+uint64_t serveShmRing(const std::vector<std::filesystem::path>& paths,
+                      const Pipeline& pipeline,
+                      const ShmServeSettings& settings, std::ostream& log) {
+  if (paths.empty())
+    throw std::invalid_argument("[ERROR] No input images to serve.");
+  ShmRingWriter ring(settings.name, settings.slots, settings.batch,
+                     settings.height, settings.width, settings.channels,
+                     CV_8U, settings.layout);
+  // One collator per slot, writing straight into the shared memory
+  std::vector<BatchCollator> collators;
+  collators.reserve(ring.slots());
+  for (uint32_t s = 0; s < ring.slots(); ++s) {
+    collators.emplace_back(settings.batch, settings.height, settings.width,
+                           settings.channels, CV_8U, settings.layout);
+    collators.back().setResize();
+    collators.back().attach(ring.tensor(s));
+  }
+  Augmenter augmenter(pipeline, settings.workers, settings.queue_capacity);
+
+  struct InFlight {
+    uint32_t sequence;
+    uint64_t epoch;
+    uint32_t images;
+    std::future<AugmentedBatch> result;
+  };
+  std::deque<InFlight> in_flight;
+  uint64_t published = 0;
+  auto publishOldest = [&] {
+    InFlight& oldest = in_flight.front();
+    AugmentedBatch done = oldest.result.get();
+    ring.publish(oldest.sequence, oldest.images,
+                 static_cast<uint32_t>(done.failures), oldest.epoch);
+    in_flight.pop_front();
+    ++published;
+  };
+
+  StopSignalGuard stop;
+  log << "[INFO] Serving " << settings.batch << "x" << settings.height << "x"
+      << settings.width << "x" << settings.channels << " batches on "
+      << settings.name << " (" << ring.slots() << " slots)" << std::endl;
+
+  std::mt19937 rng(settings.seed);
+  std::vector<size_t> order(paths.size());
+  std::iota(order.begin(), order.end(), 0);
+  uint32_t sequence = 0;
+  for (uint64_t epoch = 0;
+       !stop.stopped() && (settings.epochs == 0 || epoch < settings.epochs);
+       ++epoch) {
+    std::shuffle(order.begin(), order.end(), rng);
+    for (size_t first = 0; first < order.size(); first += settings.batch) {
+      while (in_flight.size() >= ring.slots()) publishOldest();
+      if (!ring.waitWritable(sequence, stop.flag())) break;
+      size_t last = std::min(order.size(), first + settings.batch);
+      std::vector<std::vector<uchar>> encoded(last - first);
+      for (size_t i = first; i < last; ++i)
+        // An unreadable file stays empty and fails to decode
+        if (Image::readFile(paths[order[i]].string(), encoded[i - first]) != 0)
+          std::cerr << "[WARN] Could not read " << paths[order[i]]
+                    << std::endl;
+      InFlight batch{sequence, epoch, static_cast<uint32_t>(last - first), {}};
+      batch.result = augmenter.submitEncoded(
+          std::move(encoded), collators[sequence % ring.slots()]);
+      in_flight.push_back(std::move(batch));
+      ++sequence;
+      // Publish whatever is already done, keeping the trainer fed
+      while (!in_flight.empty() &&
+             in_flight.front().result.wait_for(std::chrono::seconds(0)) ==
+                 std::future_status::ready)
+        publishOldest();
+    }
+    if (!stop.stopped())
+      log << "[INFO] Served epoch " << epoch << ": " << published
+          << " batches so far, " << formatDuration(ring.waitNs())
+          << " waiting for the trainer" << std::endl;
+  }
+  while (!in_flight.empty()) publishOldest();
+  ring.close();
+  log << "[INFO] Served " << published << " batches." << std::endl;
+  return published;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file slow_tasks.cpp
+ * @brief Implementation of the slowest-task recorder defined in
+ * slow_tasks.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/slow_tasks.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+
+/* Orders a min-heap on service time */
+bool faster(const SlowTask& a, const SlowTask& b) {
+  return a.serviceNs() > b.serviceNs();
+}
+
+double ms(uint64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+const std::string& labelOf(const std::vector<std::string>& labels,
+                           uint32_t index) {
+  static const std::string unknown = "?";
+  return index < labels.size() ? labels[index] : unknown;
+}
+
+}  // namespace
+
+/** ---------------- SlowTaskLog ---------------- **/
+SlowTaskLog::SlowTaskLog(size_t capacity) : capacity_(capacity) {
+  heap_.reserve(capacity_);
+}
+
+void SlowTaskLog::offer(SlowTask&& task) {
+  if (capacity_ == 0) return;
+  uint64_t service = task.serviceNs();
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (heap_.size() == capacity_) {
+    if (service <= heap_.front().serviceNs()) return;
+    std::pop_heap(heap_.begin(), heap_.end(), faster);
+    heap_.back() = std::move(task);
+  } else {
+    heap_.push_back(std::move(task));
+  }
+  std::push_heap(heap_.begin(), heap_.end(), faster);
+  if (heap_.size() == capacity_)
+    threshold_.store(heap_.front().serviceNs(), std::memory_order_relaxed);
+}
+
+void SlowTaskLog::clear() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  heap_.clear();
+  threshold_.store(0, std::memory_order_relaxed);
+  considered_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<SlowTask> SlowTaskLog::slowest() const {
+  std::vector<SlowTask> tasks;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    tasks = heap_;
+  }
+  std::sort(tasks.begin(), tasks.end(), [](const SlowTask& a,
+                                           const SlowTask& b) {
+    return a.serviceNs() > b.serviceNs();
+  });
+  return tasks;
+}
+
+/** ---------------- Reporting ---------------- **/
+void writeSlowTasksText(std::ostream& out, const SlowTaskLog& log,
+                        const std::vector<std::string>& opLabels) {
+  std::vector<SlowTask> tasks = log.slowest();
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  out << std::fixed << std::setprecision(2);
+
+  out << "[SLOWEST] " << tasks.size() << " slowest of " << log.considered()
+      << " tasks (service time, excluding queue waits)\n";
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    const SlowTask& t = tasks[i];
+    const TaskTiming& tm = t.timing;
+    out << "  #" << i + 1 << " " << ms(t.serviceNs()) << " ms  " << t.path
+        << "\n";
+    out << "     " << tm.width << "x" << tm.height << "x" << tm.channels
+        << " -> " << t.out_width << "x" << t.out_height << ", "
+        << tm.bytes_in / 1024 << " KiB in, " << t.bytes_out / 1024
+        << " KiB out\n";
+    out << "     read " << ms(tm.read_ns) << "  decode " << ms(tm.decode_ns)
+        << "  augment " << ms(tm.augment_ns) << "  queued " << ms(t.queued_ns)
+        << "  encode " << ms(t.encode_ns) << "  write " << ms(t.write_ns)
+        << "\n";
+    if (!tm.ops.empty()) {
+      out << "     ops:";
+      for (const OpTiming& op : tm.ops)
+        out << " " << labelOf(opLabels, op.index) << " " << ms(op.ns);
+      out << "\n";
+    }
+  }
+
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void writeSlowTasksJson(JsonWriter& json, const SlowTaskLog& log,
+                        const std::vector<std::string>& opLabels) {
+  json.beginArray();
+  for (const SlowTask& t : log.slowest()) {
+    const TaskTiming& tm = t.timing;
+    json.beginObject()
+        .field("path", t.path)
+        .field("service_ns", t.serviceNs())
+        .field("width", tm.width)
+        .field("height", tm.height)
+        .field("channels", tm.channels)
+        .field("out_width", t.out_width)
+        .field("out_height", t.out_height)
+        .field("bytes_in", tm.bytes_in)
+        .field("bytes_out", t.bytes_out)
+        .field("read_ns", tm.read_ns)
+        .field("decode_ns", tm.decode_ns)
+        .field("augment_ns", tm.augment_ns)
+        .field("queued_ns", t.queued_ns)
+        .field("encode_ns", t.encode_ns)
+        .field("write_ns", t.write_ns);
+    json.key("ops").beginArray();
+    for (const OpTiming& op : tm.ops)
+      json.beginObject()
+          .field("index", op.index)
+          .field("name", labelOf(opLabels, op.index))
+          .field("ns", op.ns)
+          .endObject();
+    json.endArray();
+    json.endObject();
+  }
+  json.endArray();
+}
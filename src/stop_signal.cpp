@@ -0,0 +1,36 @@
+/**
+ * @file stop_signal.cpp
+ * @brief Implementation of the StopSignalGuard defined in stop_signal.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/stop_signal.hpp"
+
+#include <csignal>
+
+namespace {
+
+/// Set by SIGINT/SIGTERM while a guard is in scope.
+std::atomic<bool> g_stop{false};
+
+extern "C" void onStopSignal(int) { g_stop.store(true); }
+
+}  // namespace
+
+/** ---------------- StopSignalGuard ---------------- **/
+StopSignalGuard::StopSignalGuard() {
+  g_stop.store(false);
+  previous_int_ = std::signal(SIGINT, onStopSignal);
+  previous_term_ = std::signal(SIGTERM, onStopSignal);
+}
+
+StopSignalGuard::~StopSignalGuard() {
+  if (previous_int_ != SIG_ERR) std::signal(SIGINT, previous_int_);
+  if (previous_term_ != SIG_ERR) std::signal(SIGTERM, previous_term_);
+}
+
+/** StopSignalGuard accessors **/
+bool StopSignalGuard::stopped() const { return g_stop.load(); }
+
+const std::atomic<bool>& StopSignalGuard::flag() const { return g_stop; }
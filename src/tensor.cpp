@@ -0,0 +1,218 @@
+/**
+ * @file tensor.cpp
+ * @brief Implementation of the DLPack views and the BatchCollator defined in
+ * tensor.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/tensor.hpp"
+
+#include <cstring>
+#include <new>
+#include <opencv2/imgproc.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/// Alignment of batch buffers (one cache line, enough for AVX-512 loads).
+constexpr size_t kAlignment = 64;
+
+/* What a managed tensor keeps alive until its deleter runs */
+struct TensorContext {
+  cv::Mat mat;                     ///< Borrowed image, if any.
+  std::shared_ptr<uchar> buffer;   ///< Batch buffer, if any.
+  std::vector<int64_t> shape;
+  std::vector<int64_t> strides;
+};
+
+void deleteTensor(DLManagedTensor* self) {
+  delete static_cast<TensorContext*>(self->manager_ctx);
+  delete self;
+}
+
+/* Fill a managed tensor from a context whose shape and strides are set */
+DLManagedTensor* makeTensor(TensorContext* ctx, void* data, int depth) {
+  auto* tensor = new DLManagedTensor{};
+  tensor->dl_tensor.data = data;
+  tensor->dl_tensor.device = DLDevice{kDLCPU, 0};
+  tensor->dl_tensor.ndim = static_cast<int32_t>(ctx->shape.size());
+  tensor->dl_tensor.dtype = dlpackType(depth);
+  tensor->dl_tensor.shape = ctx->shape.data();
+  tensor->dl_tensor.strides = ctx->strides.data();
+  tensor->dl_tensor.byte_offset = 0;
+  tensor->manager_ctx = ctx;
+  tensor->deleter = deleteTensor;
+  return tensor;
+}
+
+/* cvtColor code between grey, BGR and BGRA images, or -1 */
+int conversionCode(int from, int to) {
+  if (from == 1 && to == 3) return cv::COLOR_GRAY2BGR;
+  if (from == 1 && to == 4) return cv::COLOR_GRAY2BGRA;
+  if (from == 3 && to == 1) return cv::COLOR_BGR2GRAY;
+  if (from == 3 && to == 4) return cv::COLOR_BGR2BGRA;
+  if (from == 4 && to == 1) return cv::COLOR_BGRA2GRAY;
+  if (from == 4 && to == 3) return cv::COLOR_BGRA2BGR;
+  return -1;
+}
+
+}  // namespace
+
+/** ---------------- DLPack ---------------- **/
+DLDataType dlpackType(int depth) {
+  switch (depth) {
+    case CV_8U:
+      return DLDataType{kDLUInt, 8, 1};
+    case CV_8S:
+      return DLDataType{kDLInt, 8, 1};
+    case CV_16U:
+      return DLDataType{kDLUInt, 16, 1};
+    case CV_16S:
+      return DLDataType{kDLInt, 16, 1};
+    case CV_32S:
+      return DLDataType{kDLInt, 32, 1};
+    case CV_32F:
+      return DLDataType{kDLFloat, 32, 1};
+    case CV_64F:
+      return DLDataType{kDLFloat, 64, 1};
+    default:
+      throw std::invalid_argument("dlpackType: unsupported OpenCV depth " +
+                                  std::to_string(depth) + ".");
+  }
+}
+
+DLManagedTensor* toDLPack(const cv::Mat& image) {
+  if (image.empty() || image.dims != 2)
+    throw std::invalid_argument("toDLPack: expected a non-empty 2-D image.");
+  auto* ctx = new TensorContext;
+  ctx->mat = image;  // shares the pixels, keeping them alive
+  int64_t elem = static_cast<int64_t>(image.elemSize1());
+  ctx->shape = {image.rows, image.cols, image.channels()};
+  ctx->strides = {static_cast<int64_t>(image.step[0]) / elem,
+                  image.channels(), 1};
+  return makeTensor(ctx, ctx->mat.data, image.depth());
+}
+
+/** ---------------- BatchCollator ---------------- **/
+BatchCollator::BatchCollator(size_t batch, int height, int width,
+                             int channels, int depth, TensorLayout layout)
+    : batch_(batch),
+      height_(height),
+      width_(width),
+      channels_(channels),
+      depth_(depth),
+      layout_(layout) {
+  if (batch == 0 || height <= 0 || width <= 0 || channels <= 0)
+    throw std::invalid_argument(
+        "BatchCollator: batch and image dimensions must be positive.");
+  dlpackType(depth);  // reject unsupported depths up front
+  image_bytes_ = static_cast<size_t>(height) * width * channels *
+                 CV_ELEM_SIZE1(CV_MAKETYPE(depth, 1));
+  allocate();
+}
+
+/** BatchCollator put function **/
+void BatchCollator::put(size_t index, const cv::Mat& input) {
+  // Decoded images are BGR; grey or BGRA batches convert them here
+  cv::Mat converted;
+  int code = input.empty() ? -1 : conversionCode(input.channels(), channels_);
+  if (code >= 0) cv::cvtColor(input, converted, code);
+  const cv::Mat& image = code >= 0 ? converted : input;
+  bool same_size = image.rows == height_ && image.cols == width_;
+  if ((!same_size && !resize_) || image.empty() ||
+      image.channels() != channels_ || image.depth() != depth_)
+    throw std::invalid_argument(
+        "BatchCollator: image is " + std::to_string(image.cols) + "x" +
+        std::to_string(image.rows) + "x" + std::to_string(image.channels()) +
+        ", batch expects " + std::to_string(width_) + "x" +
+        std::to_string(height_) + "x" + std::to_string(channels_) +
+        " of the same depth.");
+  uchar* dst = slotData(index);
+  cv::Size size(width_, height_);
+  if (layout_ == TensorLayout::NHWC || channels_ == 1) {
+    cv::Mat slot(height_, width_, CV_MAKETYPE(depth_, channels_), dst);
+    if (same_size)
+      image.copyTo(slot);
+    else
+      cv::resize(image, slot, size, 0, 0, cv::INTER_LINEAR);
+    return;
+  }
+  // Planes are headers over the slot, so split() writes in place
+  cv::Mat resized;
+  if (!same_size) cv::resize(image, resized, size, 0, 0, cv::INTER_LINEAR);
+  size_t plane_bytes = image_bytes_ / channels_;
+  std::vector<cv::Mat> planes;
+  for (int c = 0; c < channels_; ++c)
+    planes.emplace_back(height_, width_, CV_MAKETYPE(depth_, 1),
+                        dst + c * plane_bytes);
+  cv::split(same_size ? image : resized, planes.data());
+}
+
+/** BatchCollator clear function **/
+void BatchCollator::clear(size_t index) {
+  std::memset(slotData(index), 0, image_bytes_);
+}
+
+/** BatchCollator set resize function **/
+void BatchCollator::setResize(bool enable) { resize_ = enable; }
+
+/** BatchCollator attach function **/
+void BatchCollator::attach(uchar* data) {
+  if (!data) throw std::invalid_argument("BatchCollator: null buffer.");
+  buffer_ = std::shared_ptr<uchar>(data, [](uchar*) {});
+}
+
+/** BatchCollator slot function **/
+cv::Mat BatchCollator::slot(size_t index) {
+  if (layout_ != TensorLayout::NHWC && channels_ != 1)
+    throw std::logic_error("BatchCollator: slot() requires an NHWC batch.");
+  return cv::Mat(height_, width_, CV_MAKETYPE(depth_, channels_),
+                 slotData(index));
+}
+
+/** BatchCollator release function **/
+DLManagedTensor* BatchCollator::release() {
+  auto* ctx = new TensorContext;
+  ctx->buffer = buffer_;
+  int64_t n = static_cast<int64_t>(batch_), h = height_, w = width_,
+          c = channels_;
+  if (layout_ == TensorLayout::NHWC) {
+    ctx->shape = {n, h, w, c};
+    ctx->strides = {h * w * c, w * c, c, 1};
+  } else {
+    ctx->shape = {n, c, h, w};
+    ctx->strides = {c * h * w, h * w, w, 1};
+  }
+  DLManagedTensor* tensor = makeTensor(ctx, ctx->buffer.get(), depth_);
+  allocate();
+  return tensor;
+}
+
+/** BatchCollator accessors **/
+size_t BatchCollator::batchSize() const { return batch_; }
+
+size_t BatchCollator::bytes() const { return batch_ * image_bytes_; }
+
+TensorLayout BatchCollator::layout() const { return layout_; }
+
+/** BatchCollator allocate function **/
+void BatchCollator::allocate() {
+  size_t size = bytes();
+  auto* data = static_cast<uchar*>(
+      ::operator new(size, std::align_val_t(kAlignment)));
+  // Slots that are never filled (failed images) read as zeros
+  std::memset(data, 0, size);
+  buffer_ = std::shared_ptr<uchar>(data, [](uchar* p) {
+    ::operator delete(p, std::align_val_t(kAlignment));
+  });
+}
+
+/** BatchCollator slot address **/
+uchar* BatchCollator::slotData(size_t index) const {
+  if (index >= batch_)
+    throw std::out_of_range("BatchCollator: slot " + std::to_string(index) +
+                            " out of range.");
+  return buffer_.get() + index * image_bytes_;
+}
@@ -7,6 +7,42 @@
 
 #include "../include/thread_controller.hpp"
 
+#include <cerrno>
+#include <cstring>
+#include <random>
+#include <sstream>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/** Pin the calling thread to the index-th CPU it may run on (best effort) **/
+static void pinCurrentThread(size_t index) {
+#ifdef __linux__
+  // Choose among the CPUs of the process's cpuset, not 0..n-1
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    std::cerr << "[WARN] Could not read the CPU affinity, thread " << index
+              << " is not pinned: " << std::strerror(errno) << std::endl;
+    return;
+  }
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+  if (cpus.empty()) return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpus[index % cpus.size()], &set);
+  if (sched_setaffinity(0, sizeof(set), &set) != 0)
+    std::cerr << "[WARN] Could not pin thread " << index << " to CPU "
+              << cpus[index % cpus.size()] << ": " << std::strerror(errno)
+              << std::endl;
+#else
+  (void)index;
+#endif
+}
+
 /** ThreadController constructor **/
 ThreadController::ThreadController(size_t numThreads, size_t queueCapacity)
     : numThreads_(numThreads), imageQueue_(queueCapacity) {
@@ -29,40 +65,154 @@ void ThreadController::run(const std::vector<fs::path>& image_paths,
         "ThreadController: iterations must be at least 1.");
 
   totalTasks_ = image_paths.size() * iterations;
+  // Queues are closed at the end of every run; reopen them for this one
+  pathQueue_.reset();
+  imageQueue_.reset();
 
   if (verbose) {
-    std::cout << "[INFO] Launching " << numThreads_ << " producer threads."
-              << std::endl;
+    std::cout << "[INFO] Launching " << numThreads_ << " producer and "
+              << numWriters_ << " writer threads." << std::endl;
     std::cout << "[INFO] Total tasks to process: " << totalTasks_ << std::endl;
   }
 
+  // One profile per producer, followed by one per consumer
+  profiles_.assign(numThreads_ + numWriters_, ThreadProfile(pipeline.size()));
+  profile_ = RunProfile(pipeline.operationLabels());
+  TraceBuffer* feeder_trace = nullptr;
+  if (tracer_) {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < numThreads_; ++i)
+      names.push_back("producer " + std::to_string(i));
+    for (size_t i = 0; i < numWriters_; ++i)
+      names.push_back(numWriters_ == 1 ? std::string("consumer")
+                                       : "consumer " + std::to_string(i));
+    names.push_back("feeder");
+    tracer_->reset(std::move(names), pipeline.operationLabels());
+    for (size_t i = 0; i < profiles_.size(); ++i)
+      profiles_[i].setTrace(&tracer_->buffer(i));
+    feeder_trace = &tracer_->buffer(profiles_.size());
+  }
+  for (size_t i = 0; i < numThreads_; ++i) {
+    profiles_[i].setTaskOpTiming(slow_tasks_ != nullptr);
+    profiles_[i].setCostModel(cost_model_);
+  }
+  if (slow_tasks_) {
+    slow_tasks_->clear();
+    for (size_t i = numThreads_; i < profiles_.size(); ++i)
+      profiles_[i].setSlowTasks(slow_tasks_.get());
+  }
+  if (track_memory_) {
+    memory_report_ = MemoryReport();
+    MemTracker::instance().resetPeaks();
+  }
+  queue_reports_ = {
+      QueueReport{"paths", "feeder", "producers", 1, numThreads_,
+                  pathQueue_.capacity(), {},
+                  OccupancySeries(pathQueue_.capacity())},
+      QueueReport{"images", "producers", "consumers", numThreads_,
+                  numWriters_, imageQueue_.capacity(), {},
+                  OccupancySeries(imageQueue_.capacity())}};
+  progress_.reset();
+  if (verbose && progress_interval_.count() > 0)
+    progress_ = std::make_unique<ProgressReporter>(
+        std::cout, totalTasks_, numThreads_, numWriters_, progress_interval_,
+        ProgressReporter::isTerminal(std::cout));
+  uint64_t start = nowNs();
+  run_start_ns_ = start;
+  if (!metrics_path_.empty())
+    metrics_file_ =
+        std::make_unique<MetricsTextfile>(metrics_path_, kMetricsFilePeriod);
+  if (metrics_port_) {
+    metrics_server_ = std::make_unique<MetricsServer>(
+        metrics_port_, [this] { return renderMetrics(); });
+    if (verbose)
+      std::cout << "[INFO] Serving metrics on http://127.0.0.1:"
+                << metrics_port_ << "/metrics\n";
+  }
+
+  launchMonitor();
   launchProducers(pipeline);
   launchConsumer(output_dir, save_specs);
+  std::mt19937_64 arrivals(arrival_seed_);
+  std::exponential_distribution<double> gap(
+      arrival_rate_ > 0 ? arrival_rate_ : 1.0);
+  double next_arrival_s = 0;
   for (const auto& path : image_paths) {
     for (int i = 0; i < iterations; ++i) {
-      pathQueue_.push(path);
+      uint64_t arrival = nowNs();
+      if (arrival_rate_ > 0) {
+        // Scheduled time, even if an earlier push made the feeder late
+        arrival = start + static_cast<uint64_t>(next_arrival_s * 1e9);
+        next_arrival_s += poisson_arrivals_ ? gap(arrivals) : 1 / arrival_rate_;
+        uint64_t now = nowNs();
+        if (arrival > now)
+          std::this_thread::sleep_for(std::chrono::nanoseconds(arrival - now));
+      }
+      uint64_t t0 = feeder_trace ? nowNs() : 0;
+      // The first pass was dropped up front; later passes need their own
+      pathQueue_.push(PathTask{path, arrival, cold_cache_ && i > 0});
+      if (feeder_trace) {
+        uint64_t t1 = nowNs();
+        if (t1 - t0 >= kMinTracedWaitNs)
+          feeder_trace->record(
+              static_cast<uint32_t>(TraceSpan::WaitPushPaths), t0, t1);
+      }
     }
   }
   pathQueue_.setDone();
   waitForCompletion();
 
+  if (progress_) progress_->finish(snapshot(nowNs() - start));
+  metrics_server_.reset();
+  if (metrics_file_) metrics_file_->write(renderMetrics());
+  metrics_file_.reset();
+  profile_.setWallTime(nowNs() - start);
+  for (const auto& p : profiles_) profile_.merge(p);
+  queue_reports_[0].stats = pathQueue_.stats();
+  queue_reports_[1].stats = imageQueue_.stats();
+  if (track_memory_) {
+    memory_report_.mats = MemTracker::instance().snapshot();
+    memory_report_.peak_rss = peakResidentMemoryBytes();
+    for (const auto& p : profiles_)
+      memory_report_.images += p.live().completed.load();
+  }
+
   if (verbose) std::cout << "[INFO] Augmentation complete." << std::endl;
 }
 
 /** ThreadController launch producers function **/
 void ThreadController::launchProducers(Pipeline& pipeline) {
   for (size_t i = 0; i < numThreads_; ++i) {
-    producers_.emplace_back(
-        [&, i] { producerPool(pathQueue_, imageQueue_, pipeline); });
+    producers_.emplace_back([&, i] {
+      if (pin_cpus_) pinCurrentThread(i);
+      // Counters measure the opening thread, so open them here
+      std::unique_ptr<PerfCounterGroup> perf;
+      if (perf_counters_) {
+        perf = std::make_unique<PerfCounterGroup>();
+        if (perf->available())
+          profiles_[i].setPerf(perf.get());
+        else if (!perf_warned_.exchange(true))
+          std::cerr << "[WARN] Hardware counters unavailable, continuing "
+                       "without: "
+                    << perf->reason() << std::endl;
+      }
+      producerPool(pathQueue_, imageQueue_, pipeline, profiles_[i]);
+      profiles_[i].setPerf(nullptr);
+    });
   }
 }
 
 /** ThreadController launch consumer function **/
 void ThreadController::launchConsumer(const std::string& output_dir,
                                       bool save_specs) {
-  consumer_ = std::thread([&, output_dir, save_specs] {
-    consumerThread(imageQueue_, output_dir, save_specs);
-  });
+  for (size_t w = 0; w < numWriters_; ++w) {
+    consumers_.emplace_back([&, w, output_dir, save_specs] {
+      if (pin_cpus_) pinCurrentThread(numThreads_ + w);
+      consumerThread(imageQueue_, output_dir, save_specs,
+                     profiles_[numThreads_ + w], sink_, batch_size_,
+                     output_ext_);
+    });
+  }
 }
 
 /** ThreadController wait for completion function **/
@@ -70,8 +220,166 @@ void ThreadController::waitForCompletion() {
   for (auto& t : producers_) {
     if (t.joinable()) t.join();
   }
+  producers_.clear();
 
   imageQueue_.setDone();
 
-  if (consumer_.joinable()) consumer_.join();
+  for (auto& t : consumers_) {
+    if (t.joinable()) t.join();
+  }
+  consumers_.clear();
+
+  {
+    std::lock_guard<std::mutex> lock(monitor_mtx_);
+    monitor_stop_ = true;
+  }
+  monitor_cv_.notify_all();
+  if (monitor_.joinable()) monitor_.join();
+}
+
+/** ThreadController launch monitor function **/
+void ThreadController::launchMonitor() {
+  monitor_stop_ = false;
+  monitor_ = std::thread([this] {
+    std::unique_lock<std::mutex> lock(monitor_mtx_);
+    while (!monitor_cv_.wait_for(lock, kSamplePeriod,
+                                 [this] { return monitor_stop_; })) {
+      sample(nowNs() - run_start_ns_);
+    }
+  });
+}
+
+/** ThreadController sample function **/
+void ThreadController::sample(uint64_t t_ns) {
+  queue_reports_[0].series.add(t_ns, pathQueue_.size());
+  queue_reports_[1].series.add(t_ns, imageQueue_.size());
+  if (track_memory_ && queue_reports_[1].series.sampleCount() % kRssEvery == 1)
+    memory_report_.rss.add(t_ns, residentMemoryBytes());
+  if (progress_) progress_->update(snapshot(t_ns));
+  if (metrics_file_)
+    metrics_file_->update(t_ns, [this] { return renderMetrics(); });
+}
+
+/** ThreadController snapshot function **/
+ProgressSnapshot ThreadController::snapshot(uint64_t t_ns) const {
+  ProgressSnapshot snap;
+  snap.t_ns = t_ns;
+  for (const auto& p : profiles_) snap.add(p);
+  snap.path_depth = pathQueue_.size();
+  snap.path_capacity = pathQueue_.capacity();
+  snap.image_depth = imageQueue_.size();
+  snap.image_capacity = imageQueue_.capacity();
+  return snap;
+}
+
+/** ThreadController enable memory tracking function **/
+void ThreadController::enableMemoryTracking() {
+  MemTracker::instance().install();
+  track_memory_ = true;
+}
+
+/** ThreadController memory report function **/
+const MemoryReport& ThreadController::memoryReport() const {
+  return memory_report_;
+}
+
+/** ThreadController enable slowest tasks function **/
+void ThreadController::enableSlowTasks(size_t count) {
+  if (count == 0)
+    slow_tasks_.reset();
+  else
+    slow_tasks_ = std::make_unique<SlowTaskLog>(count);
+}
+
+/** ThreadController slowest tasks accessor **/
+const SlowTaskLog* ThreadController::slowTasks() const {
+  return slow_tasks_.get();
+}
+
+/** ThreadController enable cold cache function **/
+void ThreadController::enableColdCache(bool enable) { cold_cache_ = enable; }
+
+/** ThreadController enable cost model function **/
+void ThreadController::enableCostModel(bool enable) { cost_model_ = enable; }
+
+/** ThreadController enable hardware counters function **/
+void ThreadController::enablePerfCounters(bool enable) {
+  perf_counters_ = enable;
+}
+
+/** ThreadController render metrics function **/
+std::string ThreadController::renderMetrics() const {
+  std::ostringstream out;
+  writePrometheus(out, snapshot(nowNs() - run_start_ns_), profile_.opLabels(),
+                  totalTasks_);
+  return out.str();
+}
+
+/** ThreadController enable metrics function **/
+void ThreadController::enableMetrics(uint16_t port,
+                                     const std::string& textfile) {
+  metrics_port_ = port;
+  metrics_path_ = textfile;
+}
+
+/** ThreadController set writer count function **/
+void ThreadController::setWriterCount(size_t numWriters) {
+  if (numWriters == 0)
+    throw std::invalid_argument(
+        "ThreadController: number of writers must be at least 1.");
+  numWriters_ = numWriters;
+}
+
+/** ThreadController enable CPU pinning function **/
+void ThreadController::enableCpuPinning(bool enable) { pin_cpus_ = enable; }
+
+/** ThreadController set sink mode function **/
+void ThreadController::setSinkMode(SinkMode sink) { sink_ = sink; }
+
+/** ThreadController set output format function **/
+void ThreadController::setOutputFormat(const std::string& ext) {
+  if (ext.empty())
+    throw std::invalid_argument(
+        "ThreadController: output format must not be empty.");
+  output_ext_ = ext;
+}
+
+/** ThreadController set writer batch size function **/
+void ThreadController::setWriterBatchSize(size_t batchSize) {
+  if (batchSize == 0)
+    throw std::invalid_argument(
+        "ThreadController: writer batch size must be at least 1.");
+  batch_size_ = batchSize;
+}
+
+/** ThreadController set arrival rate function **/
+void ThreadController::setArrivalRate(double rate, bool poisson,
+                                      unsigned seed) {
+  if (rate < 0)
+    throw std::invalid_argument(
+        "ThreadController: arrival rate must not be negative.");
+  arrival_rate_ = rate;
+  poisson_arrivals_ = poisson;
+  arrival_seed_ = seed;
+}
+
+/** ThreadController set progress interval function **/
+void ThreadController::setProgressInterval(std::chrono::milliseconds interval) {
+  progress_interval_ = interval;
+}
+
+/** ThreadController profile accessor **/
+const RunProfile& ThreadController::profile() const { return profile_; }
+
+/** ThreadController enable tracing function **/
+void ThreadController::enableTracing(size_t eventsPerThread) {
+  tracer_ = std::make_unique<Tracer>(eventsPerThread);
+}
+
+/** ThreadController tracer accessor **/
+const Tracer* ThreadController::tracer() const { return tracer_.get(); }
+
+/** ThreadController queue reports accessor **/
+const std::vector<QueueReport>& ThreadController::queueReports() const {
+  return queue_reports_;
 }
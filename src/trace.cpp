@@ -0,0 +1,134 @@
+/**
+ * @file trace.cpp
+ * @brief Implementation of the trace buffers and Chrome exporter defined in
+ * trace.hpp.
+ * @author Emmanuel Butsana
+ * @date Initial release: October 17, 2026
+ */
+
+#include "../include/trace.hpp"
+
+#include <algorithm>
+
+#include "../include/json_writer.hpp"
+#include "../include/profiler.hpp"
+
+/** ---------------- TraceBuffer ---------------- **/
+TraceBuffer::TraceBuffer(size_t capacity) {
+  size_t cap = 1;
+  while (cap < capacity) cap <<= 1;
+  events_.resize(capacity ? cap : 0);
+  mask_ = capacity ? cap - 1 : 0;
+}
+
+TraceBuffer::TraceBuffer(TraceBuffer&& other) noexcept
+    : events_(std::move(other.events_)),
+      mask_(other.mask_),
+      head_(other.head_.load()) {}
+
+TraceBuffer& TraceBuffer::operator=(TraceBuffer&& other) noexcept {
+  events_ = std::move(other.events_);
+  mask_ = other.mask_;
+  head_.store(other.head_.load());
+  return *this;
+}
+
+size_t TraceBuffer::size() const {
+  uint64_t head = head_.load(std::memory_order_acquire);
+  return static_cast<size_t>(std::min<uint64_t>(head, events_.size()));
+}
+
+uint64_t TraceBuffer::dropped() const {
+  uint64_t head = head_.load(std::memory_order_acquire);
+  return head > events_.size() ? head - events_.size() : 0;
+}
+
+const TraceEvent& TraceBuffer::at(size_t i) const {
+  uint64_t head = head_.load(std::memory_order_acquire);
+  uint64_t oldest = head > events_.size() ? head - events_.size() : 0;
+  return events_[(oldest + i) & mask_];
+}
+
+/** ---------------- Tracer ---------------- **/
+Tracer::Tracer(size_t eventsPerThread) : capacity_(eventsPerThread) {}
+
+void Tracer::reset(std::vector<std::string> threadNames,
+                   std::vector<std::string> opLabels) {
+  thread_names_ = std::move(threadNames);
+  op_labels_ = std::move(opLabels);
+  buffers_.clear();
+  for (size_t i = 0; i < thread_names_.size(); ++i)
+    buffers_.emplace_back(capacity_);
+  origin_ns_ = nowNs();
+}
+
+uint64_t Tracer::dropped() const {
+  uint64_t total = 0;
+  for (const auto& b : buffers_) total += b.dropped();
+  return total;
+}
+
+std::pair<std::string, const char*> Tracer::spanName(uint32_t id) const {
+  if (id < kStageCount) {
+    Stage stage = static_cast<Stage>(id);
+    const char* cat = (stage == Stage::Read || stage == Stage::Write)
+                          ? "io"
+                          : (stage == Stage::Augment ? "pipeline" : "codec");
+    return {stageName(stage), cat};
+  }
+  switch (static_cast<TraceSpan>(id)) {
+    case TraceSpan::WaitPopPaths:
+      return {"wait pop paths", "queue"};
+    case TraceSpan::WaitPushImages:
+      return {"wait push images", "queue"};
+    case TraceSpan::WaitPopImages:
+      return {"wait pop images", "queue"};
+    case TraceSpan::WaitPushPaths:
+      return {"wait push paths", "queue"};
+    default:
+      break;
+  }
+  size_t op = id - kTraceOpBase;
+  if (op < op_labels_.size()) return {op_labels_[op], "op"};
+  return {"op " + std::to_string(op), "op"};
+}
+
+void Tracer::writeChromeJson(std::ostream& out) const {
+  JsonWriter json(out, false);
+  json.beginObject();
+  json.field("displayTimeUnit", "ms");
+  json.key("traceEvents").beginArray();
+
+  for (size_t t = 0; t < buffers_.size(); ++t) {
+    // Thread name metadata
+    json.beginObject()
+        .field("name", "thread_name")
+        .field("ph", "M")
+        .field("pid", 1)
+        .field("tid", t);
+    json.key("args").beginObject().field("name", thread_names_[t]).endObject();
+    json.endObject();
+
+    const TraceBuffer& buf = buffers_[t];
+    for (size_t i = 0; i < buf.size(); ++i) {
+      const TraceEvent& ev = buf.at(i);
+      auto [name, cat] = spanName(ev.id);
+      double ts = ev.start_ns >= origin_ns_
+                      ? static_cast<double>(ev.start_ns - origin_ns_) / 1e3
+                      : 0.0;
+      json.beginObject()
+          .field("name", name)
+          .field("cat", cat)
+          .field("ph", "X")
+          .field("ts", ts)
+          .field("dur", static_cast<double>(ev.dur_ns) / 1e3)
+          .field("pid", 1)
+          .field("tid", t)
+          .endObject();
+    }
+  }
+
+  json.endArray();
+  json.endObject();
+  out << '\n';
+}